@@ -0,0 +1,85 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_accumulator.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Every thread adds its own gradient of state.range(0) dimensions into one shared total. The
+// mutex benchmarks are the single lock around operator+= the accumulator replaces; items are adds
+// across all threads, so the rates compare directly.
+namespace {
+	struct locked_total {
+		std::mutex mutex;
+		comp6771::euclidean_vector total;
+	};
+
+	// Made by thread 0 before the threads start adding, and freed by it once they all stop.
+	auto shared_locked = std::unique_ptr<locked_total>();
+	auto shared_accumulator = std::unique_ptr<comp6771::euclidean_vector_accumulator>();
+
+	auto mutex_add(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		if (state.thread_index() == 0) {
+			shared_locked = std::make_unique<locked_total>();
+			shared_locked->total = comp6771::euclidean_vector(dim);
+		}
+		auto const gradient = comp6771::euclidean_vector(dim, 0.5);
+		for (auto _ : state) {
+			auto const lock = std::scoped_lock(shared_locked->mutex);
+			shared_locked->total += gradient;
+		}
+		state.SetItemsProcessed(state.iterations());
+		if (state.thread_index() == 0) {
+			benchmark::DoNotOptimize(shared_locked->total.data());
+			shared_locked.reset();
+		}
+	}
+
+	auto accumulator_add(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		if (state.thread_index() == 0) {
+			shared_accumulator = std::make_unique<comp6771::euclidean_vector_accumulator>(dim);
+		}
+		auto const gradient = comp6771::euclidean_vector(dim, 0.5);
+		for (auto _ : state) {
+			shared_accumulator->add(gradient);
+		}
+		state.SetItemsProcessed(state.iterations());
+		if (state.thread_index() == 0) {
+			auto const total = shared_accumulator->snapshot();
+			benchmark::DoNotOptimize(total.data());
+			shared_accumulator.reset();
+		}
+	}
+
+	// One snapshot of a total sharded one per hardware thread.
+	auto accumulator_snapshot(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const accumulator = comp6771::euclidean_vector_accumulator(dim);
+		for (auto _ : state) {
+			auto const total = accumulator.snapshot();
+			benchmark::DoNotOptimize(total.data());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	auto sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(64)->Range(16, std::int64_t{1} << 16);
+	}
+
+	auto threads(benchmark::internal::Benchmark* b) -> void {
+		sizes(b);
+		auto const hardware = static_cast<int>(std::thread::hardware_concurrency());
+		for (auto n = 1; n <= 2 * hardware; n *= 2) {
+			b->Threads(n);
+		}
+		b->UseRealTime();
+	}
+} // namespace
+
+BENCHMARK(mutex_add)->Apply(threads);
+BENCHMARK(accumulator_add)->Apply(threads);
+BENCHMARK(accumulator_snapshot)->Apply(sizes);
@@ -0,0 +1,56 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Each iteration stands in for one request handler: it builds and drops a batch of short-lived
+// vectors, all large enough to need a heap buffer.
+namespace {
+	auto constexpr vectors_per_request = 256;
+
+	auto handle_request(std::pmr::memory_resource* resource, int dim) -> double {
+		auto total = 0.0;
+		for (auto i = 0; i < vectors_per_request; ++i) {
+			auto const a = comp6771::euclidean_vector(dim, 1.0, resource);
+			auto b = comp6771::euclidean_vector(a, resource);
+			b *= 2.0;
+			total += b.at(0);
+		}
+		return total;
+	}
+
+	auto default_resource(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(handle_request(std::pmr::get_default_resource(), dim));
+		}
+		state.SetItemsProcessed(state.iterations() * vectors_per_request * 2);
+	}
+
+	auto monotonic_resource(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		// One upfront buffer big enough for a whole request, handed to a fresh arena each time.
+		auto buffer = std::vector<std::byte>(2 * vectors_per_request * sizeof(double)
+		                                     * static_cast<std::size_t>(dim));
+		for (auto _ : state) {
+			auto arena = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
+			benchmark::DoNotOptimize(handle_request(&arena, dim));
+		}
+		state.SetItemsProcessed(state.iterations() * vectors_per_request * 2);
+	}
+
+	auto pool_resource(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto pool = std::pmr::unsynchronized_pool_resource();
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(handle_request(&pool, dim));
+		}
+		state.SetItemsProcessed(state.iterations() * vectors_per_request * 2);
+	}
+} // namespace
+
+BENCHMARK(default_resource)->Arg(32)->Arg(256)->Arg(4096);
+BENCHMARK(monotonic_resource)->Arg(32)->Arg(256)->Arg(4096);
+BENCHMARK(pool_resource)->Arg(32)->Arg(256)->Arg(4096);
@@ -0,0 +1,24 @@
+#ifndef COMP6771_EV_BENCHMARK_HPP
+#define COMP6771_EV_BENCHMARK_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// Shared by the per-feature benchmarks: every one of them sweeps the dimensions from 1 to 10^7
+// and reports the magnitudes it touches, so runs can be compared across commits.
+namespace ev_benchmark {
+	// 1, 10, ..., 10^7 dimensions. The largest vectors are 80 MB, far bigger than any cache.
+	inline auto dimensions(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(10)->Range(1, 10'000'000);
+	}
+
+	// Items are dimensions; bytes are the magnitudes read plus those written, counting each of
+	// `vectors` whole vectors once.
+	inline auto report(benchmark::State& state, int vectors) -> void {
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.SetBytesProcessed(state.iterations() * state.range(0) * vectors
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+} // namespace ev_benchmark
+
+#endif // COMP6771_EV_BENCHMARK_HPP
@@ -0,0 +1,111 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "ev_benchmark.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Each constructor builds a vector of state.range(0) dimensions and drops it again, so the times
+// include the allocation and, above the inline capacity, the free.
+namespace {
+	auto default_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			auto const ev = comp6771::euclidean_vector();
+			benchmark::DoNotOptimize(ev.data());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	auto single_argument_constructor(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		for (auto _ : state) {
+			auto const ev = comp6771::euclidean_vector(dim);
+			benchmark::DoNotOptimize(ev.data());
+		}
+		ev_benchmark::report(state, 1);
+	}
+
+	auto constructor(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		for (auto _ : state) {
+			auto const ev = comp6771::euclidean_vector(dim, 1.5);
+			benchmark::DoNotOptimize(ev.data());
+		}
+		ev_benchmark::report(state, 1);
+	}
+
+	auto vector_constructor(benchmark::State& state) -> void {
+		auto const magnitudes = std::vector<double>(static_cast<std::size_t>(state.range(0)), 1.5);
+		for (auto _ : state) {
+			auto const ev = comp6771::euclidean_vector(magnitudes.begin(), magnitudes.end());
+			benchmark::DoNotOptimize(ev.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	// An initialiser list has a fixed length, so this one only runs at four dimensions.
+	auto initialiser_list_constructor(benchmark::State& state) -> void {
+		for (auto _ : state) {
+			auto const ev = comp6771::euclidean_vector{1.0, 2.0, 3.0, 4.0};
+			benchmark::DoNotOptimize(ev.data());
+		}
+		state.SetItemsProcessed(state.iterations() * 4);
+	}
+
+	// Building the std::vector to adopt is timed too; the adoption itself copies nothing.
+	auto adopting_constructor(benchmark::State& state) -> void {
+		auto const dim = static_cast<std::size_t>(state.range(0));
+		for (auto _ : state) {
+			auto const ev = comp6771::euclidean_vector(std::vector<double>(dim, 1.5));
+			benchmark::DoNotOptimize(ev.data());
+		}
+		ev_benchmark::report(state, 1);
+	}
+
+	auto conversion_constructor(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const narrow = comp6771::float_euclidean_vector(dim, 1.5F);
+		for (auto _ : state) {
+			auto const ev = comp6771::euclidean_vector(narrow);
+			benchmark::DoNotOptimize(ev.data());
+		}
+		// Reads floats, writes doubles.
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.SetBytesProcessed(state.iterations() * state.range(0)
+		                        * static_cast<std::int64_t>(sizeof(float) + sizeof(double)));
+	}
+
+	auto copy_constructor(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const original = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const ev = comp6771::euclidean_vector(original);
+			benchmark::DoNotOptimize(ev.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	// Moves the buffer back and forth, so no magnitudes are touched above the inline capacity.
+	auto move_constructor(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto ev = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto moved = comp6771::euclidean_vector(std::move(ev));
+			ev = std::move(moved);
+			benchmark::DoNotOptimize(ev.data());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+} // namespace
+
+BENCHMARK(default_constructor);
+BENCHMARK(single_argument_constructor)->Apply(ev_benchmark::dimensions);
+BENCHMARK(constructor)->Apply(ev_benchmark::dimensions);
+BENCHMARK(vector_constructor)->Apply(ev_benchmark::dimensions);
+BENCHMARK(initialiser_list_constructor);
+BENCHMARK(adopting_constructor)->Apply(ev_benchmark::dimensions);
+BENCHMARK(conversion_constructor)->Apply(ev_benchmark::dimensions);
+BENCHMARK(copy_constructor)->Apply(ev_benchmark::dimensions);
+BENCHMARK(move_constructor)->Apply(ev_benchmark::dimensions);
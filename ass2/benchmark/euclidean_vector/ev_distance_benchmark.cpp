@@ -0,0 +1,126 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_distance.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Vectors of 128 dimensions. The per_pair benchmark is the loop of euclidean_vector operators the
+// batched kernels replace; items are distances, so the rates compare directly.
+namespace {
+	constexpr auto dimensions = 128;
+
+	auto make_batch(int n, double seed) -> comp6771::euclidean_vector_batch {
+		auto batch = comp6771::euclidean_vector_batch(n, dimensions);
+		auto const data = batch.data();
+		for (auto i = std::size_t{0}; i < data.size(); ++i) {
+			data[i] = seed * static_cast<double>(i % 17) - static_cast<double>(i % 5);
+		}
+		return batch;
+	}
+
+	auto metric_of(benchmark::State const& state) -> comp6771::distance_metric {
+		return static_cast<comp6771::distance_metric>(state.range(1));
+	}
+
+	// Squared l2 distances one pair at a time, with a temporary difference per pair.
+	auto per_pair(benchmark::State& state) -> void {
+		auto const batch = make_batch(static_cast<int>(state.range(0)), 1.5);
+		auto rows = std::vector<comp6771::euclidean_vector>();
+		for (auto i = 0; i < batch.size(); ++i) {
+			rows.push_back(batch.copy_row(i));
+		}
+		auto const query = comp6771::euclidean_vector(dimensions, 0.5);
+		auto out = std::vector<double>(rows.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < rows.size(); ++i) {
+				auto const difference = comp6771::euclidean_vector(rows[i] - query);
+				out[i] = comp6771::dot(difference, difference);
+			}
+			benchmark::DoNotOptimize(out.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	auto one_to_many(benchmark::State& state) -> void {
+		auto const batch = make_batch(static_cast<int>(state.range(0)), 1.5);
+		auto const query = comp6771::euclidean_vector(dimensions, 0.5);
+		auto out = std::vector<double>(static_cast<std::size_t>(batch.size()));
+		for (auto _ : state) {
+			comp6771::distances(metric_of(state), batch, query, out);
+			benchmark::DoNotOptimize(out.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	// Every pair of two n-vector batches.
+	auto pairwise(benchmark::State& state) -> void {
+		auto const n = static_cast<int>(state.range(0));
+		auto const a = make_batch(n, 1.5);
+		auto const b = make_batch(n, -0.25);
+		auto out = std::vector<double>(static_cast<std::size_t>(n) * static_cast<std::size_t>(n));
+		for (auto _ : state) {
+			comp6771::pairwise_distances(metric_of(state), a, b, out);
+			benchmark::DoNotOptimize(out.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+	}
+
+	// 1024 by 1024 squared l2 distances on a pool of state.range(0) threads.
+	auto parallel_pairwise(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const policy = comp6771::parallel_policy{&pool};
+		constexpr auto n = 1024;
+		auto const a = make_batch(n, 1.5);
+		auto const b = make_batch(n, -0.25);
+		auto out = std::vector<double>(std::size_t{n} * n);
+		for (auto _ : state) {
+			comp6771::pairwise_distances(policy, comp6771::distance_metric::squared_l2, a, b, out);
+			benchmark::DoNotOptimize(out.data());
+		}
+		state.SetItemsProcessed(state.iterations() * std::int64_t{n} * n);
+	}
+
+	auto sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(16)->Range(16, 1 << 16);
+	}
+
+	auto metrics(benchmark::internal::Benchmark* b, std::int64_t from, std::int64_t to) -> void {
+		for (auto n = from; n <= to; n *= 16) {
+			for (auto metric : {comp6771::distance_metric::l1,
+			                    comp6771::distance_metric::squared_l2,
+			                    comp6771::distance_metric::linf,
+			                    comp6771::distance_metric::cosine}) {
+				b->Args({n, static_cast<std::int64_t>(metric)});
+			}
+		}
+	}
+
+	auto one_to_many_sizes(benchmark::internal::Benchmark* b) -> void {
+		metrics(b, 16, 1 << 16);
+	}
+
+	auto pairwise_sizes(benchmark::internal::Benchmark* b) -> void {
+		metrics(b, 16, 1 << 8);
+	}
+
+	auto threads(benchmark::internal::Benchmark* b) -> void {
+		auto const hardware = static_cast<int>(std::thread::hardware_concurrency());
+		for (auto n = 1; n <= hardware; n *= 2) {
+			b->Arg(n);
+		}
+		if (hardware > 0 and (hardware & (hardware - 1)) != 0) {
+			b->Arg(hardware);
+		}
+		b->UseRealTime();
+	}
+} // namespace
+
+BENCHMARK(per_pair)->Apply(sizes);
+BENCHMARK(one_to_many)->Apply(one_to_many_sizes);
+BENCHMARK(pairwise)->Apply(pairwise_sizes);
+BENCHMARK(parallel_pairwise)->Apply(threads);
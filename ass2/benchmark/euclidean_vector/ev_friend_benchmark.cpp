@@ -0,0 +1,101 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "ev_benchmark.hpp"
+#include <benchmark/benchmark.h>
+
+// The arithmetic friends build lazy expressions; each benchmark evaluates one into a new vector,
+// which is how callers see them.
+namespace {
+	auto equal(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		auto const y = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x == y);
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto not_equal(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		auto const y = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x != y);
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto addition(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		auto const y = comp6771::euclidean_vector(dim, 0.5);
+		for (auto _ : state) {
+			auto const sum = comp6771::euclidean_vector(x + y);
+			benchmark::DoNotOptimize(sum.data());
+		}
+		ev_benchmark::report(state, 3);
+	}
+
+	auto subtraction(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		auto const y = comp6771::euclidean_vector(dim, 0.5);
+		for (auto _ : state) {
+			auto const difference = comp6771::euclidean_vector(x - y);
+			benchmark::DoNotOptimize(difference.data());
+		}
+		ev_benchmark::report(state, 3);
+	}
+
+	auto multiplication(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const product = comp6771::euclidean_vector(x * 2.0);
+			benchmark::DoNotOptimize(product.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto reverse_multiplication(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const product = comp6771::euclidean_vector(2.0 * x);
+			benchmark::DoNotOptimize(product.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto division(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const quotient = comp6771::euclidean_vector(x / 2.0);
+			benchmark::DoNotOptimize(quotient.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	// a * x + y in one pass, without temporaries.
+	auto fused_expression(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		auto const y = comp6771::euclidean_vector(dim, 0.5);
+		for (auto _ : state) {
+			auto const result = comp6771::euclidean_vector(2.0 * x + y);
+			benchmark::DoNotOptimize(result.data());
+		}
+		ev_benchmark::report(state, 3);
+	}
+} // namespace
+
+BENCHMARK(equal)->Apply(ev_benchmark::dimensions);
+BENCHMARK(not_equal)->Apply(ev_benchmark::dimensions);
+BENCHMARK(addition)->Apply(ev_benchmark::dimensions);
+BENCHMARK(subtraction)->Apply(ev_benchmark::dimensions);
+BENCHMARK(multiplication)->Apply(ev_benchmark::dimensions);
+BENCHMARK(reverse_multiplication)->Apply(ev_benchmark::dimensions);
+BENCHMARK(division)->Apply(ev_benchmark::dimensions);
+BENCHMARK(fused_expression)->Apply(ev_benchmark::dimensions);
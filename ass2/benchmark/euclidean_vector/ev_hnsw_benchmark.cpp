@@ -0,0 +1,101 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/hnsw_index.hpp"
+#include "comp6771/knn_index.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Recall against queries per second: 10 nearest of 20'000 clustered vectors, for a range of
+// search widths. Ground truth comes from knn_index; each run reports the recall it achieved
+// alongside its throughput.
+namespace {
+	auto constexpr size = 20'000;
+	auto constexpr dimensions = 64;
+	auto constexpr query_count = 200;
+	auto constexpr k = 10;
+
+	auto clustered_batch(int n, unsigned seed) -> comp6771::euclidean_vector_batch {
+		auto engine = std::mt19937(seed);
+		auto centre = std::uniform_real_distribution<double>(-10.0, 10.0);
+		auto noise = std::normal_distribution<double>(0.0, 2.0);
+		auto centres = std::vector<double>(64 * dimensions);
+		std::generate(centres.begin(), centres.end(), [&] { return centre(engine); });
+		auto batch = comp6771::euclidean_vector_batch(n, dimensions);
+		for (auto i = 0; i < n; ++i) {
+			auto const c = std::size_t{engine() % 64} * dimensions;
+			for (auto d = 0; d < dimensions; ++d) {
+				batch.at(i, d) = centres[c + static_cast<std::size_t>(d)] + noise(engine);
+			}
+		}
+		return batch;
+	}
+
+	struct fixture {
+		comp6771::euclidean_vector_batch queries = clustered_batch(query_count, 2);
+		comp6771::hnsw_index index = comp6771::hnsw_index(dimensions);
+		std::vector<std::vector<comp6771::knn_neighbour>> truth;
+
+		fixture() {
+			auto const data = clustered_batch(size, 1);
+			index.insert(comp6771::parallel_policy{}, data);
+			truth = comp6771::knn_index(data).search(comp6771::parallel_policy{}, queries, k);
+		}
+	};
+
+	auto shared() -> fixture const& {
+		static auto const f = fixture();
+		return f;
+	}
+
+	auto hnsw_search(benchmark::State& state) -> void {
+		auto const& f = shared();
+		auto const ef = static_cast<int>(state.range(0));
+		auto found = std::size_t{0};
+		for (auto _ : state) {
+			found = 0;
+			for (auto q = 0; q < query_count; ++q) {
+				auto const result = f.index.search(f.queries.copy_row(q), k, ef);
+				for (auto const& n : f.truth[static_cast<std::size_t>(q)]) {
+					found += static_cast<std::size_t>(
+					   std::count_if(result.begin(), result.end(), [&](auto const& r) {
+						   return r.index == n.index;
+					   }));
+				}
+			}
+		}
+		state.counters["recall"] = static_cast<double>(found) / (query_count * k);
+		state.SetItemsProcessed(state.iterations() * query_count);
+	}
+
+	auto exact_search(benchmark::State& state) -> void {
+		auto const index = comp6771::knn_index(clustered_batch(size, 1));
+		auto const& f = shared();
+		for (auto _ : state) {
+			for (auto q = 0; q < query_count; ++q) {
+				benchmark::DoNotOptimize(index.search(f.queries.copy_row(q), k));
+			}
+		}
+		state.counters["recall"] = 1.0;
+		state.SetItemsProcessed(state.iterations() * query_count);
+	}
+
+	auto hnsw_build(benchmark::State& state) -> void {
+		auto const data = clustered_batch(size, 1);
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto index = comp6771::hnsw_index(dimensions);
+			index.insert(comp6771::parallel_policy{&pool}, data);
+			benchmark::DoNotOptimize(index.size());
+		}
+		state.SetItemsProcessed(state.iterations() * size);
+	}
+} // namespace
+
+BENCHMARK(exact_search)->Unit(benchmark::kMillisecond);
+BENCHMARK(hnsw_search)->RangeMultiplier(2)->Range(10, 160)->Unit(benchmark::kMillisecond);
+BENCHMARK(hnsw_build)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
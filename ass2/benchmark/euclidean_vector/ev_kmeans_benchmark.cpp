@@ -0,0 +1,151 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/kmeans.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// state.range(0) vectors of 32 dimensions in 16 clusters. Items are vector-centroid distances, so
+// the hand-rolled operator loop, the matrix scoring and whole iterations compare directly.
+namespace {
+	constexpr auto dimensions = 32;
+	constexpr auto clusters = 16;
+
+	auto make_data(int n) -> comp6771::euclidean_vector_batch {
+		auto data = comp6771::euclidean_vector_batch(n, dimensions);
+		for (auto i = 0; i < n; ++i) {
+			auto const cluster = static_cast<double>(i % clusters);
+			for (auto d = 0; d < dimensions; ++d) {
+				data.at(i, d) = cluster * static_cast<double>(d % 3) + static_cast<double>(i % 7) * 0.1;
+			}
+		}
+		return data;
+	}
+
+	auto make_centroids(comp6771::euclidean_vector_batch const& data) -> comp6771::euclidean_matrix {
+		auto centroids = comp6771::euclidean_matrix(clusters, dimensions);
+		for (auto j = 0; j < clusters; ++j) {
+			centroids.set_row(j, data.copy_row(j));
+		}
+		return centroids;
+	}
+
+	auto report(benchmark::State& state, std::int64_t distances) -> void {
+		state.SetItemsProcessed(state.iterations() * distances);
+	}
+
+	// One assignment step written with euclidean_vector operators: a temporary per distance.
+	auto operator_assign(benchmark::State& state) -> void {
+		auto const data = make_data(static_cast<int>(state.range(0)));
+		auto const centroids = make_centroids(data);
+		auto points = std::vector<comp6771::euclidean_vector>();
+		for (auto i = 0; i < data.size(); ++i) {
+			points.push_back(data.copy_row(i));
+		}
+		auto centres = std::vector<comp6771::euclidean_vector>();
+		for (auto j = 0; j < clusters; ++j) {
+			centres.push_back(centroids.copy_row(j));
+		}
+		auto labels = std::vector<int>(points.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < points.size(); ++i) {
+				auto best = 0;
+				auto best_distance = comp6771::euclidean_norm(points[i] - centres[0]);
+				for (auto j = 1; j < clusters; ++j) {
+					auto const distance =
+					   comp6771::euclidean_norm(points[i] - centres[static_cast<std::size_t>(j)]);
+					if (distance < best_distance) {
+						best = j;
+						best_distance = distance;
+					}
+				}
+				labels[i] = best;
+			}
+			benchmark::DoNotOptimize(labels.data());
+		}
+		report(state, state.range(0) * clusters);
+	}
+
+	auto matrix_assign(benchmark::State& state) -> void {
+		auto const data = make_data(static_cast<int>(state.range(0)));
+		auto const centroids = make_centroids(data);
+		for (auto _ : state) {
+			auto labels = comp6771::nearest_centroids(centroids, data);
+			benchmark::DoNotOptimize(labels.data());
+		}
+		report(state, state.range(0) * clusters);
+	}
+
+	// Ten full Lloyd iterations after k-means++ seeding.
+	auto lloyd(benchmark::State& state) -> void {
+		auto const data = make_data(static_cast<int>(state.range(0)));
+		auto options = comp6771::kmeans_options();
+		options.max_iterations = 10;
+		options.tolerance = 0.0;
+		auto iterations = std::int64_t{0};
+		for (auto _ : state) {
+			auto const result = comp6771::kmeans(data, clusters, options);
+			iterations += result.iterations;
+			benchmark::DoNotOptimize(result.inertia);
+		}
+		state.SetItemsProcessed(iterations * state.range(0) * clusters);
+	}
+
+	// Ten mini-batches of 1024, plus the seeding and final labelling every fit does.
+	auto mini_batch(benchmark::State& state) -> void {
+		auto const data = make_data(static_cast<int>(state.range(0)));
+		auto options = comp6771::kmeans_options();
+		options.max_iterations = 10;
+		options.tolerance = 0.0;
+		options.mini_batch = 1024;
+		for (auto _ : state) {
+			auto const result = comp6771::kmeans(data, clusters, options);
+			benchmark::DoNotOptimize(result.inertia);
+		}
+		report(state, state.range(0) * clusters);
+	}
+
+	// Ten Lloyd iterations over 2^18 vectors on a pool of state.range(0) threads.
+	auto parallel_lloyd(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const policy = comp6771::parallel_policy{&pool};
+		constexpr auto n = 1 << 18;
+		auto const data = make_data(n);
+		auto options = comp6771::kmeans_options();
+		options.max_iterations = 10;
+		options.tolerance = 0.0;
+		auto iterations = std::int64_t{0};
+		for (auto _ : state) {
+			auto const result = comp6771::kmeans(policy, data, clusters, options);
+			iterations += result.iterations;
+			benchmark::DoNotOptimize(result.inertia);
+		}
+		state.SetItemsProcessed(iterations * n * clusters);
+	}
+
+	auto sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+	}
+
+	auto threads(benchmark::internal::Benchmark* b) -> void {
+		auto const hardware = static_cast<int>(std::thread::hardware_concurrency());
+		for (auto n = 1; n <= hardware; n *= 2) {
+			b->Arg(n);
+		}
+		if (hardware > 0 and (hardware & (hardware - 1)) != 0) {
+			b->Arg(hardware);
+		}
+		b->UseRealTime();
+	}
+} // namespace
+
+BENCHMARK(operator_assign)->Apply(sizes);
+BENCHMARK(matrix_assign)->Apply(sizes);
+BENCHMARK(lloyd)->Apply(sizes);
+BENCHMARK(mini_batch)->Apply(sizes);
+BENCHMARK(parallel_lloyd)->Apply(threads);
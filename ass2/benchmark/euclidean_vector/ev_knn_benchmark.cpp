@@ -0,0 +1,66 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/knn_index.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+// 64 queries for the 10 nearest of 20'000 vectors. The naive loop is what callers wrote before
+// knn_index: a euclidean_vector per row and a fresh difference vector per comparison.
+namespace {
+	auto constexpr size = 20'000;
+	auto constexpr dimensions = 128;
+	auto constexpr queries = 64;
+	auto constexpr k = 10;
+
+	auto random_batch(int n, unsigned seed) -> comp6771::euclidean_vector_batch {
+		auto engine = std::mt19937(seed);
+		auto dist = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto batch = comp6771::euclidean_vector_batch(n, dimensions);
+		for (auto& d : batch.data()) {
+			d = dist(engine);
+		}
+		return batch;
+	}
+
+	auto naive_loop(benchmark::State& state) -> void {
+		auto const data = random_batch(size, 1);
+		auto rows = std::vector<comp6771::euclidean_vector>();
+		for (auto i = 0; i < size; ++i) {
+			rows.push_back(data.copy_row(i));
+		}
+		auto const query_batch = random_batch(queries, 2);
+		for (auto _ : state) {
+			for (auto q = 0; q < queries; ++q) {
+				auto const query = query_batch.copy_row(q);
+				auto all = std::vector<std::pair<double, int>>();
+				for (auto i = std::size_t{0}; i < rows.size(); ++i) {
+					auto const diff = comp6771::euclidean_vector(rows[i] - query);
+					all.emplace_back(comp6771::euclidean_norm(diff), static_cast<int>(i));
+				}
+				std::partial_sort(all.begin(), all.begin() + k, all.end());
+				benchmark::DoNotOptimize(all.data());
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * queries);
+	}
+
+	auto knn_index_search(benchmark::State& state) -> void {
+		auto const index = comp6771::knn_index(random_batch(size, 1));
+		auto const query_batch = random_batch(queries, 2);
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const policy = comp6771::parallel_policy{&pool};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(index.search(policy, query_batch, k));
+		}
+		state.SetItemsProcessed(state.iterations() * queries);
+	}
+} // namespace
+
+BENCHMARK(naive_loop)->Unit(benchmark::kMillisecond);
+BENCHMARK(knn_index_search)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
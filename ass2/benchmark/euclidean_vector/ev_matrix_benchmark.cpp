@@ -0,0 +1,142 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Square n by n products. The row_by_row benchmarks are the std::vector<euclidean_vector> and dot
+// loops euclidean_matrix replaces; items are multiply-adds, so the rates compare directly.
+namespace {
+	auto make_matrix(int n, double seed) -> comp6771::euclidean_matrix {
+		auto m = comp6771::euclidean_matrix(n, n);
+		auto const data = m.data();
+		for (auto i = std::size_t{0}; i < data.size(); ++i) {
+			data[i] = seed * static_cast<double>(i % 17) - static_cast<double>(i % 5);
+		}
+		return m;
+	}
+
+	auto make_rows(comp6771::euclidean_matrix const& m) -> std::vector<comp6771::euclidean_vector> {
+		auto rows = std::vector<comp6771::euclidean_vector>();
+		for (auto i = 0; i < m.rows(); ++i) {
+			rows.push_back(m.copy_row(i));
+		}
+		return rows;
+	}
+
+	auto report(benchmark::State& state, std::int64_t multiply_adds) -> void {
+		state.SetItemsProcessed(state.iterations() * multiply_adds);
+	}
+
+	auto row_by_row_gemv(benchmark::State& state) -> void {
+		auto const n = static_cast<int>(state.range(0));
+		auto const rows = make_rows(make_matrix(n, 1.5));
+		auto const x = comp6771::euclidean_vector(n, 0.5);
+		auto y = std::vector<double>(rows.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < rows.size(); ++i) {
+				y[i] = comp6771::dot(rows[i], x);
+			}
+			benchmark::DoNotOptimize(y.data());
+		}
+		report(state, state.range(0) * state.range(0));
+	}
+
+	auto matrix_gemv(benchmark::State& state) -> void {
+		auto const n = static_cast<int>(state.range(0));
+		auto const a = make_matrix(n, 1.5);
+		auto const x = std::vector<double>(static_cast<std::size_t>(n), 0.5);
+		auto y = std::vector<double>(static_cast<std::size_t>(n));
+		for (auto _ : state) {
+			comp6771::multiply(a, x, y);
+			benchmark::DoNotOptimize(y.data());
+		}
+		report(state, state.range(0) * state.range(0));
+	}
+
+	// Every pair of rows: the batch scoring a bᵀ product does in one call.
+	auto row_by_row_scores(benchmark::State& state) -> void {
+		auto const n = static_cast<int>(state.range(0));
+		auto const a = make_rows(make_matrix(n, 1.5));
+		auto const b = make_rows(make_matrix(n, -0.25));
+		auto c = std::vector<double>(a.size() * b.size());
+		for (auto _ : state) {
+			for (auto i = std::size_t{0}; i < a.size(); ++i) {
+				for (auto j = std::size_t{0}; j < b.size(); ++j) {
+					c[i * b.size() + j] = comp6771::dot(a[i], b[j]);
+				}
+			}
+			benchmark::DoNotOptimize(c.data());
+		}
+		report(state, state.range(0) * state.range(0) * state.range(0));
+	}
+
+	auto matrix_scores(benchmark::State& state) -> void {
+		auto const n = static_cast<int>(state.range(0));
+		auto const a = make_matrix(n, 1.5);
+		auto const b = make_matrix(n, -0.25);
+		auto c = comp6771::euclidean_matrix(n, n);
+		for (auto _ : state) {
+			comp6771::multiply_transposed(a, b, c);
+			benchmark::DoNotOptimize(c.data().data());
+		}
+		report(state, state.range(0) * state.range(0) * state.range(0));
+	}
+
+	auto matrix_gemm(benchmark::State& state) -> void {
+		auto const n = static_cast<int>(state.range(0));
+		auto const a = make_matrix(n, 1.5);
+		auto const b = make_matrix(n, -0.25);
+		auto c = comp6771::euclidean_matrix(n, n);
+		for (auto _ : state) {
+			comp6771::multiply(a, b, c);
+			benchmark::DoNotOptimize(c.data().data());
+		}
+		report(state, state.range(0) * state.range(0) * state.range(0));
+	}
+
+	// A 1024 by 1024 product on a pool of state.range(0) threads.
+	auto parallel_gemm(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const policy = comp6771::parallel_policy{&pool};
+		constexpr auto n = 1024;
+		auto const a = make_matrix(n, 1.5);
+		auto const b = make_matrix(n, -0.25);
+		auto c = comp6771::euclidean_matrix(n, n);
+		for (auto _ : state) {
+			comp6771::multiply(policy, a, b, c);
+			benchmark::DoNotOptimize(c.data().data());
+		}
+		report(state, std::int64_t{n} * n * n);
+	}
+
+	auto gemv_sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(4)->Range(16, 4096);
+	}
+
+	auto gemm_sizes(benchmark::internal::Benchmark* b) -> void {
+		b->RangeMultiplier(4)->Range(16, 1024);
+	}
+
+	auto threads(benchmark::internal::Benchmark* b) -> void {
+		auto const hardware = static_cast<int>(std::thread::hardware_concurrency());
+		for (auto n = 1; n <= hardware; n *= 2) {
+			b->Arg(n);
+		}
+		if (hardware > 0 and (hardware & (hardware - 1)) != 0) {
+			b->Arg(hardware);
+		}
+		b->UseRealTime();
+	}
+} // namespace
+
+BENCHMARK(row_by_row_gemv)->Apply(gemv_sizes);
+BENCHMARK(matrix_gemv)->Apply(gemv_sizes);
+BENCHMARK(row_by_row_scores)->Apply(gemm_sizes);
+BENCHMARK(matrix_scores)->Apply(gemm_sizes);
+BENCHMARK(matrix_gemm)->Apply(gemm_sizes);
+BENCHMARK(parallel_gemm)->Apply(threads);
@@ -0,0 +1,120 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "ev_benchmark.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <list>
+#include <utility>
+#include <vector>
+
+// Compound operators update a vector in place, so each run keeps the magnitudes finite by
+// undoing what it did; conversions build the container from scratch every time.
+namespace {
+	auto compound_addition(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto y = comp6771::euclidean_vector(dim, 1.5);
+		auto const x = comp6771::euclidean_vector(dim, 0.5);
+		for (auto _ : state) {
+			y += x;
+			benchmark::DoNotOptimize(y.data());
+		}
+		ev_benchmark::report(state, 3);
+	}
+
+	auto compound_subtraction(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto y = comp6771::euclidean_vector(dim, 1.5);
+		auto const x = comp6771::euclidean_vector(dim, 0.5);
+		for (auto _ : state) {
+			y -= x;
+			benchmark::DoNotOptimize(y.data());
+		}
+		ev_benchmark::report(state, 3);
+	}
+
+	// Alternates between doubling and halving so the magnitudes never overflow.
+	auto compound_multiplication(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto y = comp6771::euclidean_vector(dim, 1.5);
+		auto factor = 2.0;
+		for (auto _ : state) {
+			y *= factor;
+			factor = 1.0 / factor;
+			benchmark::DoNotOptimize(y.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto compound_division(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto y = comp6771::euclidean_vector(dim, 1.5);
+		auto divisor = 2.0;
+		for (auto _ : state) {
+			y /= divisor;
+			divisor = 1.0 / divisor;
+			benchmark::DoNotOptimize(y.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto unary_plus(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const copy = +x;
+			benchmark::DoNotOptimize(copy.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto negation(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const negated = -x;
+			benchmark::DoNotOptimize(negated.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto vector_conversion(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const v = static_cast<std::vector<double>>(x);
+			benchmark::DoNotOptimize(v.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	auto list_conversion(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const l = static_cast<std::list<double>>(x);
+			benchmark::DoNotOptimize(&l.back());
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	// Adopting a std::vector and releasing it again hands the same buffer back and forth.
+	auto release_to_vector(benchmark::State& state) -> void {
+		auto v = std::vector<double>(static_cast<std::size_t>(state.range(0)), 1.5);
+		for (auto _ : state) {
+			v = comp6771::euclidean_vector(std::move(v)).release_to_vector();
+			benchmark::DoNotOptimize(v.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+} // namespace
+
+BENCHMARK(compound_addition)->Apply(ev_benchmark::dimensions);
+BENCHMARK(compound_subtraction)->Apply(ev_benchmark::dimensions);
+BENCHMARK(compound_multiplication)->Apply(ev_benchmark::dimensions);
+BENCHMARK(compound_division)->Apply(ev_benchmark::dimensions);
+BENCHMARK(unary_plus)->Apply(ev_benchmark::dimensions);
+BENCHMARK(negation)->Apply(ev_benchmark::dimensions);
+BENCHMARK(vector_conversion)->Apply(ev_benchmark::dimensions);
+// A node per magnitude: ten million of them would only measure the allocator.
+BENCHMARK(list_conversion)->RangeMultiplier(10)->Range(1, 1'000'000);
+BENCHMARK(release_to_vector)->Apply(ev_benchmark::dimensions);
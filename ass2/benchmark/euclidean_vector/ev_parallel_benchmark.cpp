@@ -0,0 +1,66 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+
+// Each benchmark runs on a pool of state.range(0) threads over vectors far bigger than the last
+// level cache, so the curve shows how far the reductions scale before memory bandwidth saturates.
+namespace {
+	auto constexpr dimensions = 1 << 23;
+
+	auto parallel_dot(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const policy = comp6771::parallel_policy{&pool};
+		auto const x = comp6771::euclidean_vector(dimensions, 1.5);
+		auto const y = comp6771::euclidean_vector(dimensions, 0.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(policy, x, y));
+		}
+		state.SetBytesProcessed(state.iterations() * 2 * dimensions
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto parallel_norm(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const policy = comp6771::parallel_policy{&pool};
+		auto const x = comp6771::euclidean_vector(dimensions, 1.5);
+		auto const magnitudes = std::span(x.data(), static_cast<std::size_t>(x.dimensions()));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(policy, magnitudes));
+		}
+		state.SetBytesProcessed(state.iterations() * dimensions
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto parallel_add(benchmark::State& state) -> void {
+		auto pool = comp6771::thread_pool(static_cast<int>(state.range(0)));
+		auto const policy = comp6771::parallel_policy{&pool};
+		auto y = comp6771::euclidean_vector(dimensions, 1.5);
+		auto const x = comp6771::euclidean_vector(dimensions, 0.5);
+		for (auto _ : state) {
+			comp6771::add_assign(policy, y, x);
+			benchmark::ClobberMemory();
+		}
+		state.SetBytesProcessed(state.iterations() * 3 * dimensions
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	auto threads(benchmark::internal::Benchmark* b) -> void {
+		auto const hardware = static_cast<int>(std::thread::hardware_concurrency());
+		for (auto n = 1; n <= hardware; n *= 2) {
+			b->Arg(n);
+		}
+		if (hardware > 0 and (hardware & (hardware - 1)) != 0) {
+			b->Arg(hardware);
+		}
+		b->UseRealTime();
+	}
+} // namespace
+
+BENCHMARK(parallel_dot)->Apply(threads);
+BENCHMARK(parallel_norm)->Apply(threads);
+BENCHMARK(parallel_add)->Apply(threads);
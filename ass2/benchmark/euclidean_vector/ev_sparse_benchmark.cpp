@@ -0,0 +1,72 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/sparse_euclidean_vector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Million-dimension vectors with one magnitude in a thousand set, like bag-of-words features.
+// The dense dot product reads every dimension; the sparse ones only the nonzeros.
+namespace {
+	auto constexpr dimensions = 1'000'000;
+
+	auto random_sparse(int nonzeros, unsigned seed) -> comp6771::sparse_euclidean_vector {
+		auto engine = std::mt19937(seed);
+		auto index = std::uniform_int_distribution<int>(0, dimensions - 1);
+		auto value = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto indices = std::vector<int>();
+		auto values = std::vector<double>();
+		for (auto i = 0; i < nonzeros; ++i) {
+			indices.push_back(index(engine));
+			values.push_back(value(engine));
+		}
+		return comp6771::sparse_euclidean_vector(dimensions, indices, values);
+	}
+
+	auto dense_dot(benchmark::State& state) -> void {
+		auto const x = static_cast<comp6771::euclidean_vector>(random_sparse(1000, 1));
+		auto const y = static_cast<comp6771::euclidean_vector>(random_sparse(1000, 2));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		state.SetBytesProcessed(state.iterations() * 2 * dimensions
+		                        * static_cast<std::int64_t>(sizeof(double)));
+	}
+
+	// range(0) and range(1) are the nonzeros of each operand; unequal counts gallop.
+	auto sparse_dot(benchmark::State& state) -> void {
+		auto const x = random_sparse(static_cast<int>(state.range(0)), 1);
+		auto const y = random_sparse(static_cast<int>(state.range(1)), 2);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		state.SetItemsProcessed(state.iterations() * (x.nonzeros() + y.nonzeros()));
+	}
+
+	auto sparse_dense_dot(benchmark::State& state) -> void {
+		auto const x = random_sparse(1000, 1);
+		auto const y = static_cast<comp6771::euclidean_vector>(random_sparse(1000, 2));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		state.SetItemsProcessed(state.iterations() * x.nonzeros());
+	}
+
+	// Adds and takes away y each iteration, so x keeps its size without being copied here.
+	auto sparse_add(benchmark::State& state) -> void {
+		auto x = random_sparse(1000, 1);
+		auto const y = random_sparse(1000, 2);
+		for (auto _ : state) {
+			x += y;
+			x -= y;
+			benchmark::DoNotOptimize(x.values().data());
+		}
+		state.SetItemsProcessed(state.iterations() * 2 * (x.nonzeros() + y.nonzeros()));
+	}
+} // namespace
+
+BENCHMARK(dense_dot);
+BENCHMARK(sparse_dot)->Args({1000, 1000})->Args({50, 10'000})->Args({10, 100'000});
+BENCHMARK(sparse_dense_dot);
+BENCHMARK(sparse_add);
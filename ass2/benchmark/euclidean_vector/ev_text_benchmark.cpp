@@ -0,0 +1,109 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_text.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 10'000 vectors of 100 random magnitudes, written out and read back. The iostream versions are
+// what callers wrote before euclidean_vector_text.hpp: operator<< with full precision, and
+// operator>> one double at a time.
+namespace {
+	auto constexpr rows = 10'000;
+	auto constexpr dimensions = 100;
+
+	auto random_batch() -> comp6771::euclidean_vector_batch {
+		auto engine = std::mt19937(1);
+		auto dist = std::uniform_real_distribution<double>(-1000.0, 1000.0);
+		auto batch = comp6771::euclidean_vector_batch(rows, dimensions);
+		for (auto& d : batch.data()) {
+			d = dist(engine);
+		}
+		return batch;
+	}
+
+	auto csv(comp6771::euclidean_vector_batch const& batch) -> std::string {
+		auto text = std::string();
+		auto formatter = comp6771::euclidean_vector_formatter();
+		for (auto i = 0; i < batch.size(); ++i) {
+			text += formatter.format(comp6771::const_euclidean_vector_view(batch.row(i)));
+			text += '\n';
+		}
+		return text;
+	}
+
+	auto report(benchmark::State& state, std::size_t bytes) -> void {
+		state.SetItemsProcessed(state.iterations() * rows * dimensions);
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes));
+	}
+
+	auto iostream_format(benchmark::State& state) -> void {
+		auto const batch = random_batch();
+		auto bytes = std::size_t{0};
+		for (auto _ : state) {
+			auto os = std::ostringstream();
+			os.precision(17);
+			for (auto i = 0; i < batch.size(); ++i) {
+				auto const row = batch.row(i);
+				for (auto d = std::size_t{0}; d < row.size(); ++d) {
+					os << (d == 0 ? "" : ",") << row[d];
+				}
+				os << '\n';
+			}
+			bytes = os.view().size();
+			benchmark::DoNotOptimize(os.view().data());
+		}
+		report(state, bytes);
+	}
+
+	auto to_chars_format(benchmark::State& state) -> void {
+		auto const batch = random_batch();
+		auto formatter = comp6771::euclidean_vector_formatter();
+		auto text = std::string();
+		for (auto _ : state) {
+			text.clear();
+			for (auto i = 0; i < batch.size(); ++i) {
+				text += formatter.format(comp6771::const_euclidean_vector_view(batch.row(i)));
+				text += '\n';
+			}
+			benchmark::DoNotOptimize(text.data());
+		}
+		report(state, text.size());
+	}
+
+	auto iostream_parse(benchmark::State& state) -> void {
+		auto const text = csv(random_batch());
+		for (auto _ : state) {
+			auto is = std::istringstream(text);
+			auto magnitudes = std::vector<double>();
+			auto d = 0.0;
+			auto comma = char{};
+			while (is >> d) {
+				magnitudes.push_back(d);
+				// Skips the comma; the newline is skipped as whitespace.
+				if (is.peek() == ',') {
+					is >> comma;
+				}
+			}
+			benchmark::DoNotOptimize(magnitudes.data());
+		}
+		report(state, text.size());
+	}
+
+	auto from_chars_parse(benchmark::State& state) -> void {
+		auto const text = csv(random_batch());
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::parse_euclidean_vector_batch(text));
+		}
+		report(state, text.size());
+	}
+} // namespace
+
+BENCHMARK(iostream_format)->Unit(benchmark::kMillisecond);
+BENCHMARK(to_chars_format)->Unit(benchmark::kMillisecond);
+BENCHMARK(iostream_parse)->Unit(benchmark::kMillisecond);
+BENCHMARK(from_chars_parse)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,53 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include "ev_benchmark.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+	auto dot(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		auto const y = comp6771::euclidean_vector(dim, 0.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::dot(x, y));
+		}
+		ev_benchmark::report(state, 2);
+	}
+
+	// Taking a mutable iterator drops the cached norm, so every call recomputes it.
+	auto euclidean_norm(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(x.begin());
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(x));
+		}
+		ev_benchmark::report(state, 1);
+	}
+
+	// Every call after the first is answered from the cache.
+	auto cached_euclidean_norm(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(comp6771::euclidean_norm(x));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// The norm is cached after the first iteration, so this measures the division and the copy.
+	auto unit(benchmark::State& state) -> void {
+		auto const dim = static_cast<int>(state.range(0));
+		auto const x = comp6771::euclidean_vector(dim, 1.5);
+		for (auto _ : state) {
+			auto const u = comp6771::unit(x);
+			benchmark::DoNotOptimize(u.data());
+		}
+		ev_benchmark::report(state, 2);
+	}
+} // namespace
+
+BENCHMARK(dot)->Apply(ev_benchmark::dimensions);
+BENCHMARK(euclidean_norm)->Apply(ev_benchmark::dimensions);
+BENCHMARK(cached_euclidean_norm)->Apply(ev_benchmark::dimensions);
+BENCHMARK(unit)->Apply(ev_benchmark::dimensions);
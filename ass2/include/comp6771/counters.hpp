@@ -0,0 +1,121 @@
+#ifndef COMP6771_COUNTERS_HPP
+#define COMP6771_COUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Set to 1 to count the allocations, copies, moves and norm cache lookups every euclidean_vector
+// makes. Off by default, in which case the counting hooks compile to nothing and every count
+// stays zero. Must be defined identically in every translation unit; see LINK GUARD below.
+#ifndef COMP6771_EV_COUNTERS
+#	define COMP6771_EV_COUNTERS 0
+#endif
+
+namespace comp6771 {
+	inline constexpr auto ev_counters_enabled = COMP6771_EV_COUNTERS != 0;
+
+	struct ev_counters {
+		// Buffers taken from a memory resource, and their total size. Inline and adopted buffers
+		// aren't allocations.
+		std::uint64_t allocations = 0;
+		std::uint64_t allocated_bytes = 0;
+		// Copy constructions, copy assignments and precision conversions: each copies every
+		// magnitude.
+		std::uint64_t copies = 0;
+		// Move constructions and move assignments.
+		std::uint64_t moves = 0;
+		// Norms answered from the cache, and those that had to be computed.
+		std::uint64_t norm_cache_hits = 0;
+		std::uint64_t norm_cache_misses = 0;
+
+		friend auto operator==(ev_counters const&, ev_counters const&) -> bool = default;
+
+		friend auto operator-(ev_counters const& lhs, ev_counters const& rhs) -> ev_counters {
+			return {lhs.allocations - rhs.allocations,
+			        lhs.allocated_bytes - rhs.allocated_bytes,
+			        lhs.copies - rhs.copies,
+			        lhs.moves - rhs.moves,
+			        lhs.norm_cache_hits - rhs.norm_cache_hits,
+			        lhs.norm_cache_misses - rhs.norm_cache_misses};
+		}
+	};
+
+	// Each thread counts only what it does itself, so counting never contends.
+	inline auto this_thread_ev_counters() noexcept -> ev_counters& {
+		thread_local auto counters = ev_counters{};
+		return counters;
+	}
+
+	// SNAPSHOT
+	// Everything the calling thread has counted since it started.
+	inline auto ev_counters_snapshot() noexcept -> ev_counters {
+		return this_thread_ev_counters();
+	}
+
+	// Counts what the calling thread does between its construction and each call to counted(),
+	// so a test can hold a hot path to an allocation budget:
+	//
+	//    auto const scope = ev_counter_scope();
+	//    auto const sum = euclidean_vector(a + b);
+	//    CHECK(scope.counted().allocations == 1);
+	class ev_counter_scope {
+	public:
+		ev_counter_scope() noexcept
+		: start_{ev_counters_snapshot()} {}
+
+		[[nodiscard]] auto counted() const noexcept -> ev_counters {
+			return ev_counters_snapshot() - start_;
+		}
+
+	private:
+		ev_counters start_;
+	};
+
+	// ========================== LINK GUARD ==========================
+	// euclidean_vector.cpp is built twice: as euclidean_vector, and as euclidean_vector_counted
+	// with COMP6771_EV_COUNTERS=1. The inline hooks below differ between the two, so code must be
+	// compiled with the setting of the library it links, and the two libraries must never meet in
+	// one binary. Every translation unit that includes this header refers to a symbol that only a
+	// library built with the same setting defines, so a mismatch is an undefined reference. Both
+	// libraries define ev_counters_library, so a binary pulling in both has a duplicate definition.
+	namespace detail {
+#if COMP6771_EV_COUNTERS
+		extern int const ev_counters_on;
+		[[gnu::used]] static auto const* const ev_counters_guard = &ev_counters_on;
+#else
+		extern int const ev_counters_off;
+		[[gnu::used]] static auto const* const ev_counters_guard = &ev_counters_off;
+#endif
+		extern int const ev_counters_library;
+	} // namespace detail
+
+	// ========================== COUNTING HOOKS ==========================
+	inline auto ev_count_allocation(std::size_t bytes) noexcept -> void {
+		if constexpr (ev_counters_enabled) {
+			auto& counters = this_thread_ev_counters();
+			++counters.allocations;
+			counters.allocated_bytes += bytes;
+		}
+	}
+
+	inline auto ev_count_copy() noexcept -> void {
+		if constexpr (ev_counters_enabled) {
+			++this_thread_ev_counters().copies;
+		}
+	}
+
+	inline auto ev_count_move() noexcept -> void {
+		if constexpr (ev_counters_enabled) {
+			++this_thread_ev_counters().moves;
+		}
+	}
+
+	inline auto ev_count_norm_lookup(bool hit) noexcept -> void {
+		if constexpr (ev_counters_enabled) {
+			auto& counters = this_thread_ev_counters();
+			++(hit ? counters.norm_cache_hits : counters.norm_cache_misses);
+		}
+	}
+} // namespace comp6771
+
+#endif // COMP6771_COUNTERS_HPP
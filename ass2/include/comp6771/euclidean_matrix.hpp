@@ -0,0 +1,158 @@
+#ifndef COMP6771_EUCLIDEAN_MATRIX_HPP
+#define COMP6771_EUCLIDEAN_MATRIX_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/parallel.hpp"
+#include <initializer_list>
+#include <span>
+#include <utility>
+
+namespace comp6771 {
+	// A dense `rows` by `cols` matrix of doubles. Rows are contiguous (row-major) in one 64-byte
+	// aligned buffer, shared with euclidean_vector_batch, so a batch of vectors is also the
+	// matrix holding them as rows.
+	class euclidean_matrix {
+	public:
+		using allocator_type = euclidean_vector_batch::allocator_type;
+
+		// ========================== CONSTRUCTORS =========================
+		// Zero-initialises a `rows` by `cols` matrix.
+		euclidean_matrix(int rows, int cols, allocator_type const& alloc = {});
+		// BATCH CONSTRUCTOR
+		// Row i is vector i of the batch. Column-major batches are rearranged row-major.
+		explicit euclidean_matrix(euclidean_vector_batch rows);
+		// INITIALIZER LIST CONSTRUCTOR
+		// One list per row. Every row must have the same number of columns.
+		euclidean_matrix(std::initializer_list<std::initializer_list<double>> rows);
+
+		// =========================== OPERATORS ===========================
+		// EQUALITY OPERATOR
+		friend auto operator==(euclidean_matrix const& a, euclidean_matrix const& b) -> bool;
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		[[nodiscard]] auto rows() const -> int {
+			return rows_.size();
+		}
+
+		[[nodiscard]] auto cols() const -> int {
+			return rows_.dimensions();
+		}
+
+		[[nodiscard]] auto get_allocator() const -> allocator_type {
+			return rows_.get_allocator();
+		}
+
+		// AT METHOD
+		[[nodiscard]] auto at(int row, int col) -> double& {
+			return rows_.at(row, col);
+		}
+
+		[[nodiscard]] auto at(int row, int col) const -> double {
+			return rows_.at(row, col);
+		}
+
+		// ROW METHOD
+		// A view of one row that works with dot, euclidean_norm and unit.
+		[[nodiscard]] auto row(int i) -> std::span<double> {
+			return rows_.row(i);
+		}
+
+		[[nodiscard]] auto row(int i) const -> std::span<double const> {
+			return rows_.row(i);
+		}
+
+		// COPY ROW METHOD
+		[[nodiscard]] auto copy_row(int i) const -> euclidean_vector {
+			return rows_.copy_row(i);
+		}
+
+		// SET ROW METHOD
+		auto set_row(int i, euclidean_vector const& ev) -> void {
+			rows_.set_row(i, ev);
+		}
+
+		// DATA METHOD
+		// The whole buffer, one row after another.
+		[[nodiscard]] auto data() -> std::span<double> {
+			return rows_.data();
+		}
+
+		[[nodiscard]] auto data() const -> std::span<double const> {
+			return rows_.data();
+		}
+
+		// BATCH METHOD
+		// The rows as a row-major batch, for the bulk dot, norm and search functions.
+		[[nodiscard]] auto batch() const& -> euclidean_vector_batch const& {
+			return rows_;
+		}
+
+		[[nodiscard]] auto batch() && -> euclidean_vector_batch {
+			return std::move(rows_);
+		}
+
+	private:
+		euclidean_vector_batch rows_;
+	};
+
+	// =========================== UTILITY ===========================
+	// TRANSPOSE
+	auto transpose(euclidean_matrix const& a) -> euclidean_matrix;
+
+	// MATRIX-VECTOR PRODUCT
+	// y = a x. Rows are taken four at a time so each load of x serves all four, and long rows in
+	// cache-sized column blocks so that block of x stays cached across every row. `y` must hold
+	// a.rows() results.
+	auto multiply(euclidean_matrix const& a, std::span<double const> x, std::span<double> y)
+	   -> void;
+	auto multiply(euclidean_matrix const& a, euclidean_vector const& x) -> euclidean_vector;
+
+	// MATRIX PRODUCT
+	// c = a b. Blocks of b are packed to stay in cache while every row of a passes over them, and
+	// a register tile of c accumulates at a time. `c` must already be a.rows() by b.cols(); its
+	// buffer is reused.
+	auto multiply(euclidean_matrix const& a, euclidean_matrix const& b, euclidean_matrix& c)
+	   -> void;
+	auto multiply(euclidean_matrix const& a, euclidean_matrix const& b) -> euclidean_matrix;
+
+	// TRANSPOSED MATRIX PRODUCT
+	// c = a bᵀ, so c(i, j) = dot(a.row(i), b.row(j)): scores every row of `a` against every row of
+	// `b` without forming the transpose.
+	auto multiply_transposed(euclidean_matrix const& a,
+	                         euclidean_matrix const& b,
+	                         euclidean_matrix& c) -> void;
+	auto multiply_transposed(euclidean_matrix const& a, euclidean_matrix const& b)
+	   -> euclidean_matrix;
+
+	// Parallel overloads of the products. Blocks of rows of the result are spread over the
+	// policy's thread pool; each element is summed in the same order as the serial overloads, so
+	// results are identical however many threads run. Shapes of a single block run inline.
+	auto multiply(parallel_policy const& policy,
+	              euclidean_matrix const& a,
+	              std::span<double const> x,
+	              std::span<double> y) -> void;
+	auto multiply(parallel_policy const& policy,
+	              euclidean_matrix const& a,
+	              euclidean_vector const& x) -> euclidean_vector;
+	auto multiply(parallel_policy const& policy,
+	              euclidean_matrix const& a,
+	              euclidean_matrix const& b,
+	              euclidean_matrix& c) -> void;
+	auto multiply(parallel_policy const& policy,
+	              euclidean_matrix const& a,
+	              euclidean_matrix const& b) -> euclidean_matrix;
+	auto multiply_transposed(parallel_policy const& policy,
+	                         euclidean_matrix const& a,
+	                         euclidean_matrix const& b,
+	                         euclidean_matrix& c) -> void;
+	auto multiply_transposed(parallel_policy const& policy,
+	                         euclidean_matrix const& a,
+	                         euclidean_matrix const& b) -> euclidean_matrix;
+
+	// MULTIPLICATION OPERATOR
+	auto operator*(euclidean_matrix const& a, euclidean_vector const& x) -> euclidean_vector;
+	auto operator*(euclidean_matrix const& a, euclidean_matrix const& b) -> euclidean_matrix;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_MATRIX_HPP
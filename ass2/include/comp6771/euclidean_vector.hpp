@@ -1,20 +1,28 @@
 #ifndef COMP6771_EUCLIDEAN_VECTOR_HPP
 #define COMP6771_EUCLIDEAN_VECTOR_HPP
 
+#include "comp6771/counters.hpp"
 #include "helper.hpp"
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <concepts>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <numeric>
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace comp6771 {
@@ -24,63 +32,231 @@ namespace comp6771 {
 		: std::runtime_error(what) {}
 	};
 
-	class euclidean_vector {
+	// MAGNITUDE TYPE
+	// The element types a basic_euclidean_vector can store. float halves the memory footprint and
+	// doubles the number of magnitudes each SIMD register holds.
+	template<typename T>
+	concept ev_magnitude = std::same_as<T, float> or std::same_as<T, double>;
+
+	template<ev_magnitude T>
+	class basic_euclidean_vector;
+
+	using euclidean_vector = basic_euclidean_vector<double>;
+	using float_euclidean_vector = basic_euclidean_vector<float>;
+
+	struct parallel_policy;
+
+	template<typename T>
+	inline constexpr bool is_basic_euclidean_vector = false;
+
+	template<typename T>
+	inline constexpr bool is_basic_euclidean_vector<basic_euclidean_vector<T>> = true;
+
+	// ACCUMULATOR
+	// Reductions (dot products and norms) over T are summed in ev_accumulator_t<T>: double for
+	// both float and double, so float storage costs no precision in the result. Pass
+	// accumulate_in<A> to the reductions to sum in A instead.
+	template<ev_magnitude T>
+	using ev_accumulator_t = double;
+
+	template<std::floating_point A>
+	struct accumulate_in_t {
+		explicit accumulate_in_t() = default;
+	};
+
+	template<std::floating_point A>
+	inline constexpr auto accumulate_in = accumulate_in_t<A>{};
+
+	// DOT AND NORMS RESULT
+	// What dot_and_norms gathers in its single pass.
+	struct dot_and_norms_result {
+		double dot;
+		double x_norm;
+		double y_norm;
+	};
+
+	// ========================== EXPRESSIONS ==========================
+	// The arithmetic friends build lazy expression nodes instead of temporaries. A node is only
+	// evaluated, in a single fused loop, when it is assigned into a euclidean_vector.
+	template<typename L, typename R, typename Op>
+	class ev_binary_expression;
+
+	template<typename E, typename Op>
+	class ev_scalar_expression;
+
+	template<typename T>
+	inline constexpr bool is_ev_expression_node = false;
+
+	template<typename L, typename R, typename Op>
+	inline constexpr bool is_ev_expression_node<ev_binary_expression<L, R, Op>> = true;
+
+	template<typename E, typename Op>
+	inline constexpr bool is_ev_expression_node<ev_scalar_expression<E, Op>> = true;
+
+	// A lazy node (never a euclidean_vector itself).
+	template<typename T>
+	concept ev_expression_node = is_ev_expression_node<std::remove_cvref_t<T>>;
+
+	// Anything that may appear as an operand of the arithmetic friends.
+	template<typename T>
+	concept ev_expression =
+	   is_basic_euclidean_vector<std::remove_cvref_t<T>> or ev_expression_node<T>;
+
+	// The magnitude type an expression evaluates to. Operands of one expression must agree on it;
+	// changing precision takes an explicit conversion.
+	template<ev_expression E>
+	using ev_value_t = typename std::remove_cvref_t<E>::value_type;
+
+	// =========================== UTILITY DECLARATIONS ===========================
+	// Declared ahead of the class so it can befriend them; documented with the other utilities
+	// below.
+	template<ev_magnitude T>
+	auto euclidean_norm(basic_euclidean_vector<T> const& v) -> double;
+	template<ev_magnitude T>
+	auto axpy(double a, basic_euclidean_vector<T> const& x, basic_euclidean_vector<T>& y) -> void;
+	template<ev_magnitude T>
+	auto axpby(double a, basic_euclidean_vector<T> const& x, double b, basic_euclidean_vector<T>& y)
+	   -> void;
+	template<ev_magnitude T>
+	auto dot_and_norms(basic_euclidean_vector<T> const& x, basic_euclidean_vector<T> const& y)
+	   -> dot_and_norms_result;
+
+	// A euclidean vector whose magnitudes are stored as T. Arithmetic happens in T; reductions
+	// accumulate in ev_accumulator_t<T>. Vectors of different magnitude types never mix
+	// implicitly.
+	template<ev_magnitude T>
+	class basic_euclidean_vector {
 	public:
-		// ========================== PUBLIC MEMBERS =========================
-		mutable double norm = -1;
+		// ========================== TYPES =========================
+		using value_type = T;
+		// Buffers above the inline capacity come from this allocator's memory resource. Copies and
+		// moves propagate it the way std::pmr containers do.
+		using allocator_type = std::pmr::polymorphic_allocator<T>;
 
 		// ========================== CONSTRUCTORS =========================
 		// DEFAULT CONSTRUCTOR
-		euclidean_vector();
+		basic_euclidean_vector();
+		explicit basic_euclidean_vector(allocator_type const& alloc);
 		// SINGLE-ARGUMENT CONSTRUCTOR
-		explicit euclidean_vector(int dim);
+		explicit basic_euclidean_vector(int dim, allocator_type const& alloc = {});
 		// CONSTRUCTOR
-		explicit euclidean_vector(int dim, double mag);
+		explicit basic_euclidean_vector(int dim, T mag, allocator_type const& alloc = {});
 		// VECTOR CONSTRUCTOR
-		explicit euclidean_vector(std::vector<double>::const_iterator b,
-		                          std::vector<double>::const_iterator e);
+		explicit basic_euclidean_vector(typename std::vector<T>::const_iterator b,
+		                                typename std::vector<T>::const_iterator e,
+		                                allocator_type const& alloc = {});
 		// INITIALISER LIST CONSTRUCTOR
-		euclidean_vector(std::initializer_list<double> list);
+		basic_euclidean_vector(std::initializer_list<T> list, allocator_type const& alloc = {});
+		// ADOPTING CONSTRUCTOR
+		// Takes over the vector's buffer without copying; release_to_vector() hands it back.
+		explicit basic_euclidean_vector(std::vector<T>&& magnitudes);
+		// EXPRESSION CONSTRUCTOR
+		template<ev_expression_node E>
+		requires std::same_as<ev_value_t<E>, T>
+		basic_euclidean_vector(E const& expr, // NOLINT(google-explicit-constructor)
+		                       allocator_type const& alloc = {})
+		: magnitudes_{prep_mag<T>(expr.dimensions(), alloc.resource())}
+		, dimensions_{itos(expr.dimensions())} {
+			this->evaluate(expr);
+		}
+		// An rvalue expression that owns one of its operands (a vector that was moved into it) is
+		// evaluated into that operand's buffer, which the new vector then takes over: no allocation.
+		// Every element depends only on the same element of each operand, so overwriting in place
+		// is safe. Like a move, the result keeps the operand's allocator.
+		template<ev_expression_node E>
+		requires std::same_as<ev_value_t<E>, T> and (not std::is_lvalue_reference_v<E>)
+		basic_euclidean_vector(E&& expr) // NOLINT(google-explicit-constructor)
+		: basic_euclidean_vector(adopt(expr)) {}
+		// CONVERSION CONSTRUCTOR
+		// Rounds (or widens) every magnitude to T.
+		template<ev_magnitude U>
+		requires(not std::same_as<U, T>)
+		explicit basic_euclidean_vector(basic_euclidean_vector<U> const& other,
+		                                allocator_type const& alloc = {})
+		: magnitudes_{prep_mag<T>(other.dimensions(), alloc.resource())}
+		, dimensions_{itos(other.dimensions())} {
+			ev_count_copy();
+			std::transform(other.begin(), other.end(), this->magnitudes_.get(), [](U u) {
+				return static_cast<T>(u);
+			});
+		}
 		// COPY CONSTRUCTOR
-		euclidean_vector(euclidean_vector const& to_copy);
+		basic_euclidean_vector(basic_euclidean_vector const& to_copy);
+		basic_euclidean_vector(basic_euclidean_vector const& to_copy, allocator_type const& alloc);
 		// MOVE CONSTRUCTOR
-		euclidean_vector(euclidean_vector&& to_move) noexcept;
+		basic_euclidean_vector(basic_euclidean_vector&& to_move) noexcept;
+		basic_euclidean_vector(basic_euclidean_vector&& to_move, allocator_type const& alloc);
 		// DESTRUCTOR
-		~euclidean_vector() = default;
+		~basic_euclidean_vector() = default;
 
 		// =========================== OPERATORS ===========================
 		// COPY OPERATOR
-		auto operator=(euclidean_vector const& to_copy) -> euclidean_vector&;
+		auto operator=(basic_euclidean_vector const& to_copy) -> basic_euclidean_vector&;
 		// MOVE OPERATOR
-		auto operator=(euclidean_vector&&) noexcept -> euclidean_vector&;
+		auto operator=(basic_euclidean_vector&&) noexcept -> basic_euclidean_vector&;
+		// EXPRESSION OPERATOR
+		template<ev_expression_node E>
+		requires std::same_as<ev_value_t<E>, T>
+		auto operator=(E const& expr) -> basic_euclidean_vector& {
+			// Operands of an element-wise expression always share its dimensions, so a differently
+			// sized target can't alias any of them and a fresh buffer is safe.
+			if (itos(expr.dimensions()) != this->dimensions_) {
+				this->magnitudes_.resize_for_overwrite(itos(expr.dimensions()));
+				this->dimensions_ = itos(expr.dimensions());
+			}
+			this->evaluate(expr);
+			return *this;
+		}
 		// SUBSCRIPT OPERATOR
-		auto operator[](int i) -> double;
+		auto operator[](int i) -> T;
 		// CONST SUBSCRIPT OPERATOR
-		auto operator[](int i) const -> double;
+		auto operator[](int i) const -> T;
 		// UNARY PLUS OPERATOR
-		auto operator+() -> euclidean_vector;
+		auto operator+() -> basic_euclidean_vector;
 		// NEGATION OPERATOR
-		auto operator-() -> euclidean_vector;
+		auto operator-() -> basic_euclidean_vector;
 		// COMPOUND ADDITION OPERATOR
-		auto operator+=(euclidean_vector const& ev) -> euclidean_vector&;
+		auto operator+=(basic_euclidean_vector const& ev) -> basic_euclidean_vector&;
 		// COMPOUND SUBTRACTION OPERATOR
-		auto operator-=(euclidean_vector const&) -> euclidean_vector&;
+		auto operator-=(basic_euclidean_vector const&) -> basic_euclidean_vector&;
+		// COMPOUND EXPRESSION ADDITION OPERATOR
+		template<ev_expression_node E>
+		requires std::same_as<ev_value_t<E>, T>
+		auto operator+=(E const& expr) -> basic_euclidean_vector& {
+			check_dimensions(this->dimensions(), expr.dimensions());
+			for (auto i = std::size_t{0}; i < this->dimensions_; ++i) {
+				this->magnitudes_[i] += expr[i];
+			}
+			this->invalidate_norm();
+			return *this;
+		}
+		// COMPOUND EXPRESSION SUBTRACTION OPERATOR
+		template<ev_expression_node E>
+		requires std::same_as<ev_value_t<E>, T>
+		auto operator-=(E const& expr) -> basic_euclidean_vector& {
+			check_dimensions(this->dimensions(), expr.dimensions());
+			for (auto i = std::size_t{0}; i < this->dimensions_; ++i) {
+				this->magnitudes_[i] -= expr[i];
+			}
+			this->invalidate_norm();
+			return *this;
+		}
 		// COMPOUND MULTIPLICATION OPERATOR
-		auto operator*=(double) -> euclidean_vector&;
+		auto operator*=(double) -> basic_euclidean_vector&;
 		// COMPOUND DIVISION OPERATOR
-		auto operator/=(double) -> euclidean_vector&;
+		auto operator/=(double) -> basic_euclidean_vector&;
 		// VECTOR TYPE CONVERSION OPERATOR
-		explicit operator std::vector<double>();
+		explicit operator std::vector<T>();
 		// VECTOR TYPE CONVERSION OPERATOR
-		explicit operator std::vector<double>() const;
+		explicit operator std::vector<T>() const;
 		// LIST TYPE CONVERSION OPERATOR
-		explicit operator std::list<double>();
+		explicit operator std::list<T>();
 		// LIST TYPE CONVERSION OPERATOR
-		explicit operator std::list<double>() const;
+		explicit operator std::list<T>() const;
 
 		// =========================== MEMBER FUNCTIONS ===========================
 		// AT METHOD
-		[[nodiscard]] auto at(int i) -> double {
+		[[nodiscard]] auto at(int i) -> T {
 			if (i < 0 or i >= this->dimensions()) {
 				auto err_msg =
 				   "Index " + std::to_string(i) + " is not valid for this euclidean_vector object";
@@ -90,7 +266,7 @@ namespace comp6771 {
 		}
 
 		// AT CONST METHOD
-		[[nodiscard]] auto at(int i) const -> double& {
+		[[nodiscard]] auto at(int i) const -> T {
 			if (i < 0 or i >= this->dimensions()) {
 				auto err_msg =
 				   "Index " + std::to_string(i) + " is not valid for this euclidean_vector object";
@@ -104,98 +280,471 @@ namespace comp6771 {
 			return static_cast<int>(dimensions_);
 		}
 
+		// GET ALLOCATOR METHOD
+		[[nodiscard]] auto get_allocator() const -> allocator_type {
+			return allocator_type(this->magnitudes_.resource());
+		}
+
+		// DATA METHOD
+		[[nodiscard]] auto data() const -> T const* {
+			return this->magnitudes_.get();
+		}
+
+		// RELEASE METHOD
+		// Moves the magnitudes out and leaves a 0-dimensional vector. A buffer adopted from a
+		// std::vector goes back without a copy; any other buffer is copied once.
+		[[nodiscard]] auto release_to_vector() && -> std::vector<T>;
+
+		// COPY TO METHOD
+		// Writes every magnitude to `out` and returns the iterator past the last one written.
+		template<std::output_iterator<T const&> O>
+		auto copy_to(O out) const -> O {
+			return std::copy(this->begin(), this->end(), std::move(out));
+		}
+
+		// Returns the prefix of `out` that was written; throws if `out` is too small.
+		auto copy_to(std::span<T> out) const -> std::span<T>;
+
 		// BEGIN METHOD
-		[[nodiscard]] auto begin() const -> std::__wrap_iter<double*> {
+		// Mutable iterators can change any magnitude, so handing them out drops the cached norm.
+		[[nodiscard]] auto begin() -> typename std::span<T>::iterator {
+			this->invalidate_norm();
 			auto s = std::span(this->magnitudes_.get(), this->dimensions_);
 			return s.begin();
 		}
 
+		[[nodiscard]] auto begin() const -> typename std::span<T const>::iterator {
+			auto s = std::span<T const>(this->magnitudes_.get(), this->dimensions_);
+			return s.begin();
+		}
+
 		// END METHOD
-		[[nodiscard]] auto end() const -> std::__wrap_iter<double*> {
+		[[nodiscard]] auto end() -> typename std::span<T>::iterator {
+			this->invalidate_norm();
 			auto s = std::span(this->magnitudes_.get(), this->dimensions_);
 			return s.end();
 		}
 
+		[[nodiscard]] auto end() const -> typename std::span<T const>::iterator {
+			auto s = std::span<T const>(this->magnitudes_.get(), this->dimensions_);
+			return s.end();
+		}
+
 		// =========================== FRIENDS ===========================
+		// EUCLIDEAN NORMAL FRIEND
+		// Reads and fills the norm cache; declared again with the other utilities below.
+		friend auto euclidean_norm<>(basic_euclidean_vector const& v) -> double;
+
+		// FUSED FRIENDS
+		// Write straight into the magnitudes and keep the norm cache honest; declared again with
+		// the other utilities below.
+		friend auto axpy<>(double a, basic_euclidean_vector const& x, basic_euclidean_vector& y)
+		   -> void;
+		friend auto axpby<>(double a,
+		                    basic_euclidean_vector const& x,
+		                    double b,
+		                    basic_euclidean_vector& y) -> void;
+		friend auto dot_and_norms<>(basic_euclidean_vector const& x, basic_euclidean_vector const& y)
+		   -> dot_and_norms_result;
+
+		// PARALLEL FRIENDS
+		// Declared in parallel.hpp; double vectors only.
+		friend auto euclidean_norm(parallel_policy const& policy,
+		                           basic_euclidean_vector<double> const& v) -> double;
+		friend auto add_assign(parallel_policy const& policy,
+		                       basic_euclidean_vector<double>& y,
+		                       basic_euclidean_vector<double> const& x) -> void;
+
 		// EQUAL FRIEND
-		friend auto operator==(euclidean_vector const& ev1, euclidean_vector const& ev2) -> bool {
-			return std::equal(ev1.begin(), ev1.end(), ev2.begin());
+		friend auto operator==(basic_euclidean_vector const& ev1, basic_euclidean_vector const& ev2)
+		   -> bool {
+			return ev1.dimensions_ == ev2.dimensions_
+			       and std::equal(ev1.begin(), ev1.end(), ev2.begin());
 		}
 
 		// NOT EQUAL FRIEND
-		friend auto operator!=(euclidean_vector const& ev1, euclidean_vector const& ev2) -> bool {
-			return !std::equal(ev1.begin(), ev1.end(), ev2.begin());
+		friend auto operator!=(basic_euclidean_vector const& ev1, basic_euclidean_vector const& ev2)
+		   -> bool {
+			return !(ev1 == ev2);
+		}
+
+		// The addition, subtraction, multiplication and division friends are lazy; see
+		// EXPRESSION OPERATORS below.
+
+		// OUTPUT STREAM FRIEND
+		// Follows the stream's formatting flags; euclidean_vector_text.hpp has a faster, exact form.
+		friend auto operator<<(std::ostream& os, basic_euclidean_vector const& ev) -> std::ostream& {
+			auto s = std::span<T const>(ev.magnitudes_.get(), ev.dimensions_);
+			os << '[';
+			if (not s.empty()) {
+				os << s.front();
+				std::for_each (std::next(s.begin()), s.end(), [&](T const& d) { os << ' ' << d; });
+			}
+			return os << "]";
+		}
+
+		// DIMENSION CHECK
+		// Throws the error every binary operation reports for mismatched operands.
+		static auto check_dimensions(int lhs, int rhs) -> void {
+			if (lhs != rhs) {
+				auto err_msg = "Dimensions of LHS(" + std::to_string(lhs) + ") and RHS("
+				               + std::to_string(rhs) + ") do not match";
+				throw euclidean_vector_error(err_msg);
+			}
 		}
 
-		// ADDITION FRIEND
-		friend auto operator+(euclidean_vector const& ev1, euclidean_vector const& ev2)
-		   -> euclidean_vector {
-			auto r = ev1;
-			r += ev2;
-			return r;
+	private:
+		// ========================== NORM CACHE =========================
+		// The cache is a single atomic word, so const vectors shared between threads can fill it
+		// concurrently: every racing writer stores the same value. Relaxed ordering suffices because
+		// the cached value is the only thing published.
+		static constexpr auto no_norm = -1.0;
+
+		auto invalidate_norm() const noexcept -> void {
+			this->norm_.store(no_norm, std::memory_order_relaxed);
 		}
 
-		// SUBTRACTION FRIEND
-		friend auto operator-(euclidean_vector const& ev1, euclidean_vector const& ev2)
-		   -> euclidean_vector {
-			auto r = ev1;
-			return r -= ev2;
+		// Scaling every magnitude by d scales the norm by |d|, so a cached norm stays valid.
+		auto scale_norm(double factor) noexcept -> void {
+			auto const norm = this->norm_.load(std::memory_order_relaxed);
+			if (norm != no_norm) {
+				this->norm_.store(norm * factor, std::memory_order_relaxed);
+			}
 		}
 
-		// MULTIPLICATION FRIENDS
-		friend auto operator*(euclidean_vector const& ev, double d) -> euclidean_vector {
-			auto r = euclidean_vector(ev.dimensions());
-			auto sr = std::span(r.magnitudes_.get(), r.dimensions_);
-			auto s1 = std::span(ev.magnitudes_.get(), ev.dimensions_);
-			std::transform(s1.begin(), s1.end(), sr.begin(), [&](double& a) { return a * d; });
-			return r;
+		template<ev_expression_node E>
+		static auto adopt(E& expr) -> basic_euclidean_vector {
+			if (auto* const owned = expr.owned_operand(); owned != nullptr) {
+				owned->evaluate(expr);
+				return std::move(*owned);
+			}
+			return basic_euclidean_vector(std::as_const(expr));
+		}
+
+		template<ev_expression_node E>
+		auto evaluate(E const& expr) -> void {
+			for (auto i = std::size_t{0}; i < this->dimensions_; ++i) {
+				this->magnitudes_[i] = expr[i];
+			}
+			this->invalidate_norm();
 		}
 
-		friend auto operator*(double d, euclidean_vector const& ev) -> euclidean_vector {
-			auto r = euclidean_vector(ev.dimensions());
-			auto sr = std::span(r.magnitudes_.get(), r.dimensions_);
-			auto s1 = std::span(ev.magnitudes_.get(), ev.dimensions_);
-			std::transform(s1.begin(), s1.end(), sr.begin(), [&](double& a) { return a * d; });
-			return r;
+		// Inline up to magnitude_storage::inline_capacity dimensions, heap allocated above it.
+		basic_magnitude_storage<T> magnitudes_;
+		std::size_t dimensions_;
+		mutable std::atomic<double> norm_ = no_norm;
+	};
+
+	// Both magnitude types are compiled once, in euclidean_vector.cpp.
+	extern template class basic_euclidean_vector<float>;
+	extern template class basic_euclidean_vector<double>;
+
+	// ========================== EXPRESSION NODES ==========================
+	// Lvalue euclidean_vectors are held by reference; rvalue vectors are moved into the node and
+	// sub-expressions are held by value, so a node never outlives its operands.
+	template<typename T>
+	using ev_operand_t = std::conditional_t<is_basic_euclidean_vector<std::remove_cvref_t<T>>
+	                                           and std::is_lvalue_reference_v<T>,
+	                                        std::remove_cvref_t<T> const&,
+	                                        std::remove_cvref_t<T>>;
+
+	template<typename T>
+	inline auto ev_element(T const& operand, std::size_t i) -> ev_value_t<T> {
+		if constexpr (is_basic_euclidean_vector<T>) {
+			return operand.data()[i];
 		}
+		else {
+			return operand[i];
+		}
+	}
 
-		// DIVISION FRIEND
-		friend auto operator/(euclidean_vector const& ev, double d) -> euclidean_vector {
-			if (d == 0.0) {
-				const auto* err_msg = "Invalid vector division by 0";
+	// The vector an operand owns outright, if any: only vectors moved into the node qualify.
+	template<typename Operand>
+	inline auto ev_owned_operand(Operand& operand) -> basic_euclidean_vector<ev_value_t<Operand>>* {
+		if constexpr (std::is_reference_v<Operand>) {
+			return nullptr;
+		}
+		else if constexpr (is_basic_euclidean_vector<Operand>) {
+			return &operand;
+		}
+		else {
+			return operand.owned_operand();
+		}
+	}
+
+	// Whether an operand reads the magnitudes of the vector at `v`.
+	template<typename Operand, typename T>
+	inline auto ev_reads(Operand const& operand, basic_euclidean_vector<T> const* v) -> bool {
+		if constexpr (is_basic_euclidean_vector<Operand>) {
+			return &operand == v;
+		}
+		else {
+			return operand.reads(v);
+		}
+	}
+
+	// An rvalue vector is moved into its node unless the other operand of the same operator also
+	// reads it, as in `std::move(a) + a`; then it is copied, so the other operand still sees its
+	// magnitudes.
+	template<typename Operand, typename T, typename Other>
+	inline auto ev_take(T&& operand, Other const& other) -> Operand {
+		if constexpr (std::is_reference_v<Operand> or not is_basic_euclidean_vector<Operand>) {
+			return std::forward<T>(operand);
+		}
+		else {
+			if (ev_reads(other, &std::as_const(operand))) {
+				return Operand(std::as_const(operand));
+			}
+			return Operand(std::move(operand));
+		}
+	}
+
+	template<typename L, typename R, typename Op>
+	class ev_binary_expression {
+	public:
+		using value_type = ev_value_t<L>;
+
+		ev_binary_expression(L lhs, R rhs)
+		: lhs_{std::forward<L>(lhs)}
+		, rhs_{std::forward<R>(rhs)} {
+			euclidean_vector::check_dimensions(lhs_.dimensions(), rhs_.dimensions());
+		}
+
+		[[nodiscard]] auto dimensions() const -> int {
+			return lhs_.dimensions();
+		}
+
+		auto operator[](std::size_t i) const -> value_type {
+			return Op{}(ev_element(lhs_, i), ev_element(rhs_, i));
+		}
+
+		// OWNED OPERAND
+		auto owned_operand() -> basic_euclidean_vector<value_type>* {
+			auto* const owned = ev_owned_operand<L>(lhs_);
+			return owned != nullptr ? owned : ev_owned_operand<R>(rhs_);
+		}
+
+		auto reads(basic_euclidean_vector<value_type> const* v) const -> bool {
+			return ev_reads(lhs_, v) or ev_reads(rhs_, v);
+		}
+
+		[[nodiscard]] auto at(int i) const -> value_type {
+			if (i < 0 or i >= this->dimensions()) {
+				auto err_msg =
+				   "Index " + std::to_string(i) + " is not valid for this euclidean_vector object";
 				throw euclidean_vector_error(err_msg);
 			}
-			auto r = euclidean_vector(ev.dimensions());
-			auto sr = std::span(r.magnitudes_.get(), r.dimensions_);
-			auto s1 = std::span(ev.magnitudes_.get(), ev.dimensions_);
-			std::transform(s1.begin(), s1.end(), sr.begin(), [&](double& a) { return a / d; });
-			return r;
+			return (*this)[itos(i)];
 		}
 
-		// OUTPUT STREAM FRIEND
-		friend auto operator<<(std::ostream& os, euclidean_vector const& ev) -> std::ostream& {
-			auto s = std::span(ev.magnitudes_.get(), ev.dimensions_);
-			os << '[' << ev.at(0);
-			std::for_each (std::next(s.begin()), s.end(), [&](double& d) { os << ' ' << d; });
-			return os << "]";
+	private:
+		L lhs_;
+		R rhs_;
+	};
+
+	template<typename E, typename Op>
+	class ev_scalar_expression {
+	public:
+		using value_type = ev_value_t<E>;
+
+		ev_scalar_expression(E expr, double d)
+		: expr_{std::forward<E>(expr)}
+		, d_{static_cast<value_type>(d)} {}
+
+		[[nodiscard]] auto dimensions() const -> int {
+			return expr_.dimensions();
+		}
+
+		auto operator[](std::size_t i) const -> value_type {
+			return Op{}(ev_element(expr_, i), d_);
+		}
+
+		// OWNED OPERAND
+		auto owned_operand() -> basic_euclidean_vector<value_type>* {
+			return ev_owned_operand<E>(expr_);
+		}
+
+		auto reads(basic_euclidean_vector<value_type> const* v) const -> bool {
+			return ev_reads(expr_, v);
+		}
+
+		[[nodiscard]] auto at(int i) const -> value_type {
+			if (i < 0 or i >= this->dimensions()) {
+				auto err_msg =
+				   "Index " + std::to_string(i) + " is not valid for this euclidean_vector object";
+				throw euclidean_vector_error(err_msg);
+			}
+			return (*this)[itos(i)];
 		}
 
 	private:
-		// ass2 spec requires we use double[]
-		// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-		std::unique_ptr<double[]> magnitudes_;
-		std::size_t dimensions_;
+		E expr_;
+		// Applied at the expression's precision, like *= and /=.
+		value_type d_;
 	};
 
+	// ========================== EXPRESSION OPERATORS ==========================
+	// ADDITION
+	template<ev_expression L, ev_expression R>
+	requires std::same_as<ev_value_t<L>, ev_value_t<R>>
+	auto operator+(L&& lhs, R&& rhs) {
+		using lhs_operand = ev_operand_t<L&&>;
+		using rhs_operand = ev_operand_t<R&&>;
+		return ev_binary_expression<lhs_operand, rhs_operand, std::plus<>>(
+		   ev_take<lhs_operand>(std::forward<L>(lhs), rhs),
+		   ev_take<rhs_operand>(std::forward<R>(rhs), lhs));
+	}
+
+	// SUBTRACTION
+	template<ev_expression L, ev_expression R>
+	requires std::same_as<ev_value_t<L>, ev_value_t<R>>
+	auto operator-(L&& lhs, R&& rhs) {
+		using lhs_operand = ev_operand_t<L&&>;
+		using rhs_operand = ev_operand_t<R&&>;
+		return ev_binary_expression<lhs_operand, rhs_operand, std::minus<>>(
+		   ev_take<lhs_operand>(std::forward<L>(lhs), rhs),
+		   ev_take<rhs_operand>(std::forward<R>(rhs), lhs));
+	}
+
+	// MULTIPLICATION
+	template<ev_expression E>
+	auto operator*(E&& expr, double d) {
+		return ev_scalar_expression<ev_operand_t<E&&>, std::multiplies<>>(std::forward<E>(expr), d);
+	}
+
+	template<ev_expression E>
+	auto operator*(double d, E&& expr) {
+		return ev_scalar_expression<ev_operand_t<E&&>, std::multiplies<>>(std::forward<E>(expr), d);
+	}
+
+	// DIVISION
+	template<ev_expression E>
+	auto operator/(E&& expr, double d) {
+		if (d == 0.0) {
+			const auto* err_msg = "Invalid vector division by 0";
+			throw euclidean_vector_error(err_msg);
+		}
+		return ev_scalar_expression<ev_operand_t<E&&>, std::divides<>>(std::forward<E>(expr), d);
+	}
+
+	// OUTPUT STREAM
+	template<ev_expression_node E>
+	auto operator<<(std::ostream& os, E const& expr) -> std::ostream& {
+		return os << basic_euclidean_vector<ev_value_t<E>>(expr);
+	}
+
 	// =========================== UTILITY ===========================
+	// The span overloads work on magnitudes owned elsewhere, such as the rows of a
+	// euclidean_vector_batch. They follow the same rules as the euclidean_vector ones, minus the
+	// norm cache. Expressions are evaluated into a vector of their magnitude type first.
+
+	// Yields a vector as is and evaluates an expression node into a new one.
+	template<ev_expression E>
+	auto ev_evaluate(E const& expr) -> decltype(auto) {
+		if constexpr (ev_expression_node<E>) {
+			return basic_euclidean_vector<ev_value_t<E>>(expr);
+		}
+		else {
+			return (expr);
+		}
+	}
+
 	// EUCLIDEAN NORMAL
-	auto euclidean_norm(euclidean_vector const& v) -> double;
+	template<ev_magnitude T>
+	auto euclidean_norm(basic_euclidean_vector<T> const& v) -> double;
+	auto euclidean_norm(std::span<double const> v) -> double;
+
+	template<ev_expression_node E>
+	auto euclidean_norm(E const& expr) -> double {
+		return euclidean_norm(ev_evaluate(expr));
+	}
+
+	// Sums the squares in A rather than ev_accumulator_t<T>. Bypasses the norm cache.
+	template<ev_magnitude T, std::floating_point A>
+	auto euclidean_norm(basic_euclidean_vector<T> const& v, accumulate_in_t<A>) -> A {
+		auto squares = A{0};
+		for (auto const m : v) {
+			squares += static_cast<A>(m) * static_cast<A>(m);
+		}
+		return std::sqrt(squares);
+	}
 
 	// UNIT
-	auto unit(euclidean_vector const& v) -> euclidean_vector;
+	template<ev_magnitude T>
+	auto unit(basic_euclidean_vector<T> const& v) -> basic_euclidean_vector<T>;
+	auto unit(std::span<double const> v) -> euclidean_vector;
+
+	template<ev_expression_node E>
+	auto unit(E const& expr) -> basic_euclidean_vector<ev_value_t<E>> {
+		return unit(ev_evaluate(expr));
+	}
 
 	// DOT PRODUCT
-	auto dot(euclidean_vector const& x, euclidean_vector const& y) -> double;
+	template<ev_magnitude T>
+	auto dot(basic_euclidean_vector<T> const& x, basic_euclidean_vector<T> const& y) -> double;
+	auto dot(std::span<double const> x, std::span<double const> y) -> double;
+
+	template<ev_expression L, ev_expression R>
+	requires(ev_expression_node<L> or ev_expression_node<R>)
+	        and std::same_as<ev_value_t<L>, ev_value_t<R>>
+	auto dot(L const& x, R const& y) -> double {
+		return dot(ev_evaluate(x), ev_evaluate(y));
+	}
+
+	// Sums the products in A rather than ev_accumulator_t<T>.
+	template<ev_magnitude T, std::floating_point A>
+	auto dot(basic_euclidean_vector<T> const& x,
+	         basic_euclidean_vector<T> const& y,
+	         accumulate_in_t<A>) -> A {
+		euclidean_vector::check_dimensions(x.dimensions(), y.dimensions());
+		return std::inner_product(x.begin(), x.end(), y.begin(), A{0}, std::plus<>(), [](T a, T b) {
+			return static_cast<A>(a) * static_cast<A>(b);
+		});
+	}
+
+	// The fused operations below each make one pass over memory and never allocate.
+
+	// AXPY
+	// y += a * x, without the temporary a * x.
+	template<ev_magnitude T>
+	auto axpy(double a, basic_euclidean_vector<T> const& x, basic_euclidean_vector<T>& y) -> void;
+	auto axpy(double a, std::span<double const> x, std::span<double> y) -> void;
+
+	// AXPBY
+	// y = a * x + b * y
+	template<ev_magnitude T>
+	auto axpby(double a, basic_euclidean_vector<T> const& x, double b, basic_euclidean_vector<T>& y)
+	   -> void;
+	auto axpby(double a, std::span<double const> x, double b, std::span<double> y) -> void;
+
+	// DOT AND NORMS
+	// dot(x, y), euclidean_norm(x) and euclidean_norm(y) together. Fills both norm caches.
+	template<ev_magnitude T>
+	auto dot_and_norms(basic_euclidean_vector<T> const& x, basic_euclidean_vector<T> const& y)
+	   -> dot_and_norms_result;
+	auto dot_and_norms(std::span<double const> x, std::span<double const> y)
+	   -> dot_and_norms_result;
+
+	template<ev_expression L, ev_expression R>
+	requires(ev_expression_node<L> or ev_expression_node<R>)
+	        and std::same_as<ev_value_t<L>, ev_value_t<R>>
+	auto dot_and_norms(L const& x, R const& y) -> dot_and_norms_result {
+		return dot_and_norms(ev_evaluate(x), ev_evaluate(y));
+	}
+
+	// COSINE SIMILARITY
+	// dot(x, y) / (euclidean_norm(x) * euclidean_norm(y)). Throws if either norm is zero.
+	template<ev_magnitude T>
+	auto cosine_similarity(basic_euclidean_vector<T> const& x, basic_euclidean_vector<T> const& y)
+	   -> double;
+	auto cosine_similarity(std::span<double const> x, std::span<double const> y) -> double;
+
+	template<ev_expression L, ev_expression R>
+	requires(ev_expression_node<L> or ev_expression_node<R>)
+	        and std::same_as<ev_value_t<L>, ev_value_t<R>>
+	auto cosine_similarity(L const& x, R const& y) -> double {
+		return cosine_similarity(ev_evaluate(x), ev_evaluate(y));
+	}
 } // namespace comp6771
 
 #endif // COMP6771_EUCLIDEAN_VECTOR_HPP
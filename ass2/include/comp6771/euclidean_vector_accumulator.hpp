@@ -0,0 +1,79 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_ACCUMULATOR_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_ACCUMULATOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace comp6771 {
+	// A running total of euclidean vectors that many threads can add to at once.
+	//
+	// The total is kept as `shards` partial sums, each on its own cache lines behind its own lock.
+	// Each thread always adds into the same shard. Threads are numbered from 0 the first time they
+	// add to any accumulator, and a number is reused once its thread exits, so however many
+	// threads come and go, threads only contend when more of them are alive than there are
+	// shards. snapshot()
+	// holds every shard's lock while it combines them, so it sees each add whole or not at all.
+	//
+	// Which shard a thread's adds land in is not fixed from run to run, so a total of values that
+	// don't sum exactly in doubles may differ in its last bits between runs.
+	class euclidean_vector_accumulator {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		// CONSTRUCTOR
+		// A zero total of `dim` dimensions, over `shards` partial sums (at least 1). By default there
+		// is a shard per hardware thread, or one when that count is unknown.
+		explicit euclidean_vector_accumulator(
+		   int dim,
+		   int shards = static_cast<int>(std::max(1U, std::thread::hardware_concurrency())));
+		euclidean_vector_accumulator(euclidean_vector_accumulator const&) = delete;
+		euclidean_vector_accumulator(euclidean_vector_accumulator&&) = delete;
+		~euclidean_vector_accumulator() = default;
+
+		// =========================== OPERATORS ===========================
+		auto operator=(euclidean_vector_accumulator const&) -> euclidean_vector_accumulator& = delete;
+		auto operator=(euclidean_vector_accumulator&&) -> euclidean_vector_accumulator& = delete;
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		[[nodiscard]] auto dimensions() const -> int {
+			return static_cast<int>(dimensions_);
+		}
+
+		[[nodiscard]] auto shards() const -> int {
+			return static_cast<int>(locks_.size());
+		}
+
+		// ADD METHOD
+		// total += v. Safe to call from any number of threads at once.
+		auto add(euclidean_vector const& v) -> void;
+		auto add(std::span<double const> v) -> void;
+
+		// SNAPSHOT METHOD
+		// The total of every add that finished before the call, and of none that started after.
+		[[nodiscard]] auto snapshot() const -> euclidean_vector;
+
+		// RESET METHOD
+		// Sets the total back to zero.
+		auto reset() -> void;
+
+	private:
+		// Padded so that no two shards' locks share a cache line.
+		struct alignas(euclidean_vector_batch::alignment) shard_lock {
+			std::mutex mutex;
+		};
+
+		auto lock_all() const -> std::vector<std::unique_lock<std::mutex>>;
+
+		std::size_t dimensions_;
+		// Row i, padded to whole cache lines, is shard i's partial sum.
+		euclidean_vector_batch sums_;
+		mutable std::vector<shard_lock> locks_;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_ACCUMULATOR_HPP
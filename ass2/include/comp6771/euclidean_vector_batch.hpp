@@ -0,0 +1,157 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	// How a batch lays out its magnitudes. Row-major keeps each vector contiguous; column-major
+	// (structure of arrays) keeps each dimension contiguous across all vectors.
+	enum class batch_layout { row_major, column_major };
+
+	// `size` euclidean vectors of the same dimension stored in one 64-byte aligned buffer.
+	class euclidean_vector_batch {
+	public:
+		using allocator_type = std::pmr::polymorphic_allocator<double>;
+
+		static constexpr auto alignment = std::size_t{64};
+
+		// ========================== CONSTRUCTORS =========================
+		// Zero-initialises `size` vectors of `dim` dimensions. Negative counts, and more magnitudes
+		// than a std::size_t can count the bytes of, are rejected before anything is allocated.
+		euclidean_vector_batch(int size,
+		                       int dim,
+		                       batch_layout layout = batch_layout::row_major,
+		                       allocator_type const& alloc = {});
+		// COPY CONSTRUCTOR
+		euclidean_vector_batch(euclidean_vector_batch const& to_copy);
+		// MOVE CONSTRUCTOR
+		euclidean_vector_batch(euclidean_vector_batch&& to_move) noexcept;
+		// DESTRUCTOR
+		~euclidean_vector_batch();
+
+		// =========================== OPERATORS ===========================
+		// COPY OPERATOR
+		auto operator=(euclidean_vector_batch const& to_copy) -> euclidean_vector_batch&;
+		// MOVE OPERATOR
+		auto operator=(euclidean_vector_batch&& to_move) noexcept -> euclidean_vector_batch&;
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		[[nodiscard]] auto size() const -> int {
+			return static_cast<int>(size_);
+		}
+
+		[[nodiscard]] auto dimensions() const -> int {
+			return static_cast<int>(dimensions_);
+		}
+
+		[[nodiscard]] auto layout() const -> batch_layout {
+			return layout_;
+		}
+
+		[[nodiscard]] auto get_allocator() const -> allocator_type {
+			return allocator_type(resource_);
+		}
+
+		// AT METHOD
+		// Bounds-checked access to dimension `dim` of vector `row`, in either layout.
+		[[nodiscard]] auto at(int row, int dim) -> double&;
+		[[nodiscard]] auto at(int row, int dim) const -> double;
+
+		// ROW METHOD
+		// A view of one vector that works with dot, euclidean_norm and unit. Rows are only
+		// contiguous in row-major batches; column-major batches throw.
+		[[nodiscard]] auto row(int i) -> std::span<double>;
+		[[nodiscard]] auto row(int i) const -> std::span<double const>;
+
+		// COPY ROW METHOD
+		[[nodiscard]] auto copy_row(int i) const -> euclidean_vector;
+
+		// SET ROW METHOD
+		auto set_row(int i, euclidean_vector const& ev) -> void;
+
+		// DATA METHOD
+		// The whole buffer, laid out according to layout().
+		[[nodiscard]] auto data() -> std::span<double>;
+		[[nodiscard]] auto data() const -> std::span<double const>;
+
+	private:
+		auto check_row(int i) const -> void;
+		auto element(std::size_t row, std::size_t dim) const -> std::size_t;
+		auto release() noexcept -> void;
+
+		double* magnitudes_ = nullptr;
+		std::size_t size_ = 0;
+		std::size_t dimensions_ = 0;
+		batch_layout layout_ = batch_layout::row_major;
+		std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+	};
+
+	// =========================== UTILITY ===========================
+	// BULK DOT PRODUCT
+	// out[i] = dot(batch row i, query). `out` must hold batch.size() results.
+	auto dot(euclidean_vector_batch const& batch,
+	         euclidean_vector const& query,
+	         std::span<double> out) -> void;
+	auto dot(euclidean_vector_batch const& batch, euclidean_vector const& query)
+	   -> std::vector<double>;
+
+	// BULK EUCLIDEAN NORMAL
+	auto euclidean_norm(euclidean_vector_batch const& batch, std::span<double> out) -> void;
+	auto euclidean_norm(euclidean_vector_batch const& batch) -> std::vector<double>;
+
+	// BULK UNIT
+	// Every row scaled to unit length, in the same layout. Throws if any row can't be.
+	auto unit(euclidean_vector_batch const& batch) -> euclidean_vector_batch;
+
+	// ROW MAJOR
+	// The same vectors laid out row-major, with the same resource. A row-major batch is returned
+	// as it is.
+	auto row_major(euclidean_vector_batch batch) -> euclidean_vector_batch;
+
+	// ========================== ROW-MAJOR VIEW ==========================
+	// Every row of a batch as one contiguous span, whatever the batch's layout: a row-major batch
+	// is read in place, a column-major one through a row-major copy made once, up front. The rows
+	// may point into that copy, so a view can be neither copied nor moved. Like a span, it never
+	// outlives the batch it was made from.
+	class row_major_view {
+	public:
+		explicit row_major_view(euclidean_vector_batch const& batch);
+		row_major_view(row_major_view const&) = delete;
+		row_major_view(row_major_view&&) = delete;
+		~row_major_view() = default;
+
+		auto operator=(row_major_view const&) -> row_major_view& = delete;
+		auto operator=(row_major_view&&) -> row_major_view& = delete;
+
+		[[nodiscard]] auto size() const -> std::size_t {
+			return size_;
+		}
+
+		[[nodiscard]] auto dims() const -> std::size_t {
+			return dims_;
+		}
+
+		// DATA METHOD
+		// Every row, one after another.
+		[[nodiscard]] auto data() const -> std::span<double const> {
+			return data_;
+		}
+
+		[[nodiscard]] auto row(std::size_t i) const -> std::span<double const> {
+			return data_.subspan(i * dims_, dims_);
+		}
+
+	private:
+		std::optional<euclidean_vector_batch> copy_;
+		std::span<double const> data_;
+		std::size_t size_;
+		std::size_t dims_;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_BATCH_HPP
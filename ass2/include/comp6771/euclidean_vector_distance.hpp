@@ -0,0 +1,62 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_DISTANCE_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_DISTANCE_HPP
+
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/parallel.hpp"
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	// How far apart two vectors are. l1 is the sum of absolute differences, squared_l2 the sum of
+	// squared differences, linf the largest absolute difference and cosine one minus the cosine
+	// similarity. As in knn_index, a vector with zero norm is at cosine distance 1 from everything.
+	enum class distance_metric { l1, squared_l2, linf, cosine };
+
+	// =========================== UTILITY ===========================
+	// Dimensions and output sizes are checked once per call, never per pair, and each pair is one
+	// SIMD reduction from kernels::active(). Cosine norms are computed once per vector rather than
+	// once per pair.
+
+	// DISTANCES
+	// out[i] = the distance from batch row i to query. `out` must hold batch.size() results.
+	// Column-major batches stream each dimension's column once, like the bulk dot product.
+	auto distances(distance_metric metric,
+	               euclidean_vector_batch const& batch,
+	               std::span<double const> query,
+	               std::span<double> out) -> void;
+	auto distances(distance_metric metric,
+	               euclidean_vector_batch const& batch,
+	               euclidean_vector const& query,
+	               std::span<double> out) -> void;
+	auto distances(distance_metric metric,
+	               euclidean_vector_batch const& batch,
+	               euclidean_vector const& query) -> std::vector<double>;
+
+	// PAIRWISE DISTANCES
+	// out[i * b.size() + j] = the distance from row i of `a` to row j of `b`. `out` must hold
+	// a.size() * b.size() results. Rows of `b` are taken a cache-sized block at a time so each
+	// block is reused by every row of `a` while it is still cached. Column-major batches are read
+	// through a row-major copy.
+	auto pairwise_distances(distance_metric metric,
+	                        euclidean_vector_batch const& a,
+	                        euclidean_vector_batch const& b,
+	                        std::span<double> out) -> void;
+	auto pairwise_distances(distance_metric metric,
+	                        euclidean_vector_batch const& a,
+	                        euclidean_vector_batch const& b) -> euclidean_matrix;
+	// Blocks of rows of `a` are spread over the policy's thread pool. Every distance is computed
+	// exactly as in the serial overloads.
+	auto pairwise_distances(parallel_policy const& policy,
+	                        distance_metric metric,
+	                        euclidean_vector_batch const& a,
+	                        euclidean_vector_batch const& b,
+	                        std::span<double> out) -> void;
+	auto pairwise_distances(parallel_policy const& policy,
+	                        distance_metric metric,
+	                        euclidean_vector_batch const& a,
+	                        euclidean_vector_batch const& b) -> euclidean_matrix;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_DISTANCE_HPP
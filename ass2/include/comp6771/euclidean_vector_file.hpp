@@ -0,0 +1,145 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_FILE_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_FILE_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+
+namespace comp6771 {
+	// ========================== FILE FORMAT ==========================
+	// A euclidean vector file holds `count` vectors of the same `dimensions`:
+	//
+	//   offset 0   64-byte header, every integer little-endian
+	//                 8 bytes  magic "CS6771EV"
+	//                 4 bytes  version (1)
+	//                 4 bytes  header size in bytes (64)
+	//                 8 bytes  count
+	//                 8 bytes  dimensions
+	//                 8 bytes  offset of the first magnitude (64)
+	//                24 bytes  zero
+	//   offset 64  count * dimensions little-endian IEEE-754 doubles, row-major
+	//
+	// The magnitudes start on a 64-byte boundary, so a mapped file can be read in place.
+	struct euclidean_vector_file_header {
+		static constexpr auto size = std::size_t{64};
+		static constexpr auto current_version = std::uint32_t{1};
+
+		std::uint32_t version = current_version;
+		std::uint64_t count = 0;
+		std::uint64_t dimensions = 0;
+		std::uint64_t data_offset = size;
+	};
+
+	// ========================== WRITER ==========================
+	// Appends vectors to a new file one at a time, so a collection never has to be in memory all
+	// at once. The header's count is patched in by close(), which the destructor calls if needed.
+	class euclidean_vector_writer {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		euclidean_vector_writer(std::filesystem::path const& path, int dimensions);
+		euclidean_vector_writer(euclidean_vector_writer const&) = delete;
+		euclidean_vector_writer(euclidean_vector_writer&&) noexcept = default;
+		// DESTRUCTOR
+		~euclidean_vector_writer();
+
+		// =========================== OPERATORS ===========================
+		auto operator=(euclidean_vector_writer const&) -> euclidean_vector_writer& = delete;
+		// Closes the file this writer was appending to before taking over the other's.
+		auto operator=(euclidean_vector_writer&& to_move) noexcept -> euclidean_vector_writer&;
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		// WRITE METHOD
+		auto write(const_euclidean_vector_view v) -> void;
+		auto write(euclidean_vector_batch const& batch) -> void;
+
+		// CLOSE METHOD
+		// Finishes the file; throws if anything failed to reach it.
+		auto close() -> void;
+
+		[[nodiscard]] auto size() const -> std::uint64_t {
+			return header_.count;
+		}
+
+		[[nodiscard]] auto dimensions() const -> int {
+			return static_cast<int>(header_.dimensions);
+		}
+
+	private:
+		auto write_magnitudes(std::span<double const> magnitudes) -> void;
+
+		std::ofstream out_;
+		euclidean_vector_file_header header_;
+	};
+
+	// ========================== MAPPED FILE ==========================
+	// A read-only memory map of a euclidean vector file. Opening one only validates the header;
+	// pages are read by the OS as vectors are touched. Views stay valid while the mapping is alive.
+	class mapped_euclidean_vector_file {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		explicit mapped_euclidean_vector_file(std::filesystem::path const& path);
+		mapped_euclidean_vector_file(mapped_euclidean_vector_file const&) = delete;
+		mapped_euclidean_vector_file(mapped_euclidean_vector_file&& to_move) noexcept;
+		// DESTRUCTOR
+		~mapped_euclidean_vector_file();
+
+		// =========================== OPERATORS ===========================
+		auto operator=(mapped_euclidean_vector_file const&) -> mapped_euclidean_vector_file& = delete;
+		auto operator=(mapped_euclidean_vector_file&& to_move) noexcept
+		   -> mapped_euclidean_vector_file&;
+		// SUBSCRIPT OPERATOR
+		auto operator[](std::size_t i) const -> const_euclidean_vector_view {
+			return const_euclidean_vector_view(magnitudes_.subspan(i * dimensions_, dimensions_));
+		}
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		// AT METHOD
+		[[nodiscard]] auto at(int i) const -> const_euclidean_vector_view;
+
+		[[nodiscard]] auto size() const -> int {
+			return static_cast<int>(size_);
+		}
+
+		[[nodiscard]] auto dimensions() const -> int {
+			return static_cast<int>(dimensions_);
+		}
+
+		// DATA METHOD
+		// Every magnitude in the file, row-major.
+		[[nodiscard]] auto data() const -> std::span<double const> {
+			return magnitudes_;
+		}
+
+	private:
+		auto unmap() noexcept -> void;
+
+		void* mapping_ = nullptr;
+		std::size_t mapping_bytes_ = 0;
+		std::span<double const> magnitudes_;
+		std::size_t size_ = 0;
+		std::size_t dimensions_ = 0;
+	};
+
+	// =========================== UTILITY ===========================
+	// READ HEADER
+	// Validates and returns a file's header without reading any magnitudes.
+	auto read_euclidean_vector_file_header(std::filesystem::path const& path)
+	   -> euclidean_vector_file_header;
+
+	// LOAD BATCH
+	// Reads a whole file into a row-major batch with one bulk read.
+	auto load_euclidean_vector_batch(std::filesystem::path const& path,
+	                                 euclidean_vector_batch::allocator_type const& alloc = {})
+	   -> euclidean_vector_batch;
+
+	// SAVE BATCH
+	auto save_euclidean_vector_batch(std::filesystem::path const& path,
+	                                 euclidean_vector_batch const& batch) -> void;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_FILE_HPP
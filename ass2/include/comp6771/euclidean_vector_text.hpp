@@ -0,0 +1,161 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_TEXT_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_TEXT_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace comp6771 {
+	// ========================== TEXT FORMAT ==========================
+	// Delimited text, one vector per line: "1.5,-2,3e-08\n" with ',' as the delimiter, as in CSV
+	// and TSV files. Magnitudes are written in the shortest form that reads back to the same
+	// double (std::to_chars) and read with std::from_chars, so nothing depends on the locale
+	// and nothing goes through iostream formatting.
+	//
+	// When reading, blanks around a magnitude are ignored, a trailing '\r' is dropped and empty
+	// lines are skipped. A blank delimiter (' ' or '\t') also accepts any run of blanks, so
+	// space-aligned columns read as expected. Since an empty line holds no vector, a vector with
+	// no dimensions has no text form: writing one throws, and so does parsing an empty line.
+
+	// The most characters one magnitude can take, such as "-2.2250738585072014e-308".
+	inline constexpr auto max_magnitude_chars = std::size_t{24};
+
+	// ========================== FORMATTING ==========================
+	// TO CHARS
+	// Writes the magnitudes of `v` between delimiters, without a newline. Like std::to_chars,
+	// returns std::errc::value_too_large (and leaves [first, last) unspecified) if they don't fit.
+	auto to_chars(char* first, char* last, const_euclidean_vector_view v, char delimiter = ',')
+	   -> std::to_chars_result;
+
+	// Formats vectors into a buffer it keeps between calls, so formatting many vectors allocates
+	// only while the buffer is still growing.
+	class euclidean_vector_formatter {
+	public:
+		explicit euclidean_vector_formatter(char delimiter = ',')
+		: delimiter_{delimiter} {}
+
+		// FORMAT METHOD
+		// The text of `v`, valid until the next call.
+		[[nodiscard]] auto format(const_euclidean_vector_view v) -> std::string_view;
+
+	private:
+		char delimiter_;
+		std::string buffer_;
+	};
+
+	// ========================== WRITER ==========================
+	// Streams vectors to a text file a line at a time. Lines are gathered in a large buffer and
+	// written in big blocks; close(), which the destructor calls if needed, writes the rest.
+	class euclidean_vector_text_writer {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		explicit euclidean_vector_text_writer(std::filesystem::path const& path,
+		                                      char delimiter = ',');
+		euclidean_vector_text_writer(euclidean_vector_text_writer const&) = delete;
+		euclidean_vector_text_writer(euclidean_vector_text_writer&&) noexcept = default;
+		// DESTRUCTOR
+		~euclidean_vector_text_writer();
+
+		// =========================== OPERATORS ===========================
+		auto operator=(euclidean_vector_text_writer const&) -> euclidean_vector_text_writer& = delete;
+		// Writes out what is buffered for the file this writer was streaming to before taking over
+		// the other's.
+		auto operator=(euclidean_vector_text_writer&& to_move) noexcept
+		   -> euclidean_vector_text_writer&;
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		// WRITE METHOD
+		// Throws, writing nothing, for a vector with no dimensions.
+		auto write(const_euclidean_vector_view v) -> void;
+		auto write(euclidean_vector_batch const& batch) -> void;
+
+		// CLOSE METHOD
+		// Writes out what is buffered; throws if anything failed to reach the file.
+		auto close() -> void;
+
+		[[nodiscard]] auto size() const -> std::uint64_t {
+			return count_;
+		}
+
+	private:
+		auto flush() -> void;
+
+		std::ofstream out_;
+		char delimiter_;
+		std::string buffer_;
+		std::uint64_t count_ = 0;
+	};
+
+	// ========================== PARSING ==========================
+	// PARSE
+	// One vector from a single line of text. Throws if it isn't one, including when it is empty.
+	auto parse_euclidean_vector(std::string_view text, char delimiter = ',') -> euclidean_vector;
+
+	// PARSE BATCH
+	// One row per non-empty line. Every line must hold the same number of magnitudes.
+	auto parse_euclidean_vector_batch(std::string_view text, char delimiter = ',')
+	   -> euclidean_vector_batch;
+
+	// LOAD
+	// Reads a whole text file with a euclidean_vector_text_reader.
+	auto load_euclidean_vector_text(std::filesystem::path const& path, char delimiter = ',')
+	   -> euclidean_vector_batch;
+
+	// ========================== READER ==========================
+	// Streams vectors from a text file in fixed-size blocks, so files far bigger than memory can
+	// be read a vector or a batch at a time. Lines longer than a block grow it to fit.
+	class euclidean_vector_text_reader {
+	public:
+		static constexpr auto default_block_bytes = std::size_t{1} << 20;
+
+		// ========================== CONSTRUCTORS =========================
+		explicit euclidean_vector_text_reader(std::filesystem::path const& path,
+		                                      char delimiter = ',',
+		                                      std::size_t block_bytes = default_block_bytes);
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		// READ METHOD
+		// Parses the next vector into `v`, reusing its buffer when the dimensions match. Returns
+		// false, leaving `v` alone, once the file is exhausted.
+		auto read(euclidean_vector& v) -> bool;
+		// Up to `max_rows` vectors; an empty batch once the file is exhausted.
+		auto read(int max_rows) -> euclidean_vector_batch;
+
+		// DIMENSIONS METHOD
+		// Those of the first vector read, which every later one must match; 0 until then.
+		[[nodiscard]] auto dimensions() const -> int {
+			return static_cast<int>(dimensions_);
+		}
+
+	private:
+		auto next_line() -> bool;
+		auto parse_next() -> bool;
+
+		std::ifstream in_;
+		std::filesystem::path path_;
+		char delimiter_;
+		std::vector<char> block_;
+		std::size_t begin_ = 0;
+		std::size_t end_ = 0;
+		std::string_view line_;
+		std::size_t line_number_ = 0;
+		std::size_t dimensions_ = 0;
+		// The magnitudes of the last line parsed.
+		std::vector<double> magnitudes_;
+	};
+
+	// INPUT STREAM OPERATOR
+	// Reads the "[1 2 3]" form operator<< writes, replacing `v`. Sets failbit if there is none.
+	auto operator>>(std::istream& is, euclidean_vector& v) -> std::istream&;
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_TEXT_HPP
@@ -0,0 +1,266 @@
+#ifndef COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
+#define COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace comp6771 {
+	// A euclidean vector over magnitudes owned by someone else: a mapped file, a protocol buffer,
+	// a row of a euclidean_vector_batch. Nothing is copied until the view is explicitly converted
+	// to a euclidean_vector. T is double for a view that can modify the magnitudes, or
+	// double const for one that can only read them.
+	//
+	// Like std::span, a view never outlives the buffer it was made from, and copying a view copies
+	// the reference rather than the magnitudes.
+	template<typename T>
+	requires std::same_as<std::remove_const_t<T>, double>
+	class basic_euclidean_vector_view {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		// DEFAULT CONSTRUCTOR
+		// A view of no magnitudes.
+		constexpr basic_euclidean_vector_view() noexcept = default;
+
+		// SPAN CONSTRUCTOR
+		constexpr explicit basic_euclidean_vector_view(std::span<T> mags) noexcept
+		: magnitudes_{mags} {}
+
+		// EUCLIDEAN VECTOR CONSTRUCTOR
+		// Only read-only views can be taken of a euclidean_vector, so its cached norm can't go
+		// stale behind its back.
+		// NOLINTNEXTLINE(google-explicit-constructor)
+		basic_euclidean_vector_view(euclidean_vector const& ev) noexcept requires std::is_const_v<T>
+		: magnitudes_{ev.data(), itos(ev.dimensions())} {}
+
+		// CONST CONVERSION CONSTRUCTOR
+		template<typename U>
+		requires(std::is_const_v<T> and not std::is_const_v<U>)
+		constexpr basic_euclidean_vector_view( // NOLINT(google-explicit-constructor)
+		   basic_euclidean_vector_view<U> const& view) noexcept
+		: magnitudes_{view.magnitudes()} {}
+
+		// =========================== OPERATORS ===========================
+		// SUBSCRIPT OPERATOR
+		constexpr auto operator[](int i) const -> T& {
+			return magnitudes_[itos(i)];
+		}
+
+		// COMPOUND ADDITION OPERATOR
+		auto operator+=(basic_euclidean_vector_view<double const> view)
+		   -> basic_euclidean_vector_view& requires(not std::is_const_v<T>) {
+			euclidean_vector::check_dimensions(this->dimensions(), view.dimensions());
+			kernels::active().add(magnitudes_.data(), view.magnitudes().data(), magnitudes_.size());
+			return *this;
+		}
+
+		// COMPOUND SUBTRACTION OPERATOR
+		auto operator-=(basic_euclidean_vector_view<double const> view)
+		   -> basic_euclidean_vector_view& requires(not std::is_const_v<T>) {
+			euclidean_vector::check_dimensions(this->dimensions(), view.dimensions());
+			kernels::active().axpy(magnitudes_.data(),
+			                       -1.0,
+			                       view.magnitudes().data(),
+			                       magnitudes_.size());
+			return *this;
+		}
+
+		// COMPOUND MULTIPLICATION OPERATOR
+		auto operator*=(double d) -> basic_euclidean_vector_view& requires(not std::is_const_v<T>) {
+			kernels::active().scale(magnitudes_.data(), d, magnitudes_.size());
+			return *this;
+		}
+
+		// COMPOUND DIVISION OPERATOR
+		auto operator/=(double d) -> basic_euclidean_vector_view& requires(not std::is_const_v<T>) {
+			if (d == 0) {
+				const auto* err_msg = "Invalid vector division by 0";
+				throw euclidean_vector_error(err_msg);
+			}
+			kernels::active().divide(magnitudes_.data(), d, magnitudes_.size());
+			return *this;
+		}
+
+		// EUCLIDEAN VECTOR TYPE CONVERSION OPERATOR
+		// The only operation that copies the magnitudes.
+		explicit operator euclidean_vector() const {
+			auto ev = euclidean_vector(this->dimensions());
+			std::copy(begin(), end(), ev.begin());
+			return ev;
+		}
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		// AT METHOD
+		[[nodiscard]] auto at(int i) const -> T& {
+			if (i < 0 or i >= this->dimensions()) {
+				auto err_msg =
+				   "Index " + std::to_string(i) + " is not valid for this euclidean_vector object";
+				throw euclidean_vector_error(err_msg);
+			}
+			return magnitudes_[itos(i)];
+		}
+
+		// DIMENSIONS METHOD
+		[[nodiscard]] constexpr auto dimensions() const noexcept -> int {
+			return static_cast<int>(magnitudes_.size());
+		}
+
+		// DATA METHOD
+		[[nodiscard]] constexpr auto data() const noexcept -> T* {
+			return magnitudes_.data();
+		}
+
+		// MAGNITUDES METHOD
+		[[nodiscard]] constexpr auto magnitudes() const noexcept -> std::span<T> {
+			return magnitudes_;
+		}
+
+		// BEGIN METHOD
+		[[nodiscard]] constexpr auto begin() const noexcept -> typename std::span<T>::iterator {
+			return magnitudes_.begin();
+		}
+
+		// END METHOD
+		[[nodiscard]] constexpr auto end() const noexcept -> typename std::span<T>::iterator {
+			return magnitudes_.end();
+		}
+
+		// =========================== FRIENDS ===========================
+		// EQUAL FRIEND
+		// Compares magnitudes, not addresses.
+		friend auto operator==(basic_euclidean_vector_view const& v1,
+		                       basic_euclidean_vector_view const& v2) -> bool {
+			return std::equal(v1.begin(), v1.end(), v2.begin(), v2.end());
+		}
+
+		// OUTPUT STREAM FRIEND
+		friend auto operator<<(std::ostream& os, basic_euclidean_vector_view const& view)
+		   -> std::ostream& {
+			os << '[';
+			auto separator = "";
+			for (auto const d : view) {
+				os << std::exchange(separator, " ") << d;
+			}
+			return os << ']';
+		}
+
+	private:
+		std::span<T> magnitudes_;
+	};
+
+	using euclidean_vector_view = basic_euclidean_vector_view<double>;
+	using const_euclidean_vector_view = basic_euclidean_vector_view<double const>;
+
+	// =========================== UTILITY ===========================
+	// Views are contiguous ranges, so they would also convert to the span overloads; these exact
+	// matches keep calls unambiguous, including when views and euclidean_vectors are mixed. None of
+	// them allocate except unit.
+
+	// EUCLIDEAN NORMAL
+	template<typename T>
+	auto euclidean_norm(basic_euclidean_vector_view<T> v) -> double {
+		return euclidean_norm(std::span<double const>(v.magnitudes()));
+	}
+
+	// UNIT
+	template<typename T>
+	auto unit(basic_euclidean_vector_view<T> v) -> euclidean_vector {
+		return unit(std::span<double const>(v.magnitudes()));
+	}
+
+	// DOT PRODUCT
+	template<typename T, typename U>
+	auto dot(basic_euclidean_vector_view<T> x, basic_euclidean_vector_view<U> y) -> double {
+		return dot(std::span<double const>(x.magnitudes()), std::span<double const>(y.magnitudes()));
+	}
+
+	template<typename T>
+	auto dot(basic_euclidean_vector_view<T> x, euclidean_vector const& y) -> double {
+		return dot(x, const_euclidean_vector_view(y));
+	}
+
+	template<typename T>
+	auto dot(euclidean_vector const& x, basic_euclidean_vector_view<T> y) -> double {
+		return dot(const_euclidean_vector_view(x), y);
+	}
+
+	// AXPY
+	template<typename T>
+	auto axpy(double a, basic_euclidean_vector_view<T> x, euclidean_vector_view y) -> void {
+		axpy(a, std::span<double const>(x.magnitudes()), y.magnitudes());
+	}
+
+	inline auto axpy(double a, euclidean_vector const& x, euclidean_vector_view y) -> void {
+		axpy(a, const_euclidean_vector_view(x), y);
+	}
+
+	// Writing through y's mutable iterators drops its cached norm.
+	template<typename T>
+	auto axpy(double a, basic_euclidean_vector_view<T> x, euclidean_vector& y) -> void {
+		axpy(a, x, euclidean_vector_view(std::span<double>(y.begin(), y.end())));
+	}
+
+	// AXPBY
+	template<typename T>
+	auto axpby(double a, basic_euclidean_vector_view<T> x, double b, euclidean_vector_view y)
+	   -> void {
+		axpby(a, std::span<double const>(x.magnitudes()), b, y.magnitudes());
+	}
+
+	inline auto axpby(double a, euclidean_vector const& x, double b, euclidean_vector_view y)
+	   -> void {
+		axpby(a, const_euclidean_vector_view(x), b, y);
+	}
+
+	template<typename T>
+	auto axpby(double a, basic_euclidean_vector_view<T> x, double b, euclidean_vector& y) -> void {
+		axpby(a, x, b, euclidean_vector_view(std::span<double>(y.begin(), y.end())));
+	}
+
+	// DOT AND NORMS
+	// Unlike the euclidean_vector overload, these leave a vector's norm cache as it was.
+	template<typename T, typename U>
+	auto dot_and_norms(basic_euclidean_vector_view<T> x, basic_euclidean_vector_view<U> y)
+	   -> dot_and_norms_result {
+		return dot_and_norms(std::span<double const>(x.magnitudes()),
+		                     std::span<double const>(y.magnitudes()));
+	}
+
+	template<typename T>
+	auto dot_and_norms(basic_euclidean_vector_view<T> x, euclidean_vector const& y)
+	   -> dot_and_norms_result {
+		return dot_and_norms(x, const_euclidean_vector_view(y));
+	}
+
+	template<typename T>
+	auto dot_and_norms(euclidean_vector const& x, basic_euclidean_vector_view<T> y)
+	   -> dot_and_norms_result {
+		return dot_and_norms(const_euclidean_vector_view(x), y);
+	}
+
+	// COSINE SIMILARITY
+	template<typename T, typename U>
+	auto cosine_similarity(basic_euclidean_vector_view<T> x, basic_euclidean_vector_view<U> y)
+	   -> double {
+		return cosine_similarity(std::span<double const>(x.magnitudes()),
+		                         std::span<double const>(y.magnitudes()));
+	}
+
+	template<typename T>
+	auto cosine_similarity(basic_euclidean_vector_view<T> x, euclidean_vector const& y) -> double {
+		return cosine_similarity(x, const_euclidean_vector_view(y));
+	}
+
+	template<typename T>
+	auto cosine_similarity(euclidean_vector const& x, basic_euclidean_vector_view<T> y) -> double {
+		return cosine_similarity(const_euclidean_vector_view(x), y);
+	}
+} // namespace comp6771
+
+#endif // COMP6771_EUCLIDEAN_VECTOR_VIEW_HPP
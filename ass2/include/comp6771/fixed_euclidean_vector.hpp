@@ -0,0 +1,261 @@
+#ifndef COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace comp6771 {
+	// A euclidean vector whose dimension is part of its type. Magnitudes live in a std::array, so
+	// there is no allocation, no runtime dimension check between two fixed vectors, and every
+	// operation is constexpr with a loop bound the compiler can unroll.
+	template<std::size_t N>
+	class fixed_euclidean_vector {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		// DEFAULT CONSTRUCTOR
+		constexpr fixed_euclidean_vector() = default;
+
+		// CONSTRUCTOR
+		constexpr explicit fixed_euclidean_vector(double mag) {
+			magnitudes_.fill(mag);
+		}
+
+		// MAGNITUDES CONSTRUCTOR
+		template<typename... Ts>
+		requires(sizeof...(Ts) == N and N != 1 and (std::convertible_to<Ts, double> and ...))
+		constexpr fixed_euclidean_vector(Ts... mags) // NOLINT(google-explicit-constructor)
+		: magnitudes_{static_cast<double>(mags)...} {}
+
+		// ARRAY CONSTRUCTOR
+		constexpr explicit fixed_euclidean_vector(std::array<double, N> const& mags)
+		: magnitudes_{mags} {}
+
+		// DYNAMIC CONSTRUCTOR
+		explicit fixed_euclidean_vector(euclidean_vector const& ev) {
+			euclidean_vector::check_dimensions(dimensions(), ev.dimensions());
+			std::copy_n(ev.data(), N, magnitudes_.begin());
+		}
+
+		// =========================== OPERATORS ===========================
+		// SUBSCRIPT OPERATOR
+		constexpr auto operator[](std::size_t i) -> double& {
+			return magnitudes_[i];
+		}
+
+		// CONST SUBSCRIPT OPERATOR
+		constexpr auto operator[](std::size_t i) const -> double {
+			return magnitudes_[i];
+		}
+
+		// UNARY PLUS OPERATOR
+		constexpr auto operator+() const -> fixed_euclidean_vector {
+			return *this;
+		}
+
+		// NEGATION OPERATOR
+		constexpr auto operator-() const -> fixed_euclidean_vector {
+			return *this * -1.0;
+		}
+
+		// COMPOUND ADDITION OPERATOR
+		constexpr auto operator+=(fixed_euclidean_vector const& fv) -> fixed_euclidean_vector& {
+			std::transform(begin(), end(), fv.begin(), begin(), std::plus<>{});
+			return *this;
+		}
+
+		// COMPOUND SUBTRACTION OPERATOR
+		constexpr auto operator-=(fixed_euclidean_vector const& fv) -> fixed_euclidean_vector& {
+			std::transform(begin(), end(), fv.begin(), begin(), std::minus<>{});
+			return *this;
+		}
+
+		// COMPOUND MULTIPLICATION OPERATOR
+		constexpr auto operator*=(double d) -> fixed_euclidean_vector& {
+			std::for_each (begin(), end(), [d](double& a) { a *= d; });
+			return *this;
+		}
+
+		// COMPOUND DIVISION OPERATOR
+		constexpr auto operator/=(double d) -> fixed_euclidean_vector& {
+			if (d == 0.0) {
+				const auto* err_msg = "Invalid vector division by 0";
+				throw euclidean_vector_error(err_msg);
+			}
+			std::for_each (begin(), end(), [d](double& a) { a /= d; });
+			return *this;
+		}
+
+		// DYNAMIC TYPE CONVERSION OPERATOR
+		explicit operator euclidean_vector() const {
+			auto ev = euclidean_vector(dimensions());
+			std::copy(begin(), end(), ev.begin());
+			return ev;
+		}
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		// AT METHOD
+		constexpr auto at(int i) -> double& {
+			check_index(i);
+			return magnitudes_[itos(i)];
+		}
+
+		// AT CONST METHOD
+		[[nodiscard]] constexpr auto at(int i) const -> double {
+			check_index(i);
+			return magnitudes_[itos(i)];
+		}
+
+		// DIMENSIONS METHOD
+		[[nodiscard]] static constexpr auto dimensions() -> int {
+			return static_cast<int>(N);
+		}
+
+		// DATA METHOD
+		[[nodiscard]] constexpr auto data() const -> double const* {
+			return magnitudes_.data();
+		}
+
+		// BEGIN METHOD
+		constexpr auto begin() -> typename std::array<double, N>::iterator {
+			return magnitudes_.begin();
+		}
+
+		[[nodiscard]] constexpr auto begin() const -> typename std::array<double, N>::const_iterator {
+			return magnitudes_.begin();
+		}
+
+		// END METHOD
+		constexpr auto end() -> typename std::array<double, N>::iterator {
+			return magnitudes_.end();
+		}
+
+		[[nodiscard]] constexpr auto end() const -> typename std::array<double, N>::const_iterator {
+			return magnitudes_.end();
+		}
+
+		// =========================== FRIENDS ===========================
+		// EQUAL FRIEND
+		friend constexpr auto operator==(fixed_euclidean_vector const& fv1,
+		                                 fixed_euclidean_vector const& fv2) -> bool = default;
+
+		// ADDITION FRIEND
+		friend constexpr auto operator+(fixed_euclidean_vector fv1, fixed_euclidean_vector const& fv2)
+		   -> fixed_euclidean_vector {
+			return fv1 += fv2;
+		}
+
+		// SUBTRACTION FRIEND
+		friend constexpr auto operator-(fixed_euclidean_vector fv1, fixed_euclidean_vector const& fv2)
+		   -> fixed_euclidean_vector {
+			return fv1 -= fv2;
+		}
+
+		// MULTIPLICATION FRIENDS
+		friend constexpr auto operator*(fixed_euclidean_vector fv, double d)
+		   -> fixed_euclidean_vector {
+			return fv *= d;
+		}
+
+		friend constexpr auto operator*(double d, fixed_euclidean_vector fv)
+		   -> fixed_euclidean_vector {
+			return fv *= d;
+		}
+
+		// DIVISION FRIEND
+		friend constexpr auto operator/(fixed_euclidean_vector fv, double d)
+		   -> fixed_euclidean_vector {
+			return fv /= d;
+		}
+
+		// OUTPUT STREAM FRIEND
+		friend auto operator<<(std::ostream& os, fixed_euclidean_vector const& fv) -> std::ostream& {
+			os << '[';
+			auto separator = "";
+			for (auto const d : fv.magnitudes_) {
+				os << std::exchange(separator, " ") << d;
+			}
+			return os << ']';
+		}
+
+	private:
+		constexpr static auto check_index(int i) -> void {
+			if (i < 0 or i >= dimensions()) {
+				auto err_msg =
+				   "Index " + std::to_string(i) + " is not valid for this euclidean_vector object";
+				throw euclidean_vector_error(err_msg);
+			}
+		}
+
+		std::array<double, N> magnitudes_{};
+	};
+
+	template<typename... Ts>
+	fixed_euclidean_vector(Ts...) -> fixed_euclidean_vector<sizeof...(Ts)>;
+
+	// =========================== UTILITY ===========================
+	// CONSTEXPR SQUARE ROOT
+	// std::sqrt isn't constexpr until C++26. Newton's method started above the root decreases
+	// monotonically, so it stops as soon as an iteration fails to improve. Infinity and NaN are
+	// their own square roots and would never converge.
+	constexpr auto constexpr_sqrt(double x) -> double {
+		if (not std::is_constant_evaluated()) {
+			return std::sqrt(x);
+		}
+		if (not(x < std::numeric_limits<double>::infinity())) {
+			return x;
+		}
+		if (x <= 0.0) {
+			return 0.0;
+		}
+		auto current = x < 1.0 ? 1.0 : x;
+		while (true) {
+			auto const next = 0.5 * (current + x / current);
+			if (next >= current) {
+				return current;
+			}
+			current = next;
+		}
+	}
+
+	// DOT PRODUCT
+	template<std::size_t N>
+	constexpr auto dot(fixed_euclidean_vector<N> const& x, fixed_euclidean_vector<N> const& y)
+	   -> double {
+		return std::inner_product(x.begin(), x.end(), y.begin(), 0.0);
+	}
+
+	// EUCLIDEAN NORMAL
+	template<std::size_t N>
+	constexpr auto euclidean_norm(fixed_euclidean_vector<N> const& v) -> double {
+		return constexpr_sqrt(dot(v, v));
+	}
+
+	// UNIT
+	template<std::size_t N>
+	constexpr auto unit(fixed_euclidean_vector<N> const& v) -> fixed_euclidean_vector<N> {
+		if (v.dimensions() == 0) {
+			const auto* err_msg = "euclidean_vector with no dimensions does not have a unit vector";
+			throw euclidean_vector_error(err_msg);
+		}
+		auto const norm = euclidean_norm(v);
+		if (norm == 0.0) {
+			const auto* err_msg = "euclidean_vector with zero euclidean normal does not have a unit "
+			                      "vector";
+			throw euclidean_vector_error(err_msg);
+		}
+		return v / norm;
+	}
+} // namespace comp6771
+
+#endif // COMP6771_FIXED_EUCLIDEAN_VECTOR_HPP
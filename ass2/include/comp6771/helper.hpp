@@ -1,16 +1,21 @@
 #ifndef Z5265106_HELPER_HPP
 #define Z5265106_HELPER_HPP
 
-#include <memory>
+#include "magnitude_storage.hpp"
+#include <cstddef>
+#include <memory_resource>
 
 inline auto itos(int i) -> std::size_t {
 	return static_cast<std::size_t>(i);
 }
 
-// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-inline auto prep_mag(int i) -> std::unique_ptr<double[]> {
-	// NOLINTNEXTLINE(modernize-avoid-c-arrays)
-	return std::make_unique<double[]>(itos(i));
+// Storage for i magnitudes that the calling constructor is about to write every one of, so it
+// is left uninitialised rather than zeroed first.
+template<typename T = double>
+inline auto prep_mag(int i,
+                     std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+   -> comp6771::basic_magnitude_storage<T> {
+	return comp6771::basic_magnitude_storage<T>::for_overwrite(itos(i), resource);
 }
 
 #endif // Z5265106_HELPER_HPP
\ No newline at end of file
@@ -0,0 +1,156 @@
+#ifndef COMP6771_HNSW_INDEX_HPP
+#define COMP6771_HNSW_INDEX_HPP
+
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/knn_index.hpp"
+#include "comp6771/parallel.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	struct hnsw_parameters {
+		// Links kept per vector on each layer above the bottom one; the bottom layer keeps 2 * m.
+		int m = 16;
+		// Candidates considered while linking a new vector. Larger builds slower, better graphs.
+		int ef_construction = 200;
+		// Seeds the random layer assigned to each inserted vector.
+		std::uint64_t seed = 42;
+	};
+
+	// Approximate nearest-neighbour search with a hierarchical navigable small world graph
+	// (Malkov and Yashunin, 2018). Each vector is linked to its near neighbours on the bottom layer
+	// and, with exponentially falling probability, on sparser layers above it. A search descends
+	// greedily from the top layer, then explores the bottom layer keeping the `ef` best candidates:
+	// larger `ef` trades speed for recall.
+	//
+	// Distances follow knn_index: euclidean for l2 and one minus the cosine similarity for cosine.
+	// Cosine indices store their vectors normalised.
+	//
+	// Inserting a batch under a parallel_policy links its vectors concurrently. Levels are drawn
+	// up front, in order, from the seed; which links each vector ends up with can depend on thread
+	// timing. Searches may run concurrently with each other but not with an insert.
+	class hnsw_index {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		explicit hnsw_index(int dimensions,
+		                    knn_metric metric = knn_metric::l2,
+		                    hnsw_parameters parameters = {});
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		[[nodiscard]] auto size() const -> int {
+			return static_cast<int>(nodes_.size());
+		}
+
+		[[nodiscard]] auto dimensions() const -> int {
+			return static_cast<int>(dimensions_);
+		}
+
+		[[nodiscard]] auto metric() const -> knn_metric {
+			return metric_;
+		}
+
+		[[nodiscard]] auto parameters() const -> hnsw_parameters const& {
+			return parameters_;
+		}
+
+		// INSERT METHOD
+		// Adds one vector and returns its index, which is its position in insertion order.
+		auto insert(const_euclidean_vector_view v) -> int;
+		// Adds every row of `batch`, in order.
+		auto insert(euclidean_vector_batch const& batch) -> void;
+		auto insert(parallel_policy const& policy, euclidean_vector_batch const& batch) -> void;
+
+		// SEARCH METHOD
+		// The (approximately) k nearest vectors to `query`, nearest first. `ef` below k is raised to
+		// k.
+		[[nodiscard]] auto search(const_euclidean_vector_view query, int k, int ef) const
+		   -> std::vector<knn_neighbour>;
+		[[nodiscard]] auto search(parallel_policy const& policy,
+		                          euclidean_vector_batch const& queries,
+		                          int k,
+		                          int ef) const -> std::vector<std::vector<knn_neighbour>>;
+
+		// LINKS METHOD
+		// The neighbours of vector `id` on `layer`, or none above its level. Like search, this may
+		// not run concurrently with an insert.
+		[[nodiscard]] auto links(int id, int layer) const -> std::vector<int>;
+
+		// SAVE METHOD
+		// Writes the vectors and the graph, little-endian, so load() can skip rebuilding it.
+		auto save(std::filesystem::path const& path) const -> void;
+
+		// LOAD METHOD
+		static auto load(std::filesystem::path const& path) -> hnsw_index;
+
+	private:
+		using id_type = std::uint32_t;
+
+		struct candidate {
+			double distance;
+			id_type id;
+
+			friend auto operator<=>(candidate const&, candidate const&) = default;
+		};
+
+		struct node {
+			int level = 0;
+			// links[l] are the neighbours on layer l, for l <= level.
+			std::vector<std::vector<id_type>> links;
+		};
+
+		// A vector in the form distances are computed from: normalised for cosine, with its sum of
+		// squares.
+		struct prepared_vector {
+			std::vector<double> magnitudes;
+			double squares;
+		};
+
+		auto prepare(std::span<double const> v) const -> prepared_vector;
+		auto reserve(std::span<double const> v) -> id_type;
+		auto link(id_type id, bool concurrent) -> void;
+		auto merge_links(id_type id, int layer, std::vector<id_type> const& chosen) -> void;
+		auto max_links(int layer) const -> std::size_t;
+
+		auto magnitudes(id_type id) const -> double const*;
+		auto distance(double const* q, double q_squares, id_type id) const -> double;
+		auto neighbours(id_type id, int layer, bool concurrent, std::vector<id_type>& scratch) const
+		   -> std::span<id_type const>;
+
+		auto greedy(double const* q, double q_squares, candidate entry, int layer, bool concurrent)
+		   const -> candidate;
+		auto search_layer(double const* q,
+		                  double q_squares,
+		                  std::vector<candidate> const& entries,
+		                  std::size_t ef,
+		                  int layer,
+		                  bool concurrent) const -> std::vector<candidate>;
+		auto select(std::vector<candidate> const& sorted, std::size_t m) const
+		   -> std::vector<id_type>;
+
+		std::size_t dimensions_;
+		knn_metric metric_;
+		hnsw_parameters parameters_;
+		// Magnitudes of every vector, row-major, and each one's sum of squares.
+		std::vector<double> vectors_;
+		std::vector<double> squares_;
+		std::vector<node> nodes_;
+		// One lock per node for concurrent inserts; a deque so it can grow without moving them.
+		mutable std::deque<std::mutex> locks_;
+		// Guards entry_ and top_level_ during concurrent inserts.
+		std::unique_ptr<std::mutex> entry_lock_ = std::make_unique<std::mutex>();
+		static constexpr auto no_entry = ~id_type{0};
+		id_type entry_ = no_entry;
+		int top_level_ = -1;
+		std::mt19937_64 levels_;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_HNSW_INDEX_HPP
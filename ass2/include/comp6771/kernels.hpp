@@ -0,0 +1,70 @@
+#ifndef COMP6771_KERNELS_HPP
+#define COMP6771_KERNELS_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace comp6771::kernels {
+	// One table of element-wise and reduction kernels over contiguous doubles is compiled per
+	// instruction set. The widest table the running CPU supports is picked once, on first use.
+	// The three sums a cosine similarity needs, gathered in one pass.
+	struct dot_squares {
+		double dot;
+		double x_squares;
+		double y_squares;
+	};
+
+	// The shape of the register tile the matrix-multiply kernel accumulates: gemm_rows rows of
+	// the product by gemm_cols columns.
+	inline constexpr auto gemm_rows = std::size_t{4};
+	inline constexpr auto gemm_cols = std::size_t{8};
+
+	struct kernel_table {
+		char const* name;
+		// y[i] += x[i]
+		void (*add)(double* y, double const* x, std::size_t n);
+		// y[i] *= a
+		void (*scale)(double* y, double a, std::size_t n);
+		// y[i] /= d
+		void (*divide)(double* y, double d, std::size_t n);
+		// sum of x[i] * y[i]
+		auto (*dot)(double const* x, double const* y, std::size_t n) -> double;
+		// sum of x[i] * x[i]
+		auto (*sum_squares)(double const* x, std::size_t n) -> double;
+		// y[i] += a * x[i]
+		void (*axpy)(double* y, double a, double const* x, std::size_t n);
+		// y[i] = a * x[i] + b * y[i]
+		void (*axpby)(double* y, double a, double const* x, double b, std::size_t n);
+		// sums of x[i] * y[i], x[i] * x[i] and y[i] * y[i]
+		auto (*dot_and_squares)(double const* x, double const* y, std::size_t n) -> dot_squares;
+		// out[r] = sum of x[i] * rows[r * stride + i], for the four rows r sharing each load of x
+		void (*dot4)(double const* x,
+		             double const* rows,
+		             std::size_t stride,
+		             std::size_t n,
+		             double* out);
+		// c[r * ldc + j] += sum of a[p * gemm_rows + r] * b[p * gemm_cols + j] over p < k: one
+		// register tile of a matrix product, with `a` packed a tile column at a time and `b` a tile
+		// row at a time
+		void (*gemm_tile)(std::size_t k,
+		                  double const* a,
+		                  double const* b,
+		                  double* c,
+		                  std::size_t ldc);
+		// sum of |x[i] - y[i]|
+		auto (*l1_distance)(double const* x, double const* y, std::size_t n) -> double;
+		// sum of (x[i] - y[i])²
+		auto (*squared_distance)(double const* x, double const* y, std::size_t n) -> double;
+		// largest |x[i] - y[i]|, or 0 when n is 0, or NaN when any difference is NaN
+		auto (*linf_distance)(double const* x, double const* y, std::size_t n) -> double;
+	};
+
+	// ACTIVE KERNELS
+	auto active() -> kernel_table const&;
+
+	// SUPPORTED KERNELS
+	// Every table the running CPU can execute, narrowest first. The scalar table is always present.
+	auto supported() -> std::vector<kernel_table const*>;
+} // namespace comp6771::kernels
+
+#endif // COMP6771_KERNELS_HPP
@@ -0,0 +1,70 @@
+#ifndef COMP6771_KMEANS_HPP
+#define COMP6771_KMEANS_HPP
+
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/parallel.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace comp6771 {
+	// How the first centroids are chosen. kmeans_plus_plus picks each next centroid with
+	// probability proportional to its squared distance from the nearest one already chosen;
+	// random picks k distinct vectors uniformly.
+	enum class kmeans_init { kmeans_plus_plus, random };
+
+	struct kmeans_options {
+		// Lloyd iterations, or mini-batches when mini_batch is set.
+		int max_iterations = 100;
+		// Iterations stop early once no centroid moves farther than this, or (for full Lloyd
+		// iterations) once no vector changes cluster.
+		double tolerance = 1e-4;
+		// Everything random is drawn from a generator seeded with this, so the same data, options
+		// and seed always give the same clustering.
+		std::uint64_t seed = 0;
+		// 0 for full Lloyd iterations over every vector. Otherwise each iteration samples this many
+		// vectors and moves the centroids towards them (Sculley's mini-batch k-means).
+		int mini_batch = 0;
+		kmeans_init init = kmeans_init::kmeans_plus_plus;
+	};
+
+	struct kmeans_result {
+		// k rows of the data's dimensions.
+		euclidean_matrix centroids;
+		// The nearest centroid to each vector, with ties going to the lower index.
+		std::vector<int> labels;
+		// The sum of squared distances from each vector to its centroid.
+		double inertia;
+		int iterations;
+		bool converged;
+	};
+
+	// K-MEANS
+	// Clusters the rows of `data` around k centroids.
+	//
+	// Each iteration scores blocks of vectors against every centroid with one matrix product
+	// (|x - c|² = |x|² - 2 x·c + |c|², with the |x|² computed once), and sums each cluster over
+	// fixed blocks of vectors that are combined in block order. The blocks depend only on the
+	// number of vectors, so the result is the same however many threads run. The centroid, label,
+	// scoring and partial-sum buffers are allocated once and reused by every iteration.
+	//
+	// A cluster left empty is given the vector farthest from its centroid. Column-major batches
+	// are read through a row-major copy.
+	auto kmeans(euclidean_vector_batch const& data, int k, kmeans_options const& options = {})
+	   -> kmeans_result;
+	// Blocks of vectors are spread over the policy's thread pool.
+	auto kmeans(parallel_policy const& policy,
+	            euclidean_vector_batch const& data,
+	            int k,
+	            kmeans_options const& options = {}) -> kmeans_result;
+
+	// NEAREST CENTROIDS
+	// The label kmeans would give each row of `data`, for vectors it was not fitted to.
+	auto nearest_centroids(euclidean_matrix const& centroids, euclidean_vector_batch const& data)
+	   -> std::vector<int>;
+	auto nearest_centroids(parallel_policy const& policy,
+	                       euclidean_matrix const& centroids,
+	                       euclidean_vector_batch const& data) -> std::vector<int>;
+} // namespace comp6771
+
+#endif // COMP6771_KMEANS_HPP
@@ -0,0 +1,84 @@
+#ifndef COMP6771_KNN_INDEX_HPP
+#define COMP6771_KNN_INDEX_HPP
+
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/parallel.hpp"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	// How a k-NN search measures distance. l2 is the euclidean distance; cosine is one minus the
+	// cosine similarity, so that smaller is nearer for both.
+	enum class knn_metric { l2, cosine };
+
+	struct knn_neighbour {
+		int index;
+		double distance;
+
+		friend auto operator==(knn_neighbour const&, knn_neighbour const&) -> bool = default;
+	};
+
+	// Exact (brute force) nearest-neighbour search over a fixed set of vectors.
+	//
+	// Every query is compared against every vector, but the work is arranged to stay in cache: the
+	// data is walked in blocks of rows small enough to stay in L2, and each block is compared
+	// against a group of queries before moving on. Each l2 comparison is one pass of the exact
+	// squared_distance kernel, so distances match distances(distance_metric::squared_l2, ...).
+	// Cosine norms are computed once, up front, so each cosine comparison is a single dot product.
+	// Each query keeps its own bounded top-k heap.
+	//
+	// Neighbours come back nearest first, with ties broken by the lower index, so results are
+	// identical however many threads run the search. A vector with zero norm is at cosine
+	// distance 1 from everything; a query with zero norm has no cosine neighbours and throws.
+	class knn_index {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		// Takes ownership of the vectors to search; column-major batches are rearranged row-major.
+		explicit knn_index(euclidean_vector_batch data, knn_metric metric = knn_metric::l2);
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		[[nodiscard]] auto size() const -> int {
+			return data_.size();
+		}
+
+		[[nodiscard]] auto dimensions() const -> int {
+			return data_.dimensions();
+		}
+
+		[[nodiscard]] auto metric() const -> knn_metric {
+			return metric_;
+		}
+
+		[[nodiscard]] auto data() const -> euclidean_vector_batch const& {
+			return data_;
+		}
+
+		// SEARCH METHOD
+		// The k nearest vectors to `query`, or all of them if there are fewer than k.
+		[[nodiscard]] auto search(const_euclidean_vector_view query, int k) const
+		   -> std::vector<knn_neighbour>;
+
+		// BATCHED SEARCH METHOD
+		// One result per row of `queries`, in the same order.
+		[[nodiscard]] auto search(euclidean_vector_batch const& queries, int k) const
+		   -> std::vector<std::vector<knn_neighbour>>;
+		// Groups of queries are spread over the policy's thread pool.
+		[[nodiscard]] auto search(parallel_policy const& policy,
+		                          euclidean_vector_batch const& queries,
+		                          int k) const -> std::vector<std::vector<knn_neighbour>>;
+
+	private:
+		auto search_block(std::span<double const> queries,
+		                  std::size_t k,
+		                  std::span<std::vector<knn_neighbour>> out) const -> void;
+
+		euclidean_vector_batch data_;
+		knn_metric metric_;
+		// Norms of the rows, for cosine only.
+		std::vector<double> norms_;
+	};
+} // namespace comp6771
+
+#endif // COMP6771_KNN_INDEX_HPP
@@ -0,0 +1,288 @@
+#ifndef COMP6771_MAGNITUDE_STORAGE_HPP
+#define COMP6771_MAGNITUDE_STORAGE_HPP
+
+#include "comp6771/counters.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Vectors with at most this many dimensions keep their magnitudes inline and never touch the
+// allocator. Must be defined identically in every translation unit.
+#ifndef COMP6771_EV_INLINE_DIMENSIONS
+#	define COMP6771_EV_INLINE_DIMENSIONS 16
+#endif
+
+namespace comp6771 {
+	// Owning buffer of magnitudes with a small-buffer optimisation. Buffers above the inline
+	// capacity come from a std::pmr::memory_resource and follow the std::pmr propagation rules:
+	// copies use the default resource unless told otherwise, moves keep the source's resource, and
+	// assignment never changes the target's resource.
+	//
+	// A buffer can also be adopted from a std::vector, which keeps owning it. Such a buffer
+	// belongs to no resource, so like an inline one it moves between storages whatever their
+	// resources, and it goes back to a std::vector without a copy.
+	//
+	// Heap buffers start on a cache line and are padded to whole cache lines, which is a whole
+	// number of the widest (AVX-512) SIMD registers: aligned full-width loads never split a line
+	// or run into another buffer. Inline and adopted buffers keep their natural alignment.
+	//
+	// Like std::unique_ptr<T[]>, constness is shallow: a const storage still hands out mutable
+	// elements.
+	template<typename T>
+	requires std::is_floating_point_v<T>
+	class basic_magnitude_storage {
+	public:
+		static constexpr auto inline_capacity = std::size_t{COMP6771_EV_INLINE_DIMENSIONS};
+		static constexpr auto alignment = std::size_t{64};
+
+		basic_magnitude_storage() noexcept = default;
+
+		explicit basic_magnitude_storage(std::pmr::memory_resource* resource) noexcept
+		: resource_{resource} {}
+
+		explicit basic_magnitude_storage(std::size_t n)
+		: basic_magnitude_storage(n, std::pmr::get_default_resource()) {}
+
+		// Value-initialises n magnitudes.
+		explicit basic_magnitude_storage(std::size_t n, std::pmr::memory_resource* resource)
+		: basic_magnitude_storage(n, resource, overwrite_tag{}) {
+			std::fill_n(data_, n, T{0});
+		}
+
+		// Makes room for n magnitudes without initialising them, for a caller about to overwrite
+		// every one: like std::make_unique_for_overwrite, it saves writing the buffer twice.
+		[[nodiscard]] static auto
+		for_overwrite(std::size_t n,
+		              std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		   -> basic_magnitude_storage {
+			return basic_magnitude_storage(n, resource, overwrite_tag{});
+		}
+
+		// Takes over the vector's buffer as is.
+		explicit basic_magnitude_storage(
+		   std::vector<T>&& magnitudes,
+		   std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+		: resource_{resource} {
+			if (not magnitudes.empty()) {
+				adopted_ = std::move(magnitudes);
+				data_ = adopted_.data();
+				size_ = adopted_.size();
+				capacity_ = adopted_.size();
+			}
+		}
+
+		basic_magnitude_storage(basic_magnitude_storage const& other)
+		: basic_magnitude_storage(other, std::pmr::get_default_resource()) {}
+
+		basic_magnitude_storage(basic_magnitude_storage const& other,
+		                        std::pmr::memory_resource* resource)
+		: resource_{resource} {
+			this->allocate(other.size_);
+			std::copy_n(other.data_, other.size_, data_);
+		}
+
+		basic_magnitude_storage(basic_magnitude_storage&& other) noexcept
+		: resource_{other.resource_} {
+			this->steal(other);
+		}
+
+		basic_magnitude_storage(basic_magnitude_storage&& other, std::pmr::memory_resource* resource)
+		: resource_{resource} {
+			if (other.is_inline() or other.is_adopted() or *resource_ == *other.resource_) {
+				this->steal(other);
+			}
+			else {
+				this->allocate(other.size_);
+				std::copy_n(other.data_, other.size_, data_);
+			}
+		}
+
+		auto operator=(basic_magnitude_storage const& other) -> basic_magnitude_storage& {
+			if (this != &other) {
+				this->resize_for_overwrite(other.size_);
+				std::copy_n(other.data_, other.size_, data_);
+			}
+			return *this;
+		}
+
+		// Buffers from a different resource can't be adopted, so their elements are copied into one
+		// from this resource. Running out of memory there terminates rather than leaving a
+		// half-moved vector behind.
+		auto operator=(basic_magnitude_storage&& other) noexcept -> basic_magnitude_storage& {
+			if (this == &other) {
+				return *this;
+			}
+			if (other.is_inline() or other.is_adopted() or *resource_ == *other.resource_) {
+				this->release();
+				this->steal(other);
+			}
+			else {
+				this->resize_for_overwrite(other.size_);
+				std::copy_n(other.data_, other.size_, data_);
+				other.release();
+			}
+			return *this;
+		}
+
+		~basic_magnitude_storage() {
+			this->release();
+		}
+
+		[[nodiscard]] auto get() const noexcept -> T* {
+			return data_;
+		}
+
+		auto operator[](std::size_t i) const noexcept -> T& {
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+			return data_[i];
+		}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+
+		[[nodiscard]] auto is_inline() const noexcept -> bool {
+			return capacity_ == 0;
+		}
+
+		[[nodiscard]] auto is_adopted() const noexcept -> bool {
+			return not adopted_.empty();
+		}
+
+		[[nodiscard]] auto resource() const noexcept -> std::pmr::memory_resource* {
+			return resource_;
+		}
+
+		// Hands the magnitudes over as a std::vector and leaves the storage empty. An adopted buffer
+		// goes back as is; any other is copied once.
+		[[nodiscard]] auto release_to_vector() -> std::vector<T> {
+			if (not this->is_adopted()) {
+				auto const magnitudes = std::span(data_, size_);
+				auto v = std::vector<T>(magnitudes.begin(), magnitudes.end());
+				this->release();
+				return v;
+			}
+			auto v = std::exchange(adopted_, {});
+			// Shrinking to the magnitudes in use never reallocates.
+			v.resize(size_);
+			this->reset();
+			return v;
+		}
+
+		// Makes room for n magnitudes, keeping the current buffer when it is big enough. The contents
+		// are unspecified afterwards and must be overwritten.
+		auto resize_for_overwrite(std::size_t n) -> void {
+			if (n > (this->is_inline() ? inline_capacity : capacity_)) {
+				this->release();
+				this->allocate(n);
+			}
+			size_ = n;
+		}
+
+	private:
+		struct overwrite_tag {};
+
+		basic_magnitude_storage(std::size_t n, std::pmr::memory_resource* resource, overwrite_tag)
+		: resource_{resource} {
+			this->allocate(n);
+		}
+
+		// n magnitudes rounded up to whole cache lines.
+		static auto padded(std::size_t n) noexcept -> std::size_t {
+			constexpr auto per_line = alignment / sizeof(T);
+			return (n + per_line - 1) / per_line * per_line;
+		}
+
+		// Resources are asked for blocks one cache line bigger than the buffer, at the alignment
+		// they give for free, and the buffer is aligned by hand inside. An over-aligned request
+		// takes general-purpose allocators off their fast path, which doubled the cost of building
+		// a vector of a hundred dimensions. The block's address is kept just before the buffer,
+		// always at least one max_align_t into the block.
+		static constexpr auto block_alignment = alignof(std::max_align_t);
+		static_assert(block_alignment >= sizeof(std::byte*));
+
+		static auto block_bytes(std::size_t capacity) noexcept -> std::size_t {
+			return capacity * sizeof(T) + alignment;
+		}
+
+		// Points data_ at a buffer of n uninitialised magnitudes. Only called on empty storage.
+		auto allocate(std::size_t n) -> void {
+			if (n > inline_capacity) {
+				capacity_ = padded(n);
+				auto* const block = static_cast<std::byte*>(
+				   resource_->allocate(block_bytes(capacity_), block_alignment));
+				auto const offset = alignment - reinterpret_cast<std::uintptr_t>(block) % alignment;
+				// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+				auto* const buffer = block + offset;
+				std::memcpy(buffer - sizeof(block), &block, sizeof(block));
+				// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+				data_ = static_cast<T*>(static_cast<void*>(buffer));
+				ev_count_allocation(capacity_ * sizeof(T));
+			}
+			size_ = n;
+		}
+
+		auto deallocate() noexcept -> void {
+			auto* const buffer = static_cast<std::byte*>(static_cast<void*>(data_));
+			auto* block = static_cast<std::byte*>(nullptr);
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+			std::memcpy(&block, buffer - sizeof(block), sizeof(block));
+			resource_->deallocate(block, block_bytes(capacity_), block_alignment);
+		}
+
+		auto release() noexcept -> void {
+			if (this->is_adopted()) {
+				adopted_ = std::vector<T>();
+			}
+			else if (not this->is_inline()) {
+				this->deallocate();
+			}
+			this->reset();
+		}
+
+		// Points back at the (empty) inline buffer without freeing anything.
+		auto reset() noexcept -> void {
+			data_ = inline_.data();
+			size_ = 0;
+			capacity_ = 0;
+		}
+
+		// Heap buffers change hands; inline ones are copied. Either way `other` is left empty.
+		auto steal(basic_magnitude_storage& other) noexcept -> void {
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+			if (other.is_inline()) {
+				std::copy_n(other.inline_.data(), other.size_, inline_.data());
+				data_ = inline_.data();
+			}
+			else if (other.is_adopted()) {
+				// Moving a std::vector keeps its buffer where it is.
+				adopted_ = std::exchange(other.adopted_, {});
+				data_ = adopted_.data();
+			}
+			else {
+				data_ = other.data_;
+			}
+			other.reset();
+		}
+
+		std::array<T, inline_capacity> inline_;
+		T* data_ = inline_.data();
+		std::size_t size_ = 0;
+		std::size_t capacity_ = 0;
+		std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+		// Owns the buffer when it was adopted; empty otherwise.
+		std::vector<T> adopted_;
+	};
+
+	using magnitude_storage = basic_magnitude_storage<double>;
+} // namespace comp6771
+
+#endif // COMP6771_MAGNITUDE_STORAGE_HPP
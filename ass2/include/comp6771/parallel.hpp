@@ -0,0 +1,111 @@
+#ifndef COMP6771_PARALLEL_HPP
+#define COMP6771_PARALLEL_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace comp6771 {
+	// A fixed set of worker threads that run numbered tasks. The thread calling run() works
+	// alongside them, so a pool of size 1 has no workers and runs everything inline.
+	//
+	// run() blocks until every task has finished and rethrows the first exception any of them
+	// threw. Calls from different threads take turns; a task must not call run() on its own pool.
+	class thread_pool {
+	public:
+		// ========================== CONSTRUCTORS =========================
+		// CONSTRUCTOR
+		// `threads` counts the caller, and is at least 1.
+		explicit thread_pool(int threads = static_cast<int>(std::thread::hardware_concurrency()));
+		thread_pool(thread_pool const&) = delete;
+		thread_pool(thread_pool&&) = delete;
+		// DESTRUCTOR
+		~thread_pool();
+
+		// =========================== OPERATORS ===========================
+		auto operator=(thread_pool const&) -> thread_pool& = delete;
+		auto operator=(thread_pool&&) -> thread_pool& = delete;
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		// SIZE METHOD
+		[[nodiscard]] auto size() const -> int {
+			return static_cast<int>(workers_.size()) + 1;
+		}
+
+		// RUN METHOD
+		// Calls task(0), ..., task(tasks - 1), in no particular order or thread.
+		auto run(std::size_t tasks, std::function<void(std::size_t)> const& task) -> void;
+
+		// GLOBAL POOL
+		// One thread per hardware thread, created on first use.
+		static auto global() -> thread_pool&;
+
+	private:
+		auto work(std::stop_token const& stop) -> void;
+		auto drain(std::function<void(std::size_t)> const& task, std::size_t tasks) -> void;
+
+		std::mutex run_mutex_;
+		std::mutex mutex_;
+		std::condition_variable_any wake_;
+		std::condition_variable done_;
+		// Everything below is guarded by mutex_.
+		std::function<void(std::size_t)> const* task_ = nullptr;
+		std::size_t tasks_ = 0;
+		std::size_t next_ = 0;
+		std::size_t finished_ = 0;
+		std::size_t busy_ = 0;
+		std::size_t generation_ = 0;
+		std::exception_ptr error_;
+		// Declared last so the workers stop before the state they use is destroyed.
+		std::vector<std::jthread> workers_;
+	};
+
+	// ========================== PARALLEL POLICY ==========================
+	// Selects the parallel overloads below, run on `pool` or on thread_pool::global() when it is
+	// null.
+	struct parallel_policy {
+		thread_pool* pool = nullptr;
+	};
+
+	inline constexpr auto par = parallel_policy{};
+
+	// POOL OF
+	// The pool a policy's work runs on.
+	inline auto pool_of(parallel_policy const& policy) -> thread_pool& {
+		return policy.pool != nullptr ? *policy.pool : thread_pool::global();
+	}
+
+	// Work is split into chunks of this many magnitudes: two operands' worth fits in a per-core L2
+	// cache. Chunk boundaries depend only on the dimension, never on the number of threads, and
+	// partial results are combined in chunk order, so every result is reproducible run to run and
+	// across pool sizes. Vectors of at most one chunk take the serial path unchanged.
+	inline constexpr auto parallel_chunk = std::size_t{1} << 15;
+
+	// =========================== UTILITY ===========================
+	// EUCLIDEAN NORMAL
+	// Uses the vector's cached norm when it has one, but never fills the cache: the serial
+	// euclidean_norm alone decides what it holds.
+	auto euclidean_norm(parallel_policy const& policy, euclidean_vector const& v) -> double;
+	auto euclidean_norm(parallel_policy const& policy, std::span<double const> v) -> double;
+
+	// DOT PRODUCT
+	auto dot(parallel_policy const& policy, euclidean_vector const& x, euclidean_vector const& y)
+	   -> double;
+	auto dot(parallel_policy const& policy, std::span<double const> x, std::span<double const> y)
+	   -> double;
+
+	// ADD ASSIGN
+	// y += x
+	auto add_assign(parallel_policy const& policy, euclidean_vector& y, euclidean_vector const& x)
+	   -> void;
+	auto add_assign(parallel_policy const& policy, std::span<double> y, std::span<double const> x)
+	   -> void;
+} // namespace comp6771
+
+#endif // COMP6771_PARALLEL_HPP
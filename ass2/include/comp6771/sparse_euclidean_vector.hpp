@@ -0,0 +1,119 @@
+#ifndef COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
+#define COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
+
+#include "comp6771/euclidean_vector.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace comp6771 {
+	// A euclidean vector that stores only its nonzero magnitudes, as index/value pairs sorted by
+	// index. Memory and the cost of every operation except the conversions to and from a dense
+	// euclidean_vector scale with the number of nonzeros, not with the dimensions.
+	//
+	// Magnitudes that become exactly zero (a sum that cancels, scaling by zero) are dropped, so
+	// two vectors are equal exactly when their dense forms are.
+	class sparse_euclidean_vector {
+	public:
+		// ========================== TYPES =========================
+		// The indices and values are kept in std::pmr::vectors from this allocator's resource.
+		using allocator_type = std::pmr::polymorphic_allocator<double>;
+
+		// ========================== CONSTRUCTORS =========================
+		// DEFAULT CONSTRUCTOR
+		sparse_euclidean_vector() = default;
+		// SINGLE-ARGUMENT CONSTRUCTOR
+		// `dim` dimensions, all zero.
+		explicit sparse_euclidean_vector(int dim, allocator_type const& alloc = {});
+		// ENTRIES CONSTRUCTOR
+		// values[i] goes at indices[i]. The indices may come in any order; repeated ones are summed.
+		sparse_euclidean_vector(int dim,
+		                        std::span<int const> indices,
+		                        std::span<double const> values,
+		                        allocator_type const& alloc = {});
+		// DENSE CONSTRUCTOR
+		// Keeps the nonzero magnitudes of `dense`.
+		explicit sparse_euclidean_vector(euclidean_vector const& dense,
+		                                 allocator_type const& alloc = {});
+		explicit sparse_euclidean_vector(std::span<double const> dense,
+		                                 allocator_type const& alloc = {});
+
+		// =========================== OPERATORS ===========================
+		// COMPOUND ADDITION OPERATOR
+		auto operator+=(sparse_euclidean_vector const& sv) -> sparse_euclidean_vector&;
+		// COMPOUND SUBTRACTION OPERATOR
+		auto operator-=(sparse_euclidean_vector const& sv) -> sparse_euclidean_vector&;
+		// COMPOUND MULTIPLICATION OPERATOR
+		auto operator*=(double d) -> sparse_euclidean_vector&;
+		// COMPOUND DIVISION OPERATOR
+		auto operator/=(double d) -> sparse_euclidean_vector&;
+		// EUCLIDEAN VECTOR TYPE CONVERSION OPERATOR
+		explicit operator euclidean_vector() const;
+
+		// =========================== MEMBER FUNCTIONS ===========================
+		// AT METHOD
+		// Finds the magnitude by binary search; zero if it isn't stored.
+		[[nodiscard]] auto at(int i) const -> double;
+
+		// DIMENSIONS METHOD
+		[[nodiscard]] auto dimensions() const -> int {
+			return dimensions_;
+		}
+
+		// NONZEROS METHOD
+		[[nodiscard]] auto nonzeros() const -> int {
+			return static_cast<int>(indices_.size());
+		}
+
+		// GET ALLOCATOR METHOD
+		[[nodiscard]] auto get_allocator() const -> allocator_type {
+			return allocator_type(values_.get_allocator().resource());
+		}
+
+		// INDICES METHOD
+		// The indices of the nonzero magnitudes, ascending.
+		[[nodiscard]] auto indices() const -> std::span<int const> {
+			return indices_;
+		}
+
+		// VALUES METHOD
+		// values()[k] is the magnitude at indices()[k].
+		[[nodiscard]] auto values() const -> std::span<double const> {
+			return values_;
+		}
+
+		// =========================== FRIENDS ===========================
+		// EQUAL FRIEND
+		friend auto operator==(sparse_euclidean_vector const& sv1, sparse_euclidean_vector const& sv2)
+		   -> bool = default;
+
+	private:
+		auto check_index(int i) const -> void;
+		// this = this + sign * sv, merging the two sorted entry lists.
+		auto merge(sparse_euclidean_vector const& sv, double sign) -> void;
+		auto drop_zeros() -> void;
+
+		int dimensions_ = 0;
+		std::pmr::vector<int> indices_;
+		std::pmr::vector<double> values_;
+	};
+
+	// =========================== UTILITY ===========================
+	// EUCLIDEAN NORMAL
+	auto euclidean_norm(sparse_euclidean_vector const& sv) -> double;
+
+	// DOT PRODUCT
+	// Sparse·sparse walks both index lists together, galloping through the longer one when the
+	// other is much shorter. Sparse·dense only reads the dense magnitudes at the stored indices.
+	auto dot(sparse_euclidean_vector const& x, sparse_euclidean_vector const& y) -> double;
+	auto dot(sparse_euclidean_vector const& x, euclidean_vector const& y) -> double;
+	auto dot(euclidean_vector const& x, sparse_euclidean_vector const& y) -> double;
+	auto dot(sparse_euclidean_vector const& x, std::span<double const> y) -> double;
+
+	// AXPY
+	// y += a * x, touching only the magnitudes of y that x stores.
+	auto axpy(double a, sparse_euclidean_vector const& x, euclidean_vector& y) -> void;
+} // namespace comp6771
+
+#endif // COMP6771_SPARSE_EUCLIDEAN_VECTOR_HPP
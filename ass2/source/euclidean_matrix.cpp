@@ -0,0 +1,384 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The products index raw row-major buffers whose shapes are checked on entry.
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+namespace comp6771 {
+	namespace {
+		using kernels::gemm_cols;
+		using kernels::gemm_rows;
+
+		// Columns of x each pass over the rows of a matrix-vector product uses: 64 KiB, which stays
+		// in cache while every row streams past it.
+		constexpr auto gemv_block = std::size_t{1} << 13;
+		// Matrix product blocks, in elements. A packed kc by nc block of b (2 MiB) is shared by
+		// every thread; each packs its own mc by kc block of a (128 KiB, per-core L2) and walks it
+		// a register tile at a time against kc by gemm_cols slivers of b (16 KiB, L1).
+		constexpr auto kc = std::size_t{256};
+		constexpr auto mc = std::size_t{64};
+		constexpr auto nc = std::size_t{1024};
+		// Transposes move square tiles of this many rows and columns.
+		constexpr auto transpose_block = std::size_t{32};
+
+		auto round_up(std::size_t n, std::size_t multiple) -> std::size_t {
+			return (n + multiple - 1) / multiple * multiple;
+		}
+
+		auto shape(std::size_t rows, std::size_t cols) -> std::string {
+			return std::to_string(rows) + "x" + std::to_string(cols);
+		}
+
+		// A read-only operand of a matrix product, with strides so bᵀ reads straight out of b.
+		struct operand {
+			double const* data;
+			std::size_t row_stride;
+			std::size_t col_stride;
+
+			[[nodiscard]] auto operator()(std::size_t i, std::size_t j) const -> double {
+				return data[i * row_stride + j * col_stride];
+			}
+		};
+
+		// Rows [i0, i0 + m) and columns [p0, p0 + k) of `a`, a column of gemm_rows values at a time
+		// per register tile. Rows past the end of `a` are packed as zeros.
+		auto pack_a(operand a,
+		            std::size_t i0,
+		            std::size_t m,
+		            std::size_t p0,
+		            std::size_t k,
+		            double* out) -> void {
+			for (auto r0 = std::size_t{0}; r0 < m; r0 += gemm_rows) {
+				for (auto p = std::size_t{0}; p < k; ++p) {
+					for (auto r = r0; r < r0 + gemm_rows; ++r) {
+						*out++ = r < m ? a(i0 + r, p0 + p) : 0.0;
+					}
+				}
+			}
+		}
+
+		// Rows [p0, p0 + k) and columns [j0, j0 + n) of `b`, a row of gemm_cols values at a time per
+		// register tile. Columns past the end of `b` are packed as zeros.
+		auto pack_b(operand b,
+		            std::size_t p0,
+		            std::size_t k,
+		            std::size_t j0,
+		            std::size_t n,
+		            double* out) -> void {
+			for (auto c0 = std::size_t{0}; c0 < n; c0 += gemm_cols) {
+				for (auto p = std::size_t{0}; p < k; ++p) {
+					for (auto c = c0; c < c0 + gemm_cols; ++c) {
+						*out++ = c < n ? b(p0 + p, j0 + c) : 0.0;
+					}
+				}
+			}
+		}
+
+		// Per-thread packing buffers, grown to the largest block each thread has packed, so repeated
+		// products stop allocating. One for blocks of `a` and one for blocks of `b`, as a thread
+		// packs a block of `a` while its own block of `b` is in use.
+		template<char Operand>
+		auto packing_buffer(std::size_t size) -> double* {
+			thread_local auto buffer = std::vector<double>();
+			if (buffer.size() < size) {
+				buffer.resize(size);
+			}
+			return buffer.data();
+		}
+
+		// c = a b for an m by k `a` and a k by n `b`, with c row-major and ldc apart. Row blocks of c
+		// are the parallel tasks; every element sums its blocks of k in order, whoever runs them.
+		auto gemm(thread_pool& pool,
+		          operand a,
+		          operand b,
+		          std::size_t m,
+		          std::size_t n,
+		          std::size_t k,
+		          double* c,
+		          std::size_t ldc) -> void {
+			for (auto i = std::size_t{0}; i < m; ++i) {
+				std::fill_n(c + i * ldc, n, 0.0);
+			}
+			if (m == 0 or n == 0 or k == 0) {
+				return;
+			}
+			auto const& kernels = kernels::active();
+			auto* const packed_b =
+			   packing_buffer<'b'>(round_up(std::min(n, nc), gemm_cols) * std::min(k, kc));
+			for (auto j0 = std::size_t{0}; j0 < n; j0 += nc) {
+				auto const nb = std::min(nc, n - j0);
+				for (auto p0 = std::size_t{0}; p0 < k; p0 += kc) {
+					auto const kb = std::min(kc, k - p0);
+					pack_b(b, p0, kb, j0, nb, packed_b);
+					pool.run((m + mc - 1) / mc, [&](std::size_t block) {
+						auto const i0 = block * mc;
+						auto const mb = std::min(mc, m - i0);
+						auto* const packed_a = packing_buffer<'a'>(round_up(mb, gemm_rows) * kb);
+						pack_a(a, i0, mb, p0, kb, packed_a);
+						for (auto jr = std::size_t{0}; jr < nb; jr += gemm_cols) {
+							auto const* const sliver = packed_b + jr * kb;
+							for (auto ir = std::size_t{0}; ir < mb; ir += gemm_rows) {
+								auto const* const tile_a = packed_a + ir * kb;
+								auto* const out = c + (i0 + ir) * ldc + j0 + jr;
+								if (ir + gemm_rows <= mb and jr + gemm_cols <= nb) {
+									kernels.gemm_tile(kb, tile_a, sliver, out, ldc);
+									continue;
+								}
+								// Edge tiles accumulate on the side and keep only what fits.
+								auto tile = std::array<double, gemm_rows * gemm_cols>{};
+								kernels.gemm_tile(kb, tile_a, sliver, tile.data(), gemm_cols);
+								for (auto r = std::size_t{0}; r < std::min(gemm_rows, mb - ir); ++r) {
+									for (auto j = std::size_t{0}; j < std::min(gemm_cols, nb - jr); ++j) {
+										out[r * ldc + j] += tile[r * gemm_cols + j];
+									}
+								}
+							}
+						}
+					});
+				}
+			}
+		}
+
+		// y[first, last) of y = a x. Rows go four at a time through dot4, and x a block at a time.
+		auto gemv_rows(double const* a,
+		               std::size_t cols,
+		               double const* x,
+		               double* y,
+		               std::size_t first,
+		               std::size_t last) -> void {
+			auto const& kernels = kernels::active();
+			std::fill(y + first, y + last, 0.0);
+			for (auto c0 = std::size_t{0}; c0 < cols; c0 += gemv_block) {
+				auto const width = std::min(gemv_block, cols - c0);
+				auto i = first;
+				for (; i + 4 <= last; i += 4) {
+					auto partial = std::array<double, 4>{};
+					kernels.dot4(x + c0, a + i * cols + c0, cols, width, partial.data());
+					for (auto r = std::size_t{0}; r < 4; ++r) {
+						y[i + r] += partial[r];
+					}
+				}
+				for (; i < last; ++i) {
+					y[i] += kernels.dot(x + c0, a + i * cols + c0, width);
+				}
+			}
+		}
+
+		auto gemv(thread_pool& pool,
+		          euclidean_matrix const& a,
+		          std::span<double const> x,
+		          std::span<double> y) -> void {
+			euclidean_vector::check_dimensions(a.cols(), static_cast<int>(x.size()));
+			if (y.size() != itos(a.rows())) {
+				auto err_msg = "Output of size " + std::to_string(y.size())
+				               + " does not match euclidean_matrix of " + std::to_string(a.rows())
+				               + " rows";
+				throw euclidean_vector_error(err_msg);
+			}
+			// Tasks cover about parallel_chunk magnitudes, in whole groups of four rows, and depend
+			// only on the shape: the same rows always take the same path.
+			auto const cols = itos(a.cols());
+			auto const rows = y.size();
+			auto const task_rows = round_up(std::max(parallel_chunk / std::max(cols, std::size_t{1}),
+			                                         std::size_t{1}),
+			                                4);
+			pool.run((rows + task_rows - 1) / task_rows, [&](std::size_t task) {
+				auto const first = task * task_rows;
+				auto const last = std::min(rows, first + task_rows);
+				gemv_rows(a.data().data(), cols, x.data(), y.data(), first, last);
+			});
+		}
+
+		auto check_product(euclidean_matrix const& c, std::size_t rows, std::size_t cols) -> void {
+			if (itos(c.rows()) != rows or itos(c.cols()) != cols) {
+				auto err_msg = "euclidean_matrix of shape " + shape(itos(c.rows()), itos(c.cols()))
+				               + " cannot hold a product of shape " + shape(rows, cols);
+				throw euclidean_vector_error(err_msg);
+			}
+		}
+
+		// c = a b, or a bᵀ when `transposed`. A `c` that is also an operand gets the product
+		// through a temporary.
+		auto product(thread_pool& pool,
+		             euclidean_matrix const& a,
+		             euclidean_matrix const& b,
+		             bool transposed,
+		             euclidean_matrix& c) -> void {
+			auto const k = itos(a.cols());
+			auto const b_cols = itos(b.cols());
+			euclidean_vector::check_dimensions(a.cols(), transposed ? b.cols() : b.rows());
+			auto const n = transposed ? itos(b.rows()) : b_cols;
+			check_product(c, itos(a.rows()), n);
+			if (&c == &a or &c == &b) {
+				auto result = euclidean_matrix(c.rows(), c.cols(), c.get_allocator());
+				product(pool, a, b, transposed, result);
+				c = std::move(result);
+				return;
+			}
+			auto const lhs = operand{a.data().data(), k, 1};
+			auto const rhs = transposed ? operand{b.data().data(), 1, b_cols}
+			                            : operand{b.data().data(), b_cols, 1};
+			gemm(pool, lhs, rhs, itos(a.rows()), n, k, c.data().data(), n);
+		}
+	} // namespace
+
+	// ========================== CONSTRUCTORS ==========================
+	euclidean_matrix::euclidean_matrix(int rows, int cols, allocator_type const& alloc)
+	: rows_{rows, cols, batch_layout::row_major, alloc} {}
+
+	// BATCH CONSTRUCTOR
+	euclidean_matrix::euclidean_matrix(euclidean_vector_batch rows)
+	: rows_{row_major(std::move(rows))} {}
+
+	// INITIALIZER LIST CONSTRUCTOR
+	euclidean_matrix::euclidean_matrix(std::initializer_list<std::initializer_list<double>> rows)
+	: euclidean_matrix(static_cast<int>(rows.size()),
+	                   rows.size() == 0 ? 0 : static_cast<int>(rows.begin()->size())) {
+		auto out = this->data().begin();
+		for (auto const& row : rows) {
+			if (row.size() != itos(this->cols())) {
+				auto err_msg = "euclidean_matrix rows of " + std::to_string(row.size()) + " and "
+				               + std::to_string(this->cols()) + " columns do not match";
+				throw euclidean_vector_error(err_msg);
+			}
+			out = std::copy(row.begin(), row.end(), out);
+		}
+	}
+
+	// =========================== OPERATORS ===========================
+	// EQUALITY OPERATOR
+	auto operator==(euclidean_matrix const& a, euclidean_matrix const& b) -> bool {
+		auto const x = a.data();
+		auto const y = b.data();
+		return a.rows() == b.rows() and a.cols() == b.cols()
+		       and std::equal(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+	// MULTIPLICATION OPERATOR
+	auto operator*(euclidean_matrix const& a, euclidean_vector const& x) -> euclidean_vector {
+		return multiply(a, x);
+	}
+
+	auto operator*(euclidean_matrix const& a, euclidean_matrix const& b) -> euclidean_matrix {
+		return multiply(a, b);
+	}
+
+	// =========================== UTILITY ===========================
+	// TRANSPOSE
+	auto transpose(euclidean_matrix const& a) -> euclidean_matrix {
+		auto t = euclidean_matrix(a.cols(), a.rows(), a.get_allocator());
+		auto const rows = itos(a.rows());
+		auto const cols = itos(a.cols());
+		auto const in = a.data();
+		auto const out = t.data();
+		for (auto i0 = std::size_t{0}; i0 < rows; i0 += transpose_block) {
+			for (auto j0 = std::size_t{0}; j0 < cols; j0 += transpose_block) {
+				for (auto i = i0; i < std::min(rows, i0 + transpose_block); ++i) {
+					for (auto j = j0; j < std::min(cols, j0 + transpose_block); ++j) {
+						out[j * rows + i] = in[i * cols + j];
+					}
+				}
+			}
+		}
+		return t;
+	}
+
+	// MATRIX-VECTOR PRODUCT
+	auto multiply(euclidean_matrix const& a, std::span<double const> x, std::span<double> y)
+	   -> void {
+		auto one = thread_pool(1);
+		gemv(one, a, x, y);
+	}
+
+	auto multiply(euclidean_matrix const& a, euclidean_vector const& x) -> euclidean_vector {
+		auto one = thread_pool(1);
+		return multiply(parallel_policy{&one}, a, x);
+	}
+
+	auto multiply(parallel_policy const& policy,
+	              euclidean_matrix const& a,
+	              std::span<double const> x,
+	              std::span<double> y) -> void {
+		gemv(pool_of(policy), a, x, y);
+	}
+
+	auto multiply(parallel_policy const& policy,
+	              euclidean_matrix const& a,
+	              euclidean_vector const& x) -> euclidean_vector {
+		auto y = euclidean_vector(a.rows());
+		gemv(pool_of(policy),
+		     a,
+		     std::span<double const>(x.data(), itos(x.dimensions())),
+		     std::span<double>(y.begin(), itos(y.dimensions())));
+		return y;
+	}
+
+	// MATRIX PRODUCT
+	auto multiply(euclidean_matrix const& a, euclidean_matrix const& b, euclidean_matrix& c)
+	   -> void {
+		auto one = thread_pool(1);
+		product(one, a, b, false, c);
+	}
+
+	auto multiply(euclidean_matrix const& a, euclidean_matrix const& b) -> euclidean_matrix {
+		auto one = thread_pool(1);
+		return multiply(parallel_policy{&one}, a, b);
+	}
+
+	auto multiply(parallel_policy const& policy,
+	              euclidean_matrix const& a,
+	              euclidean_matrix const& b,
+	              euclidean_matrix& c) -> void {
+		product(pool_of(policy), a, b, false, c);
+	}
+
+	auto multiply(parallel_policy const& policy,
+	              euclidean_matrix const& a,
+	              euclidean_matrix const& b) -> euclidean_matrix {
+		euclidean_vector::check_dimensions(a.cols(), b.rows());
+		auto c = euclidean_matrix(a.rows(), b.cols(), a.get_allocator());
+		product(pool_of(policy), a, b, false, c);
+		return c;
+	}
+
+	// TRANSPOSED MATRIX PRODUCT
+	auto multiply_transposed(euclidean_matrix const& a,
+	                         euclidean_matrix const& b,
+	                         euclidean_matrix& c) -> void {
+		auto one = thread_pool(1);
+		product(one, a, b, true, c);
+	}
+
+	auto multiply_transposed(euclidean_matrix const& a, euclidean_matrix const& b)
+	   -> euclidean_matrix {
+		auto one = thread_pool(1);
+		return multiply_transposed(parallel_policy{&one}, a, b);
+	}
+
+	auto multiply_transposed(parallel_policy const& policy,
+	                         euclidean_matrix const& a,
+	                         euclidean_matrix const& b,
+	                         euclidean_matrix& c) -> void {
+		product(pool_of(policy), a, b, true, c);
+	}
+
+	auto multiply_transposed(parallel_policy const& policy,
+	                         euclidean_matrix const& a,
+	                         euclidean_matrix const& b) -> euclidean_matrix {
+		euclidean_vector::check_dimensions(a.cols(), b.cols());
+		auto c = euclidean_matrix(a.rows(), b.rows(), a.get_allocator());
+		product(pool_of(policy), a, b, true, c);
+		return c;
+	}
+} // namespace comp6771
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 #include "comp6771/euclidean_vector.hpp"
+#include "comp6771/kernels.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
@@ -9,219 +10,527 @@
 #include <span>
 
 namespace comp6771 {
+	// LINK GUARD
+	namespace detail {
+#if COMP6771_EV_COUNTERS
+		int const ev_counters_on = 1;
+#else
+		int const ev_counters_off = 0;
+#endif
+		int const ev_counters_library = COMP6771_EV_COUNTERS;
+	} // namespace detail
+
+	namespace {
+		// The kernels each magnitude type runs on. double dispatches to the SIMD tables in
+		// kernels.cpp. float runs plain loops, which the compiler vectorises at twice double's
+		// width; its reductions accumulate in ev_accumulator_t<float>.
+		template<ev_magnitude T>
+		struct magnitude_kernels;
+
+		template<>
+		struct magnitude_kernels<double> {
+			static auto add(double* y, double const* x, std::size_t n) -> void {
+				kernels::active().add(y, x, n);
+			}
+
+			static auto scale(double* y, double a, std::size_t n) -> void {
+				kernels::active().scale(y, a, n);
+			}
+
+			static auto divide(double* y, double d, std::size_t n) -> void {
+				kernels::active().divide(y, d, n);
+			}
+
+			static auto axpy(double* y, double a, double const* x, std::size_t n) -> void {
+				kernels::active().axpy(y, a, x, n);
+			}
+
+			static auto axpby(double* y, double a, double const* x, double b, std::size_t n) -> void {
+				kernels::active().axpby(y, a, x, b, n);
+			}
+
+			static auto dot(double const* x, double const* y, std::size_t n) -> double {
+				return kernels::active().dot(x, y, n);
+			}
+
+			static auto sum_squares(double const* x, std::size_t n) -> double {
+				return kernels::active().sum_squares(x, n);
+			}
+
+			static auto dot_and_squares(double const* x, double const* y, std::size_t n)
+			   -> kernels::dot_squares {
+				return kernels::active().dot_and_squares(x, y, n);
+			}
+		};
+
+		template<>
+		struct magnitude_kernels<float> {
+			using accumulator = ev_accumulator_t<float>;
+
+			static auto add(float* y, float const* x, std::size_t n) -> void {
+				auto const ys = std::span(y, n);
+				auto const xs = std::span(x, n);
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					ys[i] += xs[i];
+				}
+			}
+
+			static auto scale(float* y, double a, std::size_t n) -> void {
+				auto const af = static_cast<float>(a);
+				for (auto& m : std::span(y, n)) {
+					m *= af;
+				}
+			}
+
+			static auto divide(float* y, double d, std::size_t n) -> void {
+				auto const df = static_cast<float>(d);
+				for (auto& m : std::span(y, n)) {
+					m /= df;
+				}
+			}
+
+			static auto axpy(float* y, double a, float const* x, std::size_t n) -> void {
+				auto const af = static_cast<float>(a);
+				auto const ys = std::span(y, n);
+				auto const xs = std::span(x, n);
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					ys[i] += af * xs[i];
+				}
+			}
+
+			static auto axpby(float* y, double a, float const* x, double b, std::size_t n) -> void {
+				auto const af = static_cast<float>(a);
+				auto const bf = static_cast<float>(b);
+				auto const ys = std::span(y, n);
+				auto const xs = std::span(x, n);
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					ys[i] = af * xs[i] + bf * ys[i];
+				}
+			}
+
+			static auto dot(float const* x, float const* y, std::size_t n) -> double {
+				return dot_and_squares(x, y, n).dot;
+			}
+
+			static auto sum_squares(float const* x, std::size_t n) -> double {
+				auto sum = accumulator{0};
+				for (auto const m : std::span(x, n)) {
+					sum += static_cast<accumulator>(m) * static_cast<accumulator>(m);
+				}
+				return sum;
+			}
+
+			static auto dot_and_squares(float const* x, float const* y, std::size_t n)
+			   -> kernels::dot_squares {
+				auto const xs = std::span(x, n);
+				auto const ys = std::span(y, n);
+				auto sums = kernels::dot_squares{0.0, 0.0, 0.0};
+				for (auto i = std::size_t{0}; i < n; ++i) {
+					auto const xi = static_cast<accumulator>(xs[i]);
+					auto const yi = static_cast<accumulator>(ys[i]);
+					sums.dot += xi * yi;
+					sums.x_squares += xi * xi;
+					sums.y_squares += yi * yi;
+				}
+				return sums;
+			}
+		};
+	} // namespace
+
 	// ========================== CONSTRUCTORS ==========================
 	// DEFAULT CONSTRUCTOR
-	euclidean_vector::euclidean_vector()
-	: magnitudes_{prep_mag(1)}
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector()
+	: basic_euclidean_vector(allocator_type{}) {}
+
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(allocator_type const& alloc)
+	: magnitudes_{prep_mag<T>(1, alloc.resource())}
 	, dimensions_{itos(1)} {
-		this->magnitudes_[0] = 0.0;
+		this->magnitudes_[0] = T{0};
 	};
 
 	// SINGLE-ARGUMENT CONSTRUCTOR
-	euclidean_vector::euclidean_vector(int dim)
-	: magnitudes_{prep_mag(dim)}
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(int dim, allocator_type const& alloc)
+	: magnitudes_{prep_mag<T>(dim, alloc.resource())}
 	, dimensions_{itos(dim)} {
-		std::fill(this->begin(), this->end(), 0.0);
+		std::fill(this->begin(), this->end(), T{0});
 	}
 
 	// CONSTRUCTOR
-	euclidean_vector::euclidean_vector(int dim, double mag)
-	: magnitudes_{prep_mag(dim)}
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(int dim, T mag, allocator_type const& alloc)
+	: magnitudes_{prep_mag<T>(dim, alloc.resource())}
 	, dimensions_{itos(dim)} {
 		auto s = std::span(this->magnitudes_.get(), this->dimensions_);
 		std::fill(s.begin(), s.end(), mag);
 	}
 
 	// VECTOR CONSTRUCTOR
-	euclidean_vector::euclidean_vector(std::vector<double>::const_iterator b,
-	                                   std::vector<double>::const_iterator e)
-	: magnitudes_{prep_mag(static_cast<int>(std::distance(b, e)))}
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(typename std::vector<T>::const_iterator b,
+	                                                  typename std::vector<T>::const_iterator e,
+	                                                  allocator_type const& alloc)
+	: magnitudes_{prep_mag<T>(static_cast<int>(std::distance(b, e)), alloc.resource())}
 	, dimensions_{static_cast<std::size_t>(std::distance(b, e))} {
-		auto s = std::span(this->magnitudes_.get(), this->dimensions_);
 		std::copy(b, e, this->magnitudes_.get());
 	}
 
 	// INITIALISER LIST CONSTRUCTOR
-	euclidean_vector::euclidean_vector(std::initializer_list<double> list)
-	: magnitudes_{prep_mag(static_cast<int>(list.size()))}
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(std::initializer_list<T> list,
+	                                                  allocator_type const& alloc)
+	: magnitudes_{prep_mag<T>(static_cast<int>(list.size()), alloc.resource())}
 	, dimensions_{list.size()} {
 		std::copy(list.begin(), list.end(), this->magnitudes_.get());
 	}
 
+	// ADOPTING CONSTRUCTOR
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(std::vector<T>&& magnitudes)
+	: magnitudes_{std::move(magnitudes)}
+	, dimensions_{magnitudes_.size()} {}
+
 	// COPY CONSTRUCTOR
-	euclidean_vector::euclidean_vector(euclidean_vector const& to_copy)
-	: norm{to_copy.norm}
-	, magnitudes_{prep_mag(to_copy.dimensions())}
-	, dimensions_{to_copy.dimensions_} {
-		std::copy_n(to_copy.magnitudes_.get(), to_copy.dimensions(), this->magnitudes_.get());
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(basic_euclidean_vector const& to_copy)
+	: magnitudes_{to_copy.magnitudes_}
+	, dimensions_{to_copy.dimensions_}
+	, norm_{to_copy.norm_.load(std::memory_order_relaxed)} {
+		ev_count_copy();
+	}
+
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(basic_euclidean_vector const& to_copy,
+	                                                  allocator_type const& alloc)
+	: magnitudes_{to_copy.magnitudes_, alloc.resource()}
+	, dimensions_{to_copy.dimensions_}
+	, norm_{to_copy.norm_.load(std::memory_order_relaxed)} {
+		ev_count_copy();
 	}
 
 	// MOVE CONSTRUCTOR
-	euclidean_vector::euclidean_vector(euclidean_vector&& to_move) noexcept
-	: norm{to_move.norm}
-	, magnitudes_{std::move(to_move.magnitudes_)}
-	, dimensions_{to_move.dimensions_} {
-		to_move.magnitudes_ = nullptr;
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(basic_euclidean_vector&& to_move) noexcept
+	: magnitudes_{std::move(to_move.magnitudes_)}
+	, dimensions_{to_move.dimensions_}
+	, norm_{to_move.norm_.load(std::memory_order_relaxed)} {
+		ev_count_move();
 		to_move.dimensions_ = 0;
-		to_move.norm = -1;
+		to_move.invalidate_norm();
+	}
+
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::basic_euclidean_vector(basic_euclidean_vector&& to_move,
+	                                                  allocator_type const& alloc)
+	: magnitudes_{std::move(to_move.magnitudes_), alloc.resource()}
+	, dimensions_{to_move.dimensions_}
+	, norm_{to_move.norm_.load(std::memory_order_relaxed)} {
+		ev_count_move();
+		to_move.dimensions_ = 0;
+		to_move.invalidate_norm();
 	}
 
 	// =========================== OPERATORS ===========================
 	// COPY OPERATOR
-	auto euclidean_vector::operator=(euclidean_vector const& to_copy) -> euclidean_vector& {
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator=(basic_euclidean_vector const& to_copy)
+	   -> basic_euclidean_vector& {
 		if (this != &to_copy) {
+			ev_count_copy();
 			this->dimensions_ = to_copy.dimensions_;
-			this->magnitudes_ = prep_mag(to_copy.dimensions());
-			this->norm = to_copy.norm;
-			std::copy_n(to_copy.begin(), to_copy.dimensions(), this->begin());
+			this->magnitudes_ = to_copy.magnitudes_;
+			this->norm_.store(to_copy.norm_.load(std::memory_order_relaxed),
+			                  std::memory_order_relaxed);
 		}
 		return *this;
 	}
 
 	// MOVE OPERATOR
-	auto euclidean_vector::operator=(euclidean_vector&& to_move) noexcept -> euclidean_vector& {
-		this->magnitudes_ = std::move(to_move.magnitudes_);
-		this->dimensions_ = to_move.dimensions_;
-		this->norm = to_move.norm;
-		to_move.magnitudes_ = nullptr;
-		to_move.dimensions_ = 0;
-		to_move.norm = -1;
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator=(basic_euclidean_vector&& to_move) noexcept
+	   -> basic_euclidean_vector& {
+		if (this != &to_move) {
+			ev_count_move();
+			this->magnitudes_ = std::move(to_move.magnitudes_);
+			this->dimensions_ = to_move.dimensions_;
+			this->norm_.store(to_move.norm_.load(std::memory_order_relaxed),
+			                  std::memory_order_relaxed);
+			to_move.dimensions_ = 0;
+			to_move.invalidate_norm();
+		}
 		return *this;
 	}
 
 	// SUBSCRIPT OPERATOR
-	auto euclidean_vector::operator[](int i) -> double {
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator[](int i) -> T {
 		assert(i >= 0 and i < this->dimensions());
 		return this->magnitudes_[itos(i)];
 	}
 
 	// CONST SUBSCRIPT OPERATOR
-	auto euclidean_vector::operator[](int i) const -> double {
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator[](int i) const -> T {
 		assert(i >= 0 and i < this->dimensions());
 		return this->magnitudes_[itos(i)];
 	}
 
 	// UNARY PLUS OPERATOR
-	auto euclidean_vector::operator+() -> euclidean_vector {
-		return euclidean_vector(*this);
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator+() -> basic_euclidean_vector {
+		return basic_euclidean_vector(*this);
 	}
 
 	// NEGATION OPERATOR
-	auto euclidean_vector::operator-() -> euclidean_vector {
-		auto ev = euclidean_vector(*this);
-		std::for_each (ev.begin(), ev.end(), [&](double& d) { d *= -1; });
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator-() -> basic_euclidean_vector {
+		// Negation keeps the norm, which *= carries over from the copy.
+		auto ev = basic_euclidean_vector(*this);
+		ev *= -1.0;
 		return ev;
 	}
 
 	// COMPOUND ADDITION OPERATOR
-	auto euclidean_vector::operator+=(euclidean_vector const& ev) -> euclidean_vector& {
-		if (this->dimensions_ != ev.dimensions_) {
-			auto err_msg = "Dimensions of LHS(" + std::to_string(this->dimensions()) + ") and RHS("
-			               + std::to_string(ev.dimensions()) + ") do not match";
-			throw euclidean_vector_error(err_msg);
-		}
-		std::transform(this->begin(), this->end(), ev.begin(), this->begin(), [&](double& a, double& b) {
-			return a + b;
-		});
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator+=(basic_euclidean_vector const& ev)
+	   -> basic_euclidean_vector& {
+		check_dimensions(this->dimensions(), ev.dimensions());
+		magnitude_kernels<T>::add(this->magnitudes_.get(), ev.magnitudes_.get(), this->dimensions_);
+		this->invalidate_norm();
 		return *this;
 	}
 
 	// COMPOUND SUBTRACTION OPERATOR
-	auto euclidean_vector::operator-=(euclidean_vector const& ev) -> euclidean_vector& {
-		auto new_ev = ev;
-		*this += -new_ev;
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator-=(basic_euclidean_vector const& ev)
+	   -> basic_euclidean_vector& {
+		// y + -1 * x is exactly y - x, and needs neither a negated copy nor a new kernel.
+		check_dimensions(this->dimensions(), ev.dimensions());
+		auto* const y = this->magnitudes_.get();
+		magnitude_kernels<T>::axpy(y, -1.0, ev.magnitudes_.get(), this->dimensions_);
+		this->invalidate_norm();
 		return *this;
 	}
 
 	// COMPOUND MULTIPLICATION OPERATOR
-	auto euclidean_vector::operator*=(double d) -> euclidean_vector& {
-		std::for_each (this->begin(), this->end(), [&](double& a) { a *= d; });
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator*=(double d) -> basic_euclidean_vector& {
+		magnitude_kernels<T>::scale(this->magnitudes_.get(), d, this->dimensions_);
+		this->scale_norm(std::abs(d));
 		return *this;
 	}
 
 	// COMPOUND DIVISION OPERATOR
-	auto euclidean_vector::operator/=(double d) -> euclidean_vector& {
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::operator/=(double d) -> basic_euclidean_vector& {
 		if (d == 0) {
 			const auto* err_msg = "Invalid vector division by 0";
 			throw euclidean_vector_error(err_msg);
 		}
-		std::for_each (this->begin(), this->end(), [&](double& a) { a /= d; });
+		magnitude_kernels<T>::divide(this->magnitudes_.get(), d, this->dimensions_);
+		this->scale_norm(1.0 / std::abs(d));
 		return *this;
 	}
 
 	// VECTOR TYPE CONVERSION OPERATOR
-	euclidean_vector::operator std::vector<double>() {
-		auto v = std::vector<double>();
-		v.reserve(this->dimensions_);
-		auto s = std::span(this->magnitudes_.get(), this->dimensions_);
-		std::for_each (s.begin(), s.end(), [&](double& a) { v.push_back(a); });
-		return v;
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::operator std::vector<T>() {
+		auto s = std::span<T const>(this->magnitudes_.get(), this->dimensions_);
+		return std::vector<T>(s.begin(), s.end());
 	}
 
 	// VECTOR TYPE CONVERSION CONST OPERATOR
-	euclidean_vector::operator std::vector<double>() const {
-		auto v = std::vector<double>();
-		v.reserve(this->dimensions_);
-		auto s = std::span(this->magnitudes_.get(), this->dimensions_);
-		std::for_each (s.begin(), s.end(), [&](double& a) { v.push_back(a); });
-		return v;
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::operator std::vector<T>() const {
+		auto s = std::span<T const>(this->magnitudes_.get(), this->dimensions_);
+		return std::vector<T>(s.begin(), s.end());
 	}
 
 	// LIST TYPE CONVERSION OPERATOR
-	euclidean_vector::operator std::list<double>() {
-		auto l = std::list<double>();
-		auto s = std::span(this->magnitudes_.get(), this->dimensions_);
-		std::for_each (s.begin(), s.end(), [&](double& a) { l.push_back(a); });
-		return l;
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::operator std::list<T>() {
+		auto s = std::span<T const>(this->magnitudes_.get(), this->dimensions_);
+		return std::list<T>(s.begin(), s.end());
 	}
 
 	// LIST TYPE CONVERSION CONST OPERATOR
-	euclidean_vector::operator std::list<double>() const {
-		auto l = std::list<double>();
-		auto s = std::span(this->magnitudes_.get(), this->dimensions_);
-		std::for_each (s.begin(), s.end(), [&](double& a) { l.push_back(a); });
-		return l;
+	template<ev_magnitude T>
+	basic_euclidean_vector<T>::operator std::list<T>() const {
+		auto s = std::span<T const>(this->magnitudes_.get(), this->dimensions_);
+		return std::list<T>(s.begin(), s.end());
+	}
+
+	// RELEASE METHOD
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::release_to_vector() && -> std::vector<T> {
+		this->dimensions_ = 0;
+		this->invalidate_norm();
+		return this->magnitudes_.release_to_vector();
+	}
+
+	// COPY TO METHOD
+	template<ev_magnitude T>
+	auto basic_euclidean_vector<T>::copy_to(std::span<T> out) const -> std::span<T> {
+		if (out.size() < this->dimensions_) {
+			auto err_msg = "Cannot copy " + std::to_string(this->dimensions_)
+			               + " magnitudes into a span of " + std::to_string(out.size());
+			throw euclidean_vector_error(err_msg);
+		}
+		std::copy_n(this->magnitudes_.get(), this->dimensions_, out.begin());
+		return out.first(this->dimensions_);
 	}
 
 	// =========================== UTILITY ===========================
-	auto euclidean_norm(euclidean_vector const& v) -> double {
+	template<ev_magnitude T>
+	auto euclidean_norm(basic_euclidean_vector<T> const& v) -> double {
 		if (v.dimensions() == 0) {
 			return 0.0;
 		}
-		if (v.norm == -1) {
-			auto total = 0.0;
-			std::for_each (v.begin(), v.end(), [&](double& a) { total += a * a; });
-			v.norm = std::sqrt(total);
+		auto norm = v.norm_.load(std::memory_order_relaxed);
+		ev_count_norm_lookup(norm != basic_euclidean_vector<T>::no_norm);
+		if (norm == basic_euclidean_vector<T>::no_norm) {
+			norm = std::sqrt(magnitude_kernels<T>::sum_squares(v.data(), itos(v.dimensions())));
+			v.norm_.store(norm, std::memory_order_relaxed);
 		}
-		return v.norm;
+		return norm;
 	}
 
-	auto unit(euclidean_vector const& v) -> euclidean_vector {
+	auto euclidean_norm(std::span<double const> v) -> double {
+		return std::sqrt(kernels::active().sum_squares(v.data(), v.size()));
+	}
+
+	template<ev_magnitude T>
+	auto unit(basic_euclidean_vector<T> const& v) -> basic_euclidean_vector<T> {
 		if (v.dimensions() == 0) {
 			const auto* err_msg = "euclidean_vector with no dimensions does not have a unit vector";
 			throw euclidean_vector_error(err_msg);
 		}
-		if (euclidean_norm(v) == 0.0) {
+		auto const norm = euclidean_norm(v);
+		if (norm == 0.0) {
 			const auto* err_msg = "euclidean_vector with zero euclidean normal does not have a unit "
 			                      "vector";
 			throw euclidean_vector_error(err_msg);
 		}
-		auto ev = euclidean_vector(v);
-		auto norm = euclidean_norm(ev);
-		std::for_each (ev.begin(), ev.end(), [&](double& a) { a /= norm; });
+		auto ev = basic_euclidean_vector<T>(v);
+		ev /= norm;
 		return ev;
 	}
 
-	auto dot(euclidean_vector const& x, euclidean_vector const& y) -> double {
-		if (x.dimensions() != y.dimensions()) {
-			auto err_msg = "Dimensions of LHS(" + std::to_string(x.dimensions()) + ") and RHS("
-			               + std::to_string(y.dimensions()) + ") do not match";
+	auto unit(std::span<double const> v) -> euclidean_vector {
+		if (v.empty()) {
+			const auto* err_msg = "euclidean_vector with no dimensions does not have a unit vector";
+			throw euclidean_vector_error(err_msg);
+		}
+		auto const norm = euclidean_norm(v);
+		if (norm == 0.0) {
+			const auto* err_msg = "euclidean_vector with zero euclidean normal does not have a unit "
+			                      "vector";
 			throw euclidean_vector_error(err_msg);
 		}
-		auto ev = euclidean_vector(x.dimensions());
-		std::transform(x.begin(), x.end(), y.begin(), ev.begin(), [&](double& a, double& b) {
-			return a * b;
-		});
-		return std::accumulate(ev.begin(), ev.end(), 0.0);
+		auto ev = euclidean_vector(static_cast<int>(v.size()));
+		std::copy(v.begin(), v.end(), ev.begin());
+		ev /= norm;
+		return ev;
+	}
+
+	template<ev_magnitude T>
+	auto dot(basic_euclidean_vector<T> const& x, basic_euclidean_vector<T> const& y) -> double {
+		euclidean_vector::check_dimensions(x.dimensions(), y.dimensions());
+		return magnitude_kernels<T>::dot(x.data(), y.data(), itos(x.dimensions()));
+	}
+
+	auto dot(std::span<double const> x, std::span<double const> y) -> double {
+		euclidean_vector::check_dimensions(static_cast<int>(x.size()), static_cast<int>(y.size()));
+		return kernels::active().dot(x.data(), y.data(), x.size());
+	}
+
+	template<ev_magnitude T>
+	auto axpy(double a, basic_euclidean_vector<T> const& x, basic_euclidean_vector<T>& y) -> void {
+		euclidean_vector::check_dimensions(x.dimensions(), y.dimensions());
+		magnitude_kernels<T>::axpy(y.magnitudes_.get(), a, x.data(), y.dimensions_);
+		y.invalidate_norm();
+	}
+
+	auto axpy(double a, std::span<double const> x, std::span<double> y) -> void {
+		euclidean_vector::check_dimensions(static_cast<int>(x.size()), static_cast<int>(y.size()));
+		kernels::active().axpy(y.data(), a, x.data(), y.size());
+	}
+
+	template<ev_magnitude T>
+	auto axpby(double a, basic_euclidean_vector<T> const& x, double b, basic_euclidean_vector<T>& y)
+	   -> void {
+		euclidean_vector::check_dimensions(x.dimensions(), y.dimensions());
+		magnitude_kernels<T>::axpby(y.magnitudes_.get(), a, x.data(), b, y.dimensions_);
+		y.invalidate_norm();
+	}
+
+	auto axpby(double a, std::span<double const> x, double b, std::span<double> y) -> void {
+		euclidean_vector::check_dimensions(static_cast<int>(x.size()), static_cast<int>(y.size()));
+		kernels::active().axpby(y.data(), a, x.data(), b, y.size());
+	}
+
+	template<ev_magnitude T>
+	auto dot_and_norms(basic_euclidean_vector<T> const& x, basic_euclidean_vector<T> const& y)
+	   -> dot_and_norms_result {
+		euclidean_vector::check_dimensions(x.dimensions(), y.dimensions());
+		auto const sums = magnitude_kernels<T>::dot_and_squares(x.data(), y.data(), x.dimensions_);
+		auto const result =
+		   dot_and_norms_result{sums.dot, std::sqrt(sums.x_squares), std::sqrt(sums.y_squares)};
+		x.norm_.store(result.x_norm, std::memory_order_relaxed);
+		y.norm_.store(result.y_norm, std::memory_order_relaxed);
+		return result;
+	}
+
+	auto dot_and_norms(std::span<double const> x, std::span<double const> y)
+	   -> dot_and_norms_result {
+		euclidean_vector::check_dimensions(static_cast<int>(x.size()), static_cast<int>(y.size()));
+		auto const sums = kernels::active().dot_and_squares(x.data(), y.data(), x.size());
+		return {sums.dot, std::sqrt(sums.x_squares), std::sqrt(sums.y_squares)};
+	}
+
+	namespace {
+		auto cosine(dot_and_norms_result const& r) -> double {
+			if (r.x_norm == 0.0 or r.y_norm == 0.0) {
+				const auto* err_msg = "euclidean_vector with zero euclidean normal does not have a "
+				                      "cosine similarity";
+				throw euclidean_vector_error(err_msg);
+			}
+			return r.dot / (r.x_norm * r.y_norm);
+		}
+	} // namespace
+
+	template<ev_magnitude T>
+	auto cosine_similarity(basic_euclidean_vector<T> const& x, basic_euclidean_vector<T> const& y)
+	   -> double {
+		return cosine(dot_and_norms(x, y));
 	}
+
+	auto cosine_similarity(std::span<double const> x, std::span<double const> y) -> double {
+		return cosine(dot_and_norms(x, y));
+	}
+
+	// =========================== INSTANTIATIONS ===========================
+	template class basic_euclidean_vector<float>;
+	template class basic_euclidean_vector<double>;
+
+	template auto euclidean_norm(float_euclidean_vector const& v) -> double;
+	template auto euclidean_norm(euclidean_vector const& v) -> double;
+	template auto unit(float_euclidean_vector const& v) -> float_euclidean_vector;
+	template auto unit(euclidean_vector const& v) -> euclidean_vector;
+	template auto dot(float_euclidean_vector const& x, float_euclidean_vector const& y) -> double;
+	template auto dot(euclidean_vector const& x, euclidean_vector const& y) -> double;
+	template auto axpy(double a, float_euclidean_vector const& x, float_euclidean_vector& y) -> void;
+	template auto axpy(double a, euclidean_vector const& x, euclidean_vector& y) -> void;
+	template auto
+	axpby(double a, float_euclidean_vector const& x, double b, float_euclidean_vector& y) -> void;
+	template auto axpby(double a, euclidean_vector const& x, double b, euclidean_vector& y) -> void;
+	template auto dot_and_norms(float_euclidean_vector const& x, float_euclidean_vector const& y)
+	   -> dot_and_norms_result;
+	template auto dot_and_norms(euclidean_vector const& x, euclidean_vector const& y)
+	   -> dot_and_norms_result;
+	template auto
+	cosine_similarity(float_euclidean_vector const& x, float_euclidean_vector const& y) -> double;
+	template auto cosine_similarity(euclidean_vector const& x, euclidean_vector const& y) -> double;
 } // namespace comp6771
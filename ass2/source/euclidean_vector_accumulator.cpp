@@ -0,0 +1,148 @@
+#include "comp6771/euclidean_vector_accumulator.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		constexpr auto line = euclidean_vector_batch::alignment / sizeof(double);
+
+		// Rows rounded up to whole cache lines, so every shard's sum starts on a line of its own.
+		auto padded(int dim) -> int {
+			auto const d = itos(dim);
+			return static_cast<int>((d + line - 1) / line * line);
+		}
+
+		auto check_dim(int dim) -> int {
+			if (dim < 0) {
+				auto err_msg = "Invalid dimensions (" + std::to_string(dim)
+				               + ") for euclidean_vector_accumulator";
+				throw euclidean_vector_error(err_msg);
+			}
+			return dim;
+		}
+
+		auto check_shards(int shards) -> int {
+			if (shards < 1) {
+				auto err_msg = "Invalid shard count (" + std::to_string(shards)
+				               + ") for euclidean_vector_accumulator";
+				throw euclidean_vector_error(err_msg);
+			}
+			return shards;
+		}
+
+		// Slots numbered from 0, each held by at most one live thread. A thread takes the lowest
+		// free slot the first time it adds to any accumulator and gives it back when it exits, so
+		// however many threads have come and gone, those alive at once hold the lowest slots.
+		class thread_slots {
+		public:
+			auto acquire() -> std::size_t {
+				auto const lock = std::scoped_lock(mutex_);
+				auto const free = std::find(taken_.begin(), taken_.end(), false);
+				auto const slot = static_cast<std::size_t>(free - taken_.begin());
+				if (free == taken_.end()) {
+					taken_.push_back(true);
+				}
+				else {
+					*free = true;
+				}
+				return slot;
+			}
+
+			auto release(std::size_t slot) -> void {
+				auto const lock = std::scoped_lock(mutex_);
+				taken_[slot] = false;
+			}
+
+		private:
+			std::mutex mutex_;
+			std::vector<bool> taken_;
+		};
+
+		// Never destroyed, so threads that outlive static destruction can still give back their
+		// slots.
+		auto slots() -> thread_slots& {
+			static auto* const instance = new thread_slots(); // NOLINT(cppcoreguidelines-owning-memory)
+			return *instance;
+		}
+
+		class thread_slot {
+		public:
+			thread_slot()
+			: slot_{slots().acquire()} {}
+			thread_slot(thread_slot const&) = delete;
+			thread_slot(thread_slot&&) = delete;
+			~thread_slot() {
+				slots().release(slot_);
+			}
+
+			auto operator=(thread_slot const&) -> thread_slot& = delete;
+			auto operator=(thread_slot&&) -> thread_slot& = delete;
+
+			[[nodiscard]] auto get() const -> std::size_t {
+				return slot_;
+			}
+
+		private:
+			std::size_t slot_;
+		};
+
+		auto this_thread_slot() -> std::size_t {
+			thread_local auto const slot = thread_slot();
+			return slot.get();
+		}
+	} // namespace
+
+	// ========================== CONSTRUCTORS ==========================
+	euclidean_vector_accumulator::euclidean_vector_accumulator(int dim, int shards)
+	: dimensions_{itos(check_dim(dim))}
+	, sums_(check_shards(shards), padded(dim))
+	, locks_(itos(shards)) {}
+
+	// =========================== MEMBER FUNCTIONS ===========================
+	// ADD METHOD
+	auto euclidean_vector_accumulator::add(euclidean_vector const& v) -> void {
+		this->add(std::span<double const>(v.data(), itos(v.dimensions())));
+	}
+
+	auto euclidean_vector_accumulator::add(std::span<double const> v) -> void {
+		euclidean_vector::check_dimensions(this->dimensions(), static_cast<int>(v.size()));
+		auto const shard = this_thread_slot() % locks_.size();
+		auto const sum = sums_.row(static_cast<int>(shard));
+		auto const lock = std::scoped_lock(locks_[shard].mutex);
+		kernels::active().add(sum.data(), v.data(), dimensions_);
+	}
+
+	// SNAPSHOT METHOD
+	auto euclidean_vector_accumulator::snapshot() const -> euclidean_vector {
+		auto total = euclidean_vector(this->dimensions());
+		auto const& kernels = kernels::active();
+		auto const locks = this->lock_all();
+		for (auto i = 0; i < sums_.size(); ++i) {
+			kernels.add(std::to_address(total.begin()), sums_.row(i).data(), dimensions_);
+		}
+		return total;
+	}
+
+	// RESET METHOD
+	auto euclidean_vector_accumulator::reset() -> void {
+		auto const locks = this->lock_all();
+		std::ranges::fill(sums_.data(), 0.0);
+	}
+
+	// Always in shard order, and add() only ever holds one, so this can't deadlock.
+	auto euclidean_vector_accumulator::lock_all() const
+	   -> std::vector<std::unique_lock<std::mutex>> {
+		auto locks = std::vector<std::unique_lock<std::mutex>>();
+		locks.reserve(locks_.size());
+		for (auto& shard : locks_) {
+			locks.emplace_back(shard.mutex);
+		}
+		return locks;
+	}
+} // namespace comp6771
@@ -0,0 +1,342 @@
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		// Rounds the buffer up to whole cache lines so the last row never shares one with
+		// something else.
+		auto buffer_bytes(std::size_t elements) -> std::size_t {
+			auto const bytes = elements * sizeof(double);
+			auto const a = euclidean_vector_batch::alignment;
+			return (bytes + a - 1) / a * a;
+		}
+
+		// The number of magnitudes `size` vectors of `dim` dimensions take, as long as their
+		// buffer's size in bytes fits in a std::size_t.
+		auto checked_elements(int size, int dim) -> std::size_t {
+			if (size < 0 or dim < 0) {
+				auto err_msg = "Invalid size (" + std::to_string(size) + ") or dimensions ("
+				               + std::to_string(dim) + ") for euclidean_vector_batch";
+				throw euclidean_vector_error(err_msg);
+			}
+			auto const max = std::numeric_limits<std::size_t>::max() / sizeof(double)
+			                 - euclidean_vector_batch::alignment;
+			if (dim != 0 and itos(size) > max / itos(dim)) {
+				auto err_msg = std::to_string(size) + " vectors of " + std::to_string(dim)
+				               + " dimensions are too many for one euclidean_vector_batch";
+				throw euclidean_vector_error(err_msg);
+			}
+			return itos(size) * itos(dim);
+		}
+
+		// A row-major copy of a column-major batch.
+		auto transposed(euclidean_vector_batch const& batch) -> euclidean_vector_batch {
+			auto rows = euclidean_vector_batch(batch.size(),
+			                                   batch.dimensions(),
+			                                   batch_layout::row_major,
+			                                   batch.get_allocator());
+			auto const size = itos(batch.size());
+			auto const dims = itos(batch.dimensions());
+			auto const in = batch.data();
+			auto const out = rows.data();
+			for (auto d = std::size_t{0}; d < dims; ++d) {
+				for (auto i = std::size_t{0}; i < size; ++i) {
+					out[i * dims + d] = in[d * size + i];
+				}
+			}
+			return rows;
+		}
+
+		auto check_output(euclidean_vector_batch const& batch, std::span<double> out) -> void {
+			if (out.size() != itos(batch.size())) {
+				auto err_msg = "Output of size " + std::to_string(out.size())
+				               + " does not match euclidean_vector_batch of size "
+				               + std::to_string(batch.size());
+				throw euclidean_vector_error(err_msg);
+			}
+		}
+	} // namespace
+
+	// ========================== CONSTRUCTORS ==========================
+	euclidean_vector_batch::euclidean_vector_batch(int size,
+	                                               int dim,
+	                                               batch_layout layout,
+	                                               allocator_type const& alloc)
+	: size_{itos(size)}
+	, dimensions_{itos(dim)}
+	, layout_{layout}
+	, resource_{alloc.resource()} {
+		auto const elements = checked_elements(size, dim);
+		if (elements != 0) {
+			magnitudes_ = static_cast<double*>(resource_->allocate(buffer_bytes(elements), alignment));
+			std::fill_n(magnitudes_, elements, 0.0);
+		}
+	}
+
+	// COPY CONSTRUCTOR
+	euclidean_vector_batch::euclidean_vector_batch(euclidean_vector_batch const& to_copy)
+	: euclidean_vector_batch(to_copy.size(), to_copy.dimensions(), to_copy.layout_) {
+		std::copy_n(to_copy.magnitudes_, size_ * dimensions_, magnitudes_);
+	}
+
+	// MOVE CONSTRUCTOR
+	euclidean_vector_batch::euclidean_vector_batch(euclidean_vector_batch&& to_move) noexcept
+	: magnitudes_{std::exchange(to_move.magnitudes_, nullptr)}
+	, size_{std::exchange(to_move.size_, 0)}
+	, dimensions_{std::exchange(to_move.dimensions_, 0)}
+	, layout_{to_move.layout_}
+	, resource_{to_move.resource_} {}
+
+	// DESTRUCTOR
+	euclidean_vector_batch::~euclidean_vector_batch() {
+		this->release();
+	}
+
+	// =========================== OPERATORS ===========================
+	// COPY OPERATOR
+	auto euclidean_vector_batch::operator=(euclidean_vector_batch const& to_copy)
+	   -> euclidean_vector_batch& {
+		if (this != &to_copy) {
+			auto copy = euclidean_vector_batch(to_copy.size(),
+			                                   to_copy.dimensions(),
+			                                   to_copy.layout_,
+			                                   allocator_type(resource_));
+			std::copy_n(to_copy.magnitudes_, to_copy.size_ * to_copy.dimensions_, copy.magnitudes_);
+			*this = std::move(copy);
+		}
+		return *this;
+	}
+
+	// MOVE OPERATOR
+	// As with euclidean_vector, the target keeps its resource. A buffer from a different resource
+	// can't be adopted, so its elements are copied into one from this resource. Running out of
+	// memory there terminates rather than leaving a half-moved batch behind.
+	auto euclidean_vector_batch::operator=(euclidean_vector_batch&& to_move) noexcept
+	   -> euclidean_vector_batch& {
+		if (this == &to_move) {
+			return *this;
+		}
+		if (*resource_ != *to_move.resource_) {
+			auto copy = euclidean_vector_batch(to_move.size(),
+			                                   to_move.dimensions(),
+			                                   to_move.layout_,
+			                                   allocator_type(resource_));
+			std::copy_n(to_move.magnitudes_, to_move.size_ * to_move.dimensions_, copy.magnitudes_);
+			to_move.release();
+			to_move.size_ = 0;
+			to_move.dimensions_ = 0;
+			return *this = std::move(copy);
+		}
+		this->release();
+		magnitudes_ = std::exchange(to_move.magnitudes_, nullptr);
+		size_ = std::exchange(to_move.size_, 0);
+		dimensions_ = std::exchange(to_move.dimensions_, 0);
+		layout_ = to_move.layout_;
+		return *this;
+	}
+
+	// =========================== MEMBER FUNCTIONS ===========================
+	auto euclidean_vector_batch::at(int row, int dim) -> double& {
+		// The const overload does the validation.
+		std::ignore = std::as_const(*this).at(row, dim);
+		return magnitudes_[element(itos(row), itos(dim))];
+	}
+
+	auto euclidean_vector_batch::at(int row, int dim) const -> double {
+		if (row < 0 or row >= this->size() or dim < 0 or dim >= this->dimensions()) {
+			auto err_msg = "Index (" + std::to_string(row) + ", " + std::to_string(dim)
+			               + ") is not valid for this euclidean_vector_batch object";
+			throw euclidean_vector_error(err_msg);
+		}
+		return magnitudes_[element(itos(row), itos(dim))];
+	}
+
+	auto euclidean_vector_batch::row(int i) -> std::span<double> {
+		// The const overload does the validation.
+		std::ignore = std::as_const(*this).row(i);
+		return this->data().subspan(itos(i) * dimensions_, dimensions_);
+	}
+
+	auto euclidean_vector_batch::row(int i) const -> std::span<double const> {
+		this->check_row(i);
+		if (layout_ == batch_layout::column_major) {
+			const auto* err_msg = "Rows of a column_major euclidean_vector_batch are not contiguous";
+			throw euclidean_vector_error(err_msg);
+		}
+		return std::span<double const>(magnitudes_, size_ * dimensions_)
+		   .subspan(itos(i) * dimensions_, dimensions_);
+	}
+
+	auto euclidean_vector_batch::copy_row(int i) const -> euclidean_vector {
+		this->check_row(i);
+		auto ev = euclidean_vector(this->dimensions());
+		auto out = ev.begin();
+		for (auto d = std::size_t{0}; d < dimensions_; ++d, ++out) {
+			*out = magnitudes_[element(itos(i), d)];
+		}
+		return ev;
+	}
+
+	auto euclidean_vector_batch::set_row(int i, euclidean_vector const& ev) -> void {
+		this->check_row(i);
+		euclidean_vector::check_dimensions(this->dimensions(), ev.dimensions());
+		auto in = ev.begin();
+		for (auto d = std::size_t{0}; d < dimensions_; ++d, ++in) {
+			magnitudes_[element(itos(i), d)] = *in;
+		}
+	}
+
+	auto euclidean_vector_batch::data() -> std::span<double> {
+		return {magnitudes_, size_ * dimensions_};
+	}
+
+	auto euclidean_vector_batch::data() const -> std::span<double const> {
+		return {magnitudes_, size_ * dimensions_};
+	}
+
+	auto euclidean_vector_batch::check_row(int i) const -> void {
+		if (i < 0 or i >= this->size()) {
+			auto err_msg =
+			   "Row " + std::to_string(i) + " is not valid for this euclidean_vector_batch object";
+			throw euclidean_vector_error(err_msg);
+		}
+	}
+
+	auto euclidean_vector_batch::element(std::size_t row, std::size_t dim) const -> std::size_t {
+		return layout_ == batch_layout::row_major ? row * dimensions_ + dim : dim * size_ + row;
+	}
+
+	auto euclidean_vector_batch::release() noexcept -> void {
+		if (magnitudes_ != nullptr) {
+			resource_->deallocate(magnitudes_, buffer_bytes(size_ * dimensions_), alignment);
+			magnitudes_ = nullptr;
+		}
+	}
+
+	// =========================== UTILITY ===========================
+	// Row-major batches run one SIMD reduction per row. Column-major batches stream each
+	// dimension's column once and accumulate into every row's result at the same time.
+	auto dot(euclidean_vector_batch const& batch,
+	         euclidean_vector const& query,
+	         std::span<double> out) -> void {
+		euclidean_vector::check_dimensions(batch.dimensions(), query.dimensions());
+		check_output(batch, out);
+		auto const data = batch.data();
+		auto const size = itos(batch.size());
+		auto const dims = itos(batch.dimensions());
+		if (batch.layout() == batch_layout::row_major) {
+			auto const& kernels = kernels::active();
+			for (auto i = std::size_t{0}; i < size; ++i) {
+				out[i] = kernels.dot(data.subspan(i * dims, dims).data(), query.data(), dims);
+			}
+			return;
+		}
+		std::fill(out.begin(), out.end(), 0.0);
+		auto q = query.begin();
+		for (auto d = std::size_t{0}; d < dims; ++d, ++q) {
+			auto const column = data.subspan(d * size, size);
+			std::transform(column.begin(),
+			               column.end(),
+			               out.begin(),
+			               out.begin(),
+			               [&](double a, double b) { return b + a * *q; });
+		}
+	}
+
+	auto dot(euclidean_vector_batch const& batch, euclidean_vector const& query)
+	   -> std::vector<double> {
+		auto out = std::vector<double>(itos(batch.size()));
+		dot(batch, query, out);
+		return out;
+	}
+
+	auto euclidean_norm(euclidean_vector_batch const& batch, std::span<double> out) -> void {
+		check_output(batch, out);
+		auto const data = batch.data();
+		auto const size = itos(batch.size());
+		auto const dims = itos(batch.dimensions());
+		if (batch.layout() == batch_layout::row_major) {
+			auto const& kernels = kernels::active();
+			for (auto i = std::size_t{0}; i < size; ++i) {
+				out[i] = std::sqrt(kernels.sum_squares(data.subspan(i * dims, dims).data(), dims));
+			}
+			return;
+		}
+		std::fill(out.begin(), out.end(), 0.0);
+		for (auto d = std::size_t{0}; d < dims; ++d) {
+			auto const column = data.subspan(d * size, size);
+			std::transform(column.begin(),
+			               column.end(),
+			               out.begin(),
+			               out.begin(),
+			               [](double a, double b) { return b + a * a; });
+		}
+		std::for_each (out.begin(), out.end(), [](double& a) { a = std::sqrt(a); });
+	}
+
+	auto euclidean_norm(euclidean_vector_batch const& batch) -> std::vector<double> {
+		auto out = std::vector<double>(itos(batch.size()));
+		euclidean_norm(batch, out);
+		return out;
+	}
+
+	auto unit(euclidean_vector_batch const& batch) -> euclidean_vector_batch {
+		if (batch.dimensions() == 0) {
+			const auto* err_msg = "euclidean_vector with no dimensions does not have a unit vector";
+			throw euclidean_vector_error(err_msg);
+		}
+		auto const norms = euclidean_norm(batch);
+		if (std::find(norms.begin(), norms.end(), 0.0) != norms.end()) {
+			const auto* err_msg = "euclidean_vector with zero euclidean normal does not have a unit "
+			                      "vector";
+			throw euclidean_vector_error(err_msg);
+		}
+
+		auto result = euclidean_vector_batch(batch);
+		auto const data = result.data();
+		auto const size = itos(batch.size());
+		auto const dims = itos(batch.dimensions());
+		if (batch.layout() == batch_layout::row_major) {
+			auto const& kernels = kernels::active();
+			for (auto i = std::size_t{0}; i < size; ++i) {
+				kernels.divide(data.subspan(i * dims, dims).data(), norms[i], dims);
+			}
+			return result;
+		}
+		for (auto d = std::size_t{0}; d < dims; ++d) {
+			auto const column = data.subspan(d * size, size);
+			std::transform(column.begin(),
+			               column.end(),
+			               norms.begin(),
+			               column.begin(),
+			               [](double a, double norm) { return a / norm; });
+		}
+		return result;
+	}
+
+	// ROW MAJOR
+	auto row_major(euclidean_vector_batch batch) -> euclidean_vector_batch {
+		if (batch.layout() == batch_layout::row_major) {
+			return batch;
+		}
+		return transposed(batch);
+	}
+
+	// ========================== ROW-MAJOR VIEW ==========================
+	row_major_view::row_major_view(euclidean_vector_batch const& batch)
+	: copy_{batch.layout() == batch_layout::row_major ? std::nullopt
+	                                                  : std::optional(transposed(batch))}
+	, data_{copy_ ? std::as_const(*copy_).data() : batch.data()}
+	, size_{itos(batch.size())}
+	, dims_{itos(batch.dimensions())} {}
+} // namespace comp6771
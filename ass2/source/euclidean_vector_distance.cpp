@@ -0,0 +1,246 @@
+#include "comp6771/euclidean_vector_distance.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		// Magnitudes per block of `b` rows: 256 KiB, comfortably inside a per-core L2 cache.
+		constexpr auto block_magnitudes = std::size_t{1} << 15;
+
+		using distance_kernel = auto (*)(double const*, double const*, std::size_t) -> double;
+
+		// The kernel for every metric but cosine, which needs norms as well.
+		auto kernel_for(distance_metric metric) -> distance_kernel {
+			auto const& kernels = kernels::active();
+			switch (metric) {
+			case distance_metric::l1: return kernels.l1_distance;
+			case distance_metric::squared_l2: return kernels.squared_distance;
+			case distance_metric::linf: return kernels.linf_distance;
+			case distance_metric::cosine: break;
+			}
+			return nullptr;
+		}
+
+		auto cosine_distance(double dot, double x_norm, double y_norm) -> double {
+			if (x_norm == 0.0 or y_norm == 0.0) {
+				return 1.0;
+			}
+			return 1.0 - dot / (x_norm * y_norm);
+		}
+
+		auto check_output(std::span<double> out, std::size_t expected, std::string const& what)
+		   -> void {
+			if (out.size() != expected) {
+				auto err_msg =
+				   "Output of size " + std::to_string(out.size()) + " does not match " + what;
+				throw euclidean_vector_error(err_msg);
+			}
+		}
+
+		// Column-major batches: each dimension's column is streamed once, folding into every
+		// row's result at the same time. Cosine also gathers each row's squared norm on the way.
+		auto column_distances(distance_metric metric,
+		                      euclidean_vector_batch const& batch,
+		                      std::span<double const> query,
+		                      std::span<double> out) -> void {
+			auto const data = batch.data();
+			auto const size = itos(batch.size());
+			auto squares = std::vector<double>(metric == distance_metric::cosine ? size : 0);
+			std::fill(out.begin(), out.end(), 0.0);
+			for (auto d = std::size_t{0}; d < query.size(); ++d) {
+				auto const column = data.subspan(d * size, size);
+				auto const q = query[d];
+				auto const fold = [&](auto f) {
+					std::transform(column.begin(), column.end(), out.begin(), out.begin(), f);
+				};
+				switch (metric) {
+				case distance_metric::l1:
+					fold([q](double a, double b) { return b + std::abs(a - q); });
+					break;
+				case distance_metric::squared_l2:
+					fold([q](double a, double b) { return b + (a - q) * (a - q); });
+					break;
+				case distance_metric::linf:
+					// As linf_distance does: a NaN anywhere makes the result NaN.
+					fold([q](double a, double b) {
+						auto const diff = std::abs(a - q);
+						return std::isnan(diff) ? diff : std::max(b, diff);
+					});
+					break;
+				case distance_metric::cosine:
+					fold([q](double a, double b) { return b + a * q; });
+					std::transform(column.begin(),
+					               column.end(),
+					               squares.begin(),
+					               squares.begin(),
+					               [](double a, double b) { return b + a * a; });
+					break;
+				}
+			}
+			if (metric == distance_metric::cosine) {
+				auto const query_norm =
+				   std::sqrt(kernels::active().sum_squares(query.data(), query.size()));
+				for (auto i = std::size_t{0}; i < size; ++i) {
+					out[i] = cosine_distance(out[i], std::sqrt(squares[i]), query_norm);
+				}
+			}
+		}
+
+		// The norm of every row, when the metric needs them.
+		auto norms_of(distance_metric metric, row_major_view const& rows) -> std::vector<double> {
+			auto norms = std::vector<double>();
+			if (metric == distance_metric::cosine) {
+				auto const& kernels = kernels::active();
+				norms.reserve(rows.size());
+				for (auto i = std::size_t{0}; i < rows.size(); ++i) {
+					norms.push_back(std::sqrt(kernels.sum_squares(rows.row(i).data(), rows.dims())));
+				}
+			}
+			return norms;
+		}
+
+		// Rows [first, last) of `a` against every row of `b`, one cache-sized block of `b` at a
+		// time.
+		auto pairwise_rows(distance_metric metric,
+		                   row_major_view const& a,
+		                   row_major_view const& b,
+		                   std::span<double const> a_norms,
+		                   std::span<double const> b_norms,
+		                   std::size_t first,
+		                   std::size_t last,
+		                   std::span<double> out) -> void {
+			auto const dims = a.dims();
+			auto const block = std::max(block_magnitudes / std::max(dims, std::size_t{1}),
+			                            std::size_t{1});
+			auto const& kernels = kernels::active();
+			auto const kernel = kernel_for(metric);
+			for (auto j0 = std::size_t{0}; j0 < b.size(); j0 += block) {
+				auto const j1 = std::min(j0 + block, b.size());
+				for (auto i = first; i < last; ++i) {
+					auto const result = out.subspan(i * b.size(), b.size());
+					auto const* const x = a.row(i).data();
+					if (kernel != nullptr) {
+						for (auto j = j0; j < j1; ++j) {
+							result[j] = kernel(x, b.row(j).data(), dims);
+						}
+						continue;
+					}
+					for (auto j = j0; j < j1; ++j) {
+						auto const dot = kernels.dot(x, b.row(j).data(), dims);
+						result[j] = cosine_distance(dot, a_norms[i], b_norms[j]);
+					}
+				}
+			}
+		}
+
+		auto pairwise(thread_pool& pool,
+		              distance_metric metric,
+		              euclidean_vector_batch const& a,
+		              euclidean_vector_batch const& b,
+		              std::span<double> out) -> void {
+			euclidean_vector::check_dimensions(a.dimensions(), b.dimensions());
+			check_output(out,
+			             itos(a.size()) * itos(b.size()),
+			             std::to_string(a.size()) + "x" + std::to_string(b.size()) + " distances");
+			auto const rows_a = row_major_view(a);
+			auto const rows_b = row_major_view(b);
+			auto const norms_a = norms_of(metric, rows_a);
+			auto const norms_b = norms_of(metric, rows_b);
+			// Enough rows of `a` per task to cover about one parallel chunk of magnitudes.
+			auto const per_row = std::max(rows_b.size() * rows_a.dims(), std::size_t{1});
+			auto const task_rows = std::max(parallel_chunk / per_row, std::size_t{1});
+			auto const tasks = (rows_a.size() + task_rows - 1) / task_rows;
+			pool.run(tasks, [&](std::size_t t) {
+				auto const first = t * task_rows;
+				auto const last = std::min(first + task_rows, rows_a.size());
+				pairwise_rows(metric, rows_a, rows_b, norms_a, norms_b, first, last, out);
+			});
+		}
+	} // namespace
+
+	// =========================== UTILITY ===========================
+	// DISTANCES
+	auto distances(distance_metric metric,
+	               euclidean_vector_batch const& batch,
+	               std::span<double const> query,
+	               std::span<double> out) -> void {
+		euclidean_vector::check_dimensions(batch.dimensions(), static_cast<int>(query.size()));
+		check_output(out,
+		             itos(batch.size()),
+		             "euclidean_vector_batch of size " + std::to_string(batch.size()));
+		if (batch.layout() == batch_layout::column_major) {
+			column_distances(metric, batch, query, out);
+			return;
+		}
+		auto const data = batch.data();
+		auto const dims = query.size();
+		if (auto const kernel = kernel_for(metric); kernel != nullptr) {
+			for (auto i = std::size_t{0}; i < out.size(); ++i) {
+				out[i] = kernel(data.subspan(i * dims, dims).data(), query.data(), dims);
+			}
+			return;
+		}
+		auto const& kernels = kernels::active();
+		auto const query_norm = std::sqrt(kernels.sum_squares(query.data(), dims));
+		for (auto i = std::size_t{0}; i < out.size(); ++i) {
+			auto const sums = kernels.dot_and_squares(data.subspan(i * dims, dims).data(),
+			                                          query.data(),
+			                                          dims);
+			out[i] = cosine_distance(sums.dot, std::sqrt(sums.x_squares), query_norm);
+		}
+	}
+
+	auto distances(distance_metric metric,
+	               euclidean_vector_batch const& batch,
+	               euclidean_vector const& query,
+	               std::span<double> out) -> void {
+		auto const magnitudes = std::span<double const>(query.data(), itos(query.dimensions()));
+		distances(metric, batch, magnitudes, out);
+	}
+
+	auto distances(distance_metric metric,
+	               euclidean_vector_batch const& batch,
+	               euclidean_vector const& query) -> std::vector<double> {
+		auto out = std::vector<double>(itos(batch.size()));
+		distances(metric, batch, query, out);
+		return out;
+	}
+
+	// PAIRWISE DISTANCES
+	auto pairwise_distances(distance_metric metric,
+	                        euclidean_vector_batch const& a,
+	                        euclidean_vector_batch const& b,
+	                        std::span<double> out) -> void {
+		auto one = thread_pool(1);
+		pairwise(one, metric, a, b, out);
+	}
+
+	auto pairwise_distances(distance_metric metric,
+	                        euclidean_vector_batch const& a,
+	                        euclidean_vector_batch const& b) -> euclidean_matrix {
+		auto one = thread_pool(1);
+		return pairwise_distances(parallel_policy{&one}, metric, a, b);
+	}
+
+	auto pairwise_distances(parallel_policy const& policy,
+	                        distance_metric metric,
+	                        euclidean_vector_batch const& a,
+	                        euclidean_vector_batch const& b,
+	                        std::span<double> out) -> void {
+		pairwise(pool_of(policy), metric, a, b, out);
+	}
+
+	auto pairwise_distances(parallel_policy const& policy,
+	                        distance_metric metric,
+	                        euclidean_vector_batch const& a,
+	                        euclidean_vector_batch const& b) -> euclidean_matrix {
+		auto result = euclidean_matrix(a.size(), b.size(), a.get_allocator());
+		pairwise(pool_of(policy), metric, a, b, result.data());
+		return result;
+	}
+} // namespace comp6771
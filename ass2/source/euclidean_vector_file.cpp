@@ -0,0 +1,340 @@
+#include "comp6771/euclidean_vector_file.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// Files are read and written as raw bytes.
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+
+namespace comp6771 {
+	namespace {
+		constexpr auto magic = std::array<char, 8>{'C', 'S', '6', '7', '7', '1', 'E', 'V'};
+		constexpr auto little_endian = std::endian::native == std::endian::little;
+
+		auto byteswap(std::uint64_t x) -> std::uint64_t {
+			auto result = std::uint64_t{0};
+			for (auto i = 0; i < 8; ++i) {
+				result = (result << 8U) | (x & 0xFFU);
+				x >>= 8U;
+			}
+			return result;
+		}
+
+		// Converts magnitudes between host and file byte order in place; the swap is its own inverse.
+		auto swap_to_file_order(std::span<double> magnitudes) -> void {
+			if constexpr (not little_endian) {
+				for (auto& d : magnitudes) {
+					d = std::bit_cast<double>(byteswap(std::bit_cast<std::uint64_t>(d)));
+				}
+			}
+		}
+
+		template<typename T>
+		auto store(std::span<char> out, T value) -> void {
+			for (auto& byte : out.first(sizeof(T))) {
+				byte = static_cast<char>(value & 0xFFU);
+				value >>= 8U;
+			}
+		}
+
+		template<typename T>
+		auto load(std::span<char const> in) -> T {
+			auto value = T{0};
+			for (auto i = sizeof(T); i-- > 0;) {
+				value = static_cast<T>((value << 8U) | static_cast<unsigned char>(in[i]));
+			}
+			return value;
+		}
+
+		auto encode(euclidean_vector_file_header const& header)
+		   -> std::array<char, euclidean_vector_file_header::size> {
+			auto bytes = std::array<char, euclidean_vector_file_header::size>{};
+			auto const out = std::span(bytes);
+			std::copy(magic.begin(), magic.end(), out.begin());
+			store(out.subspan(8), header.version);
+			store(out.subspan(12), static_cast<std::uint32_t>(euclidean_vector_file_header::size));
+			store(out.subspan(16), header.count);
+			store(out.subspan(24), header.dimensions);
+			store(out.subspan(32), header.data_offset);
+			return bytes;
+		}
+
+		[[noreturn]] auto invalid(std::filesystem::path const& path, std::string const& why) -> void {
+			auto err_msg = path.string() + " is not a valid euclidean_vector file: " + why;
+			throw euclidean_vector_error(err_msg);
+		}
+
+		// Validates the header against the size of the file it came from.
+		auto decode(std::filesystem::path const& path,
+		            std::span<char const> bytes,
+		            std::uintmax_t file_bytes) -> euclidean_vector_file_header {
+			if (bytes.size() < euclidean_vector_file_header::size
+			    or not std::equal(magic.begin(), magic.end(), bytes.begin()))
+			{
+				invalid(path, "bad magic");
+			}
+			auto header = euclidean_vector_file_header{};
+			header.version = load<std::uint32_t>(bytes.subspan(8));
+			if (header.version != euclidean_vector_file_header::current_version) {
+				invalid(path, "unsupported version " + std::to_string(header.version));
+			}
+			if (load<std::uint32_t>(bytes.subspan(12)) != euclidean_vector_file_header::size) {
+				invalid(path, "bad header size");
+			}
+			header.count = load<std::uint64_t>(bytes.subspan(16));
+			header.dimensions = load<std::uint64_t>(bytes.subspan(24));
+			header.data_offset = load<std::uint64_t>(bytes.subspan(32));
+			if (header.data_offset < euclidean_vector_file_header::size
+			    or header.data_offset % euclidean_vector_file_header::size != 0)
+			{
+				invalid(path, "misaligned magnitudes");
+			}
+			// Sizes are ints everywhere else in the library.
+			constexpr auto max_int = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+			if (header.count > max_int) {
+				invalid(path, "too many vectors");
+			}
+			if (header.dimensions > max_int) {
+				invalid(path, "too many dimensions");
+			}
+			constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+			if (header.dimensions != 0 and header.count > max / sizeof(double) / header.dimensions) {
+				invalid(path, "too many magnitudes");
+			}
+			auto const data_bytes = header.count * header.dimensions * sizeof(double);
+			if (file_bytes < header.data_offset or file_bytes - header.data_offset < data_bytes) {
+				invalid(path, "truncated");
+			}
+			return header;
+		}
+
+		auto open_for_reading(std::filesystem::path const& path) -> std::ifstream {
+			auto in = std::ifstream(path, std::ios::binary);
+			if (not in) {
+				throw euclidean_vector_error("Cannot open " + path.string());
+			}
+			return in;
+		}
+
+		auto read_header(std::filesystem::path const& path, std::ifstream& in)
+		   -> euclidean_vector_file_header {
+			auto bytes = std::array<char, euclidean_vector_file_header::size>{};
+			in.read(bytes.data(), bytes.size());
+			auto const read = static_cast<std::size_t>(in.gcount());
+			return decode(path, std::span(bytes).first(read), std::filesystem::file_size(path));
+		}
+	} // namespace
+
+	// ========================== WRITER ==========================
+	euclidean_vector_writer::euclidean_vector_writer(std::filesystem::path const& path,
+	                                                 int dimensions)
+	: out_{path, std::ios::binary | std::ios::trunc} {
+		if (not out_) {
+			throw euclidean_vector_error("Cannot open " + path.string());
+		}
+		header_.dimensions = itos(dimensions);
+		auto const bytes = encode(header_);
+		out_.write(bytes.data(), bytes.size());
+	}
+
+	euclidean_vector_writer::~euclidean_vector_writer() {
+		try {
+			this->close();
+		} catch (...) {
+			// Destructors can't report failures; call close() to see them.
+		}
+	}
+
+	auto euclidean_vector_writer::operator=(euclidean_vector_writer&& to_move) noexcept
+	   -> euclidean_vector_writer& {
+		if (this != &to_move) {
+			try {
+				this->close();
+			} catch (...) {
+				// As in the destructor, a failure to finish the old file can't be reported here.
+			}
+			out_ = std::move(to_move.out_);
+			header_ = std::exchange(to_move.header_, {});
+		}
+		return *this;
+	}
+
+	auto euclidean_vector_writer::write(const_euclidean_vector_view v) -> void {
+		euclidean_vector::check_dimensions(v.dimensions(), this->dimensions());
+		this->write_magnitudes(v.magnitudes());
+		++header_.count;
+	}
+
+	auto euclidean_vector_writer::write(euclidean_vector_batch const& batch) -> void {
+		euclidean_vector::check_dimensions(batch.dimensions(), this->dimensions());
+		if (batch.layout() == batch_layout::row_major) {
+			this->write_magnitudes(batch.data());
+		}
+		else {
+			auto row = std::vector<double>(header_.dimensions);
+			for (auto i = 0; i < batch.size(); ++i) {
+				for (auto d = 0; d < batch.dimensions(); ++d) {
+					row[itos(d)] = batch.at(i, d);
+				}
+				this->write_magnitudes(row);
+			}
+		}
+		header_.count += itos(batch.size());
+	}
+
+	auto euclidean_vector_writer::close() -> void {
+		if (not out_.is_open()) {
+			return;
+		}
+		auto const bytes = encode(header_);
+		out_.seekp(0);
+		out_.write(bytes.data(), bytes.size());
+		out_.close();
+		if (not out_) {
+			throw euclidean_vector_error("Failed to write euclidean_vector file");
+		}
+	}
+
+	auto euclidean_vector_writer::write_magnitudes(std::span<double const> magnitudes) -> void {
+		if constexpr (little_endian) {
+			out_.write(reinterpret_cast<char const*>(magnitudes.data()),
+			           static_cast<std::streamsize>(magnitudes.size_bytes()));
+		}
+		else {
+			auto swapped = std::vector<double>(magnitudes.begin(), magnitudes.end());
+			swap_to_file_order(swapped);
+			out_.write(reinterpret_cast<char const*>(swapped.data()),
+			           static_cast<std::streamsize>(magnitudes.size_bytes()));
+		}
+	}
+
+	// ========================== MAPPED FILE ==========================
+	mapped_euclidean_vector_file::mapped_euclidean_vector_file(std::filesystem::path const& path) {
+		if constexpr (not little_endian) {
+			throw euclidean_vector_error("Mapping euclidean_vector files needs a little-endian host");
+		}
+		auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd == -1) {
+			throw euclidean_vector_error("Cannot open " + path.string());
+		}
+		struct stat info {};
+		if (::fstat(fd, &info) == -1 or info.st_size == 0) {
+			::close(fd);
+			invalid(path, "bad magic");
+		}
+		mapping_bytes_ = static_cast<std::size_t>(info.st_size);
+		mapping_ = ::mmap(nullptr, mapping_bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (mapping_ == MAP_FAILED) {
+			mapping_ = nullptr;
+			throw euclidean_vector_error("Cannot map " + path.string());
+		}
+
+		auto const bytes = std::span(static_cast<char const*>(mapping_), mapping_bytes_);
+		try {
+			auto const header = decode(path, bytes, mapping_bytes_);
+			size_ = header.count;
+			dimensions_ = header.dimensions;
+			magnitudes_ = std::span(reinterpret_cast<double const*>(&bytes[header.data_offset]),
+			                        size_ * dimensions_);
+		} catch (...) {
+			this->unmap();
+			throw;
+		}
+		::madvise(mapping_, mapping_bytes_, MADV_WILLNEED);
+	}
+
+	mapped_euclidean_vector_file::mapped_euclidean_vector_file(
+	   mapped_euclidean_vector_file&& to_move) noexcept
+	: mapping_{std::exchange(to_move.mapping_, nullptr)}
+	, mapping_bytes_{std::exchange(to_move.mapping_bytes_, 0)}
+	, magnitudes_{std::exchange(to_move.magnitudes_, {})}
+	, size_{std::exchange(to_move.size_, 0)}
+	, dimensions_{std::exchange(to_move.dimensions_, 0)} {}
+
+	mapped_euclidean_vector_file::~mapped_euclidean_vector_file() {
+		this->unmap();
+	}
+
+	auto mapped_euclidean_vector_file::operator=(mapped_euclidean_vector_file&& to_move) noexcept
+	   -> mapped_euclidean_vector_file& {
+		if (this != &to_move) {
+			this->unmap();
+			mapping_ = std::exchange(to_move.mapping_, nullptr);
+			mapping_bytes_ = std::exchange(to_move.mapping_bytes_, 0);
+			magnitudes_ = std::exchange(to_move.magnitudes_, {});
+			size_ = std::exchange(to_move.size_, 0);
+			dimensions_ = std::exchange(to_move.dimensions_, 0);
+		}
+		return *this;
+	}
+
+	auto mapped_euclidean_vector_file::at(int i) const -> const_euclidean_vector_view {
+		if (i < 0 or i >= this->size()) {
+			auto err_msg =
+			   "Index " + std::to_string(i) + " is not valid for this mapped_euclidean_vector_file";
+			throw euclidean_vector_error(err_msg);
+		}
+		return (*this)[itos(i)];
+	}
+
+	auto mapped_euclidean_vector_file::unmap() noexcept -> void {
+		if (mapping_ != nullptr) {
+			::munmap(mapping_, mapping_bytes_);
+			mapping_ = nullptr;
+		}
+		magnitudes_ = {};
+		size_ = 0;
+		dimensions_ = 0;
+	}
+
+	// =========================== UTILITY ===========================
+	auto read_euclidean_vector_file_header(std::filesystem::path const& path)
+	   -> euclidean_vector_file_header {
+		auto in = open_for_reading(path);
+		return read_header(path, in);
+	}
+
+	auto load_euclidean_vector_batch(std::filesystem::path const& path,
+	                                 euclidean_vector_batch::allocator_type const& alloc)
+	   -> euclidean_vector_batch {
+		auto in = open_for_reading(path);
+		auto const header = read_header(path, in);
+		auto batch = euclidean_vector_batch(static_cast<int>(header.count),
+		                                    static_cast<int>(header.dimensions),
+		                                    batch_layout::row_major,
+		                                    alloc);
+		auto const data = batch.data();
+		in.seekg(static_cast<std::streamoff>(header.data_offset));
+		in.read(reinterpret_cast<char*>(data.data()),
+		        static_cast<std::streamsize>(data.size_bytes()));
+		if (not in) {
+			invalid(path, "truncated");
+		}
+		swap_to_file_order(data);
+		return batch;
+	}
+
+	auto save_euclidean_vector_batch(std::filesystem::path const& path,
+	                                 euclidean_vector_batch const& batch) -> void {
+		auto writer = euclidean_vector_writer(path, batch.dimensions());
+		writer.write(batch);
+		writer.close();
+	}
+} // namespace comp6771
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
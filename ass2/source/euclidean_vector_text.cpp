@@ -0,0 +1,357 @@
+#include "comp6771/euclidean_vector_text.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		// The writer hands the file whole blocks of about this size.
+		constexpr auto write_block_bytes = std::size_t{1} << 20;
+
+		auto is_blank(char c) -> bool {
+			return c == ' ' or c == '\t' or c == '\r';
+		}
+
+		// Where a line came from, for error messages: a line of a file, or of a string.
+		struct line_source {
+			std::filesystem::path const* path;
+			std::size_t line;
+		};
+
+		[[noreturn]] auto invalid(line_source const& source, std::string const& why) -> void {
+			auto where = "Line " + std::to_string(source.line);
+			if (source.path != nullptr) {
+				where = source.path->string() + " line " + std::to_string(source.line);
+			}
+			throw euclidean_vector_error(where + " is not a valid euclidean_vector: " + why);
+		}
+
+		// Appends the magnitudes on one line to `out` and returns how many there were.
+		auto parse_line(std::string_view line,
+		                char delimiter,
+		                line_source const& source,
+		                std::vector<double>& out) -> std::size_t {
+			auto const* first = line.data();
+			auto const* const last = first + line.size();
+			auto const skip_blanks = [&] {
+				while (first != last and is_blank(*first)) {
+					++first;
+				}
+			};
+			auto const blank_delimited = is_blank(delimiter);
+			auto const before = out.size();
+
+			skip_blanks();
+			if (first == last) {
+				return 0;
+			}
+			while (true) {
+				auto value = 0.0;
+				auto const [end, ec] = std::from_chars(first, last, value);
+				if (ec == std::errc::result_out_of_range) {
+					invalid(source, "magnitude out of range");
+				}
+				if (ec != std::errc{}) {
+					invalid(source, "expected a magnitude");
+				}
+				out.push_back(value);
+				first = end;
+				skip_blanks();
+				if (first == last) {
+					return out.size() - before;
+				}
+				if (not blank_delimited) {
+					if (*first != delimiter) {
+						invalid(source, "unexpected '" + std::string(1, *first) + "'");
+					}
+					++first;
+					skip_blanks();
+				}
+			}
+		}
+
+		// The first non-empty line sets the dimensions every later one must match.
+		auto check_row(std::size_t n, std::size_t& dimensions, line_source const& source) -> void {
+			if (dimensions == 0) {
+				dimensions = n;
+			}
+			else if (n != dimensions) {
+				invalid(source,
+				        std::to_string(n) + " magnitudes where the first vector had "
+				           + std::to_string(dimensions));
+			}
+		}
+
+		auto to_batch(std::span<double const> magnitudes, std::size_t rows, std::size_t dims)
+		   -> euclidean_vector_batch {
+			auto batch = euclidean_vector_batch(static_cast<int>(rows), static_cast<int>(dims));
+			std::copy(magnitudes.begin(), magnitudes.end(), batch.data().begin());
+			return batch;
+		}
+	} // namespace
+
+	// ========================== FORMATTING ==========================
+	auto to_chars(char* first, char* last, const_euclidean_vector_view v, char delimiter)
+	   -> std::to_chars_result {
+		auto const magnitudes = v.magnitudes();
+		for (auto i = std::size_t{0}; i < magnitudes.size(); ++i) {
+			if (i != 0) {
+				if (first == last) {
+					return {last, std::errc::value_too_large};
+				}
+				*first++ = delimiter;
+			}
+			auto const result = std::to_chars(first, last, magnitudes[i]);
+			if (result.ec != std::errc{}) {
+				return result;
+			}
+			first = result.ptr;
+		}
+		return {first, std::errc{}};
+	}
+
+	auto euclidean_vector_formatter::format(const_euclidean_vector_view v) -> std::string_view {
+		buffer_.resize(itos(v.dimensions()) * (max_magnitude_chars + 1));
+		auto* const first = buffer_.data();
+		auto const result = to_chars(first, first + buffer_.size(), v, delimiter_);
+		return {first, static_cast<std::size_t>(result.ptr - first)};
+	}
+
+	// ========================== WRITER ==========================
+	euclidean_vector_text_writer::euclidean_vector_text_writer(std::filesystem::path const& path,
+	                                                           char delimiter)
+	: out_{path, std::ios::binary | std::ios::trunc}
+	, delimiter_{delimiter} {
+		if (not out_) {
+			throw euclidean_vector_error("Cannot open " + path.string());
+		}
+		buffer_.reserve(write_block_bytes);
+	}
+
+	euclidean_vector_text_writer::~euclidean_vector_text_writer() {
+		try {
+			this->close();
+		} catch (...) {
+			// Destructors can't report failures; call close() to see them.
+		}
+	}
+
+	auto euclidean_vector_text_writer::operator=(euclidean_vector_text_writer&& to_move) noexcept
+	   -> euclidean_vector_text_writer& {
+		if (this != &to_move) {
+			try {
+				this->close();
+			} catch (...) {
+				// As in the destructor, a failure to finish the old file can't be reported here.
+			}
+			out_ = std::move(to_move.out_);
+			delimiter_ = to_move.delimiter_;
+			buffer_ = std::move(to_move.buffer_);
+			count_ = std::exchange(to_move.count_, 0);
+		}
+		return *this;
+	}
+
+	auto euclidean_vector_text_writer::write(const_euclidean_vector_view v) -> void {
+		if (v.dimensions() == 0) {
+			const auto* err_msg = "euclidean_vector with no dimensions can't be written as text";
+			throw euclidean_vector_error(err_msg);
+		}
+		// Formats straight into the end of the buffer, then trims it to what was written.
+		auto const used = buffer_.size();
+		buffer_.resize(used + itos(v.dimensions()) * (max_magnitude_chars + 1) + 1);
+		auto* const first = buffer_.data() + used;
+		auto const result = to_chars(first, buffer_.data() + buffer_.size(), v, delimiter_);
+		*result.ptr = '\n';
+		buffer_.resize(static_cast<std::size_t>(result.ptr + 1 - buffer_.data()));
+		++count_;
+		if (buffer_.size() >= write_block_bytes) {
+			this->flush();
+		}
+	}
+
+	auto euclidean_vector_text_writer::write(euclidean_vector_batch const& batch) -> void {
+		for (auto i = 0; i < batch.size(); ++i) {
+			if (batch.layout() == batch_layout::row_major) {
+				this->write(const_euclidean_vector_view(batch.row(i)));
+			}
+			else {
+				this->write(batch.copy_row(i));
+			}
+		}
+	}
+
+	auto euclidean_vector_text_writer::close() -> void {
+		if (not out_.is_open()) {
+			return;
+		}
+		this->flush();
+		out_.close();
+		if (not out_) {
+			throw euclidean_vector_error("Failed to write euclidean_vector text file");
+		}
+	}
+
+	auto euclidean_vector_text_writer::flush() -> void {
+		out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+		buffer_.clear();
+	}
+
+	// ========================== PARSING ==========================
+	auto parse_euclidean_vector(std::string_view text, char delimiter) -> euclidean_vector {
+		if (text.ends_with('\n')) {
+			text.remove_suffix(1);
+		}
+		auto magnitudes = std::vector<double>();
+		auto const source = line_source{nullptr, 1};
+		if (parse_line(text, delimiter, source, magnitudes) == 0) {
+			invalid(source, "no magnitudes");
+		}
+		return euclidean_vector(std::move(magnitudes));
+	}
+
+	auto parse_euclidean_vector_batch(std::string_view text, char delimiter)
+	   -> euclidean_vector_batch {
+		auto magnitudes = std::vector<double>();
+		auto rows = std::size_t{0};
+		auto dimensions = std::size_t{0};
+		auto line_number = std::size_t{0};
+		while (not text.empty()) {
+			auto const newline = std::min(text.find('\n'), text.size());
+			auto const source = line_source{nullptr, ++line_number};
+			if (auto const n = parse_line(text.substr(0, newline), delimiter, source, magnitudes)) {
+				check_row(n, dimensions, source);
+				++rows;
+			}
+			text.remove_prefix(std::min(newline + 1, text.size()));
+		}
+		return to_batch(magnitudes, rows, dimensions);
+	}
+
+	auto load_euclidean_vector_text(std::filesystem::path const& path, char delimiter)
+	   -> euclidean_vector_batch {
+		auto reader = euclidean_vector_text_reader(path, delimiter);
+		return reader.read(std::numeric_limits<int>::max());
+	}
+
+	// ========================== READER ==========================
+	euclidean_vector_text_reader::euclidean_vector_text_reader(std::filesystem::path const& path,
+	                                                           char delimiter,
+	                                                           std::size_t block_bytes)
+	: in_{path, std::ios::binary}
+	, path_{path}
+	, delimiter_{delimiter}
+	, block_(std::max(block_bytes, std::size_t{1})) {
+		if (not in_) {
+			throw euclidean_vector_error("Cannot open " + path.string());
+		}
+	}
+
+	auto euclidean_vector_text_reader::read(euclidean_vector& v) -> bool {
+		if (not this->parse_next()) {
+			return false;
+		}
+		if (itos(v.dimensions()) != magnitudes_.size()) {
+			v = euclidean_vector(static_cast<int>(magnitudes_.size()));
+		}
+		std::copy(magnitudes_.begin(), magnitudes_.end(), v.begin());
+		return true;
+	}
+
+	auto euclidean_vector_text_reader::read(int max_rows) -> euclidean_vector_batch {
+		auto magnitudes = std::vector<double>();
+		auto rows = std::size_t{0};
+		while (static_cast<int>(rows) < max_rows and this->parse_next()) {
+			magnitudes.insert(magnitudes.end(), magnitudes_.begin(), magnitudes_.end());
+			++rows;
+		}
+		return to_batch(magnitudes, rows, rows == 0 ? 0 : dimensions_);
+	}
+
+	// Points line_ at the next line, refilling the block from the file when it holds no whole
+	// line. The last line needn't end in a newline.
+	auto euclidean_vector_text_reader::next_line() -> bool {
+		while (true) {
+			auto* const data = block_.data();
+			auto const* const newline =
+			   static_cast<char const*>(std::memchr(data + begin_, '\n', end_ - begin_));
+			if (newline != nullptr) {
+				auto const length = static_cast<std::size_t>(newline - (data + begin_));
+				line_ = std::string_view(data + begin_, length);
+				begin_ += length + 1;
+				++line_number_;
+				return true;
+			}
+			if (not in_) {
+				if (begin_ == end_) {
+					return false;
+				}
+				line_ = std::string_view(data + begin_, end_ - begin_);
+				begin_ = end_;
+				++line_number_;
+				return true;
+			}
+
+			// Keep the partial line, and make room for the rest of it.
+			std::copy(data + begin_, data + end_, data);
+			end_ -= begin_;
+			begin_ = 0;
+			if (end_ == block_.size()) {
+				block_.resize(block_.size() * 2);
+			}
+			in_.read(block_.data() + end_, static_cast<std::streamsize>(block_.size() - end_));
+			end_ += static_cast<std::size_t>(in_.gcount());
+		}
+	}
+
+	// Parses lines into magnitudes_ until one isn't empty.
+	auto euclidean_vector_text_reader::parse_next() -> bool {
+		while (this->next_line()) {
+			magnitudes_.clear();
+			auto const source = line_source{&path_, line_number_};
+			auto const n = parse_line(line_, delimiter_, source, magnitudes_);
+			if (n != 0) {
+				check_row(n, dimensions_, source);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// INPUT STREAM OPERATOR
+	auto operator>>(std::istream& is, euclidean_vector& v) -> std::istream& {
+		auto open = char{};
+		if (not(is >> open) or open != '[') {
+			is.setstate(std::ios::failbit);
+			return is;
+		}
+		auto body = std::string();
+		// getline only reaches the end of the stream when there was no ']'.
+		if (not std::getline(is, body, ']') or is.eof()) {
+			is.setstate(std::ios::failbit);
+			return is;
+		}
+		// "[]" is how operator<< prints a vector with no dimensions.
+		if (std::all_of(body.begin(), body.end(), is_blank)) {
+			v = euclidean_vector(0);
+			return is;
+		}
+		try {
+			v = parse_euclidean_vector(body, ' ');
+		} catch (euclidean_vector_error const&) {
+			is.setstate(std::ios::failbit);
+		}
+		return is;
+	}
+} // namespace comp6771
@@ -0,0 +1,592 @@
+#include "comp6771/hnsw_index.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// The graph is saved and loaded as raw bytes.
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+
+namespace comp6771 {
+	namespace {
+		// ========================== FILE FORMAT ==========================
+		// offset 0   64-byte header, every integer little-endian
+		//               8 bytes  magic "CS6771HN"
+		//               4 bytes  version (1)
+		//               4 bytes  metric (0 l2, 1 cosine)
+		//               4 bytes  m
+		//               4 bytes  ef_construction
+		//               8 bytes  seed
+		//               8 bytes  dimensions
+		//               8 bytes  count
+		//               4 bytes  entry point
+		//               4 bytes  top level
+		//               8 bytes  zero
+		// offset 64  count * dimensions little-endian doubles, as stored (normalised for cosine)
+		//            then per vector: 4-byte level, and per layer a 4-byte link count and the links
+		constexpr auto magic = std::array<char, 8>{'C', 'S', '6', '7', '7', '1', 'H', 'N'};
+		constexpr auto version = std::uint32_t{1};
+		constexpr auto header_size = std::size_t{64};
+		constexpr auto little_endian = std::endian::native == std::endian::little;
+		// A level is -log(u) / log(m) for a uniform u of at most 64 bits and m of at least 2, so
+		// no layer above 64 is ever drawn.
+		constexpr auto max_level = 64;
+
+		template<typename T>
+		auto write_le(std::ostream& out, T value) -> void {
+			auto bytes = std::array<char, sizeof(T)>{};
+			for (auto& byte : bytes) {
+				byte = static_cast<char>(value & 0xFFU);
+				value >>= 8U;
+			}
+			out.write(bytes.data(), bytes.size());
+		}
+
+		template<typename T>
+		auto read_le(std::istream& in) -> T {
+			auto bytes = std::array<char, sizeof(T)>{};
+			in.read(bytes.data(), bytes.size());
+			auto value = T{0};
+			for (auto i = sizeof(T); i-- > 0;) {
+				value = static_cast<T>((value << 8U) | static_cast<unsigned char>(bytes[i]));
+			}
+			return value;
+		}
+
+		[[noreturn]] auto invalid(std::filesystem::path const& path, std::string const& why) -> void {
+			auto err_msg = path.string() + " is not a valid hnsw_index file: " + why;
+			throw euclidean_vector_error(err_msg);
+		}
+
+		// Per-thread visited marks, stamped with a new epoch per search instead of being cleared.
+		auto visited_marks(std::size_t size)
+		   -> std::pair<std::vector<std::uint32_t>&, std::uint32_t> {
+			thread_local auto marks = std::vector<std::uint32_t>();
+			thread_local auto epoch = std::uint32_t{0};
+			if (marks.size() < size) {
+				marks.resize(size, 0);
+			}
+			if (++epoch == 0) {
+				std::fill(marks.begin(), marks.end(), 0);
+				epoch = 1;
+			}
+			return {marks, epoch};
+		}
+
+		auto lock_if(std::mutex& m, bool concurrent) -> std::unique_lock<std::mutex> {
+			return concurrent ? std::unique_lock(m) : std::unique_lock<std::mutex>();
+		}
+
+		auto check_search(int k, int ef) -> std::size_t {
+			if (k < 0) {
+				auto err_msg = "Invalid k (" + std::to_string(k) + ") for an hnsw_index search";
+				throw euclidean_vector_error(err_msg);
+			}
+			return itos(std::max(k, ef));
+		}
+	} // namespace
+
+	// ========================== CONSTRUCTORS ==========================
+	hnsw_index::hnsw_index(int dimensions, knn_metric metric, hnsw_parameters parameters)
+	: dimensions_{itos(dimensions)}
+	, metric_{metric}
+	, parameters_{parameters}
+	, levels_{parameters.seed} {
+		if (parameters_.m < 2 or parameters_.ef_construction < 1) {
+			const auto* err_msg = "hnsw_index needs m of at least 2 and a positive ef_construction";
+			throw euclidean_vector_error(err_msg);
+		}
+	}
+
+	// =========================== MEMBER FUNCTIONS ===========================
+	auto hnsw_index::insert(const_euclidean_vector_view v) -> int {
+		euclidean_vector::check_dimensions(v.dimensions(), this->dimensions());
+		auto const id = this->reserve(v.magnitudes());
+		this->link(id, false);
+		return static_cast<int>(id);
+	}
+
+	auto hnsw_index::insert(euclidean_vector_batch const& batch) -> void {
+		auto one = thread_pool(1);
+		this->insert(parallel_policy{&one}, batch);
+	}
+
+	// Every vector is stored and given its level up front, in order, so the concurrent phase only
+	// adds links and never reallocates.
+	auto hnsw_index::insert(parallel_policy const& policy, euclidean_vector_batch const& batch)
+	   -> void {
+		euclidean_vector::check_dimensions(batch.dimensions(), this->dimensions());
+		auto const first = nodes_.size();
+		auto const count = itos(batch.size());
+		vectors_.reserve(vectors_.size() + count * dimensions_);
+		auto row = std::vector<double>(dimensions_);
+		for (auto i = 0; i < batch.size(); ++i) {
+			for (auto d = 0; d < batch.dimensions(); ++d) {
+				row[itos(d)] = batch.at(i, d);
+			}
+			this->reserve(row);
+		}
+		auto& pool = pool_of(policy);
+		auto const concurrent = pool.size() > 1;
+		pool.run(count, [&](std::size_t i) {
+			this->link(static_cast<id_type>(first + i), concurrent);
+		});
+	}
+
+	auto hnsw_index::search(const_euclidean_vector_view query, int k, int ef) const
+	   -> std::vector<knn_neighbour> {
+		euclidean_vector::check_dimensions(query.dimensions(), this->dimensions());
+		auto const width = check_search(k, ef);
+		if (entry_ == no_entry) {
+			return {};
+		}
+		auto const q = this->prepare(query.magnitudes());
+		if (metric_ == knn_metric::cosine and q.squares == 0.0) {
+			const auto* err_msg = "euclidean_vector with zero euclidean normal does not have a "
+			                      "cosine similarity";
+			throw euclidean_vector_error(err_msg);
+		}
+		auto entry = candidate{this->distance(q.magnitudes.data(), q.squares, entry_), entry_};
+		for (auto layer = top_level_; layer > 0; --layer) {
+			entry = this->greedy(q.magnitudes.data(), q.squares, entry, layer, false);
+		}
+		auto const found =
+		   this->search_layer(q.magnitudes.data(), q.squares, {entry}, width, 0, false);
+
+		auto result = std::vector<knn_neighbour>();
+		for (auto const& c : std::span(found).first(std::min(found.size(), itos(k)))) {
+			auto const distance = metric_ == knn_metric::l2 ? std::sqrt(c.distance) : c.distance;
+			result.push_back({static_cast<int>(c.id), distance});
+		}
+		return result;
+	}
+
+	auto hnsw_index::search(parallel_policy const& policy,
+	                        euclidean_vector_batch const& queries,
+	                        int k,
+	                        int ef) const -> std::vector<std::vector<knn_neighbour>> {
+		euclidean_vector::check_dimensions(queries.dimensions(), this->dimensions());
+		std::ignore = check_search(k, ef);
+		auto results = std::vector<std::vector<knn_neighbour>>(itos(queries.size()));
+		auto& pool = pool_of(policy);
+		pool.run(results.size(), [&](std::size_t i) {
+			auto const query = queries.copy_row(static_cast<int>(i));
+			results[i] = this->search(query, k, ef);
+		});
+		return results;
+	}
+
+	auto hnsw_index::save(std::filesystem::path const& path) const -> void {
+		auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+		if (not out) {
+			throw euclidean_vector_error("Cannot open " + path.string());
+		}
+		out.write(magic.data(), magic.size());
+		write_le(out, version);
+		write_le(out, static_cast<std::uint32_t>(metric_));
+		write_le(out, static_cast<std::uint32_t>(parameters_.m));
+		write_le(out, static_cast<std::uint32_t>(parameters_.ef_construction));
+		write_le(out, parameters_.seed);
+		write_le(out, static_cast<std::uint64_t>(dimensions_));
+		write_le(out, static_cast<std::uint64_t>(nodes_.size()));
+		write_le(out, entry_);
+		write_le(out, static_cast<std::uint32_t>(top_level_));
+		write_le(out, std::uint64_t{0});
+
+		if constexpr (little_endian) {
+			out.write(reinterpret_cast<char const*>(vectors_.data()),
+			          static_cast<std::streamsize>(vectors_.size() * sizeof(double)));
+		}
+		else {
+			for (auto const d : vectors_) {
+				write_le(out, std::bit_cast<std::uint64_t>(d));
+			}
+		}
+		for (auto const& n : nodes_) {
+			write_le(out, static_cast<std::uint32_t>(n.level));
+			for (auto const& links : n.links) {
+				write_le(out, static_cast<std::uint32_t>(links.size()));
+				for (auto const link : links) {
+					write_le(out, link);
+				}
+			}
+		}
+		out.close();
+		if (not out) {
+			throw euclidean_vector_error("Failed to write hnsw_index file");
+		}
+	}
+
+	auto hnsw_index::load(std::filesystem::path const& path) -> hnsw_index {
+		auto in = std::ifstream(path, std::ios::binary);
+		if (not in) {
+			throw euclidean_vector_error("Cannot open " + path.string());
+		}
+		auto file_magic = std::array<char, 8>{};
+		in.read(file_magic.data(), file_magic.size());
+		if (not in or file_magic != magic) {
+			invalid(path, "bad magic");
+		}
+		if (read_le<std::uint32_t>(in) != version) {
+			invalid(path, "unsupported version");
+		}
+		auto const metric = read_le<std::uint32_t>(in);
+		auto parameters = hnsw_parameters{};
+		parameters.m = static_cast<int>(read_le<std::uint32_t>(in));
+		parameters.ef_construction = static_cast<int>(read_le<std::uint32_t>(in));
+		parameters.seed = read_le<std::uint64_t>(in);
+		auto const dimensions = read_le<std::uint64_t>(in);
+		auto const count = read_le<std::uint64_t>(in);
+		auto const entry = read_le<std::uint32_t>(in);
+		auto const top_level = static_cast<int>(read_le<std::uint32_t>(in));
+		in.seekg(header_size);
+		if (not in or metric > 1) {
+			invalid(path, "truncated");
+		}
+		if (count > std::numeric_limits<id_type>::max()) {
+			invalid(path, "too many vectors");
+		}
+		if (dimensions > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) {
+			invalid(path, "too many dimensions");
+		}
+		// An empty index saves a top level of -1.
+		if (top_level > max_level or (count != 0 and top_level < 0)) {
+			invalid(path, "too many layers");
+		}
+		if (parameters.m > std::numeric_limits<int>::max() / 2) {
+			invalid(path, "m out of range");
+		}
+		constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+		if (dimensions != 0 and count > max / sizeof(double) / dimensions) {
+			invalid(path, "too many magnitudes");
+		}
+		if (dimensions * count * sizeof(double) > std::filesystem::file_size(path) - header_size) {
+			invalid(path, "truncated");
+		}
+
+		auto index = hnsw_index(static_cast<int>(dimensions),
+		                        static_cast<knn_metric>(metric),
+		                        parameters);
+		index.vectors_.resize(dimensions * count);
+		in.read(reinterpret_cast<char*>(index.vectors_.data()),
+		        static_cast<std::streamsize>(index.vectors_.size() * sizeof(double)));
+		if constexpr (not little_endian) {
+			for (auto& d : index.vectors_) {
+				auto bits = std::bit_cast<std::uint64_t>(d);
+				auto swapped = std::uint64_t{0};
+				for (auto i = 0; i < 8; ++i, bits >>= 8U) {
+					swapped = (swapped << 8U) | (bits & 0xFFU);
+				}
+				d = std::bit_cast<double>(swapped);
+			}
+		}
+		auto const& kernels = kernels::active();
+		index.nodes_.resize(count);
+		index.squares_.resize(count);
+		index.locks_ = std::deque<std::mutex>(count);
+		for (auto id = id_type{0}; id < count; ++id) {
+			index.squares_[id] = kernels.sum_squares(index.magnitudes(id), index.dimensions_);
+			auto& n = index.nodes_[id];
+			n.level = static_cast<int>(read_le<std::uint32_t>(in));
+			if (not in or n.level < 0 or n.level > top_level) {
+				invalid(path, "truncated");
+			}
+			n.links.resize(itos(n.level + 1));
+			for (auto layer = 0; layer <= n.level; ++layer) {
+				auto const size = read_le<std::uint32_t>(in);
+				if (not in) {
+					invalid(path, "truncated");
+				}
+				if (size > index.max_links(layer)) {
+					invalid(path, "too many links");
+				}
+				auto& links = n.links[itos(layer)];
+				links.resize(size);
+				for (auto& link : links) {
+					link = read_le<std::uint32_t>(in);
+					if (link >= count) {
+						invalid(path, "link out of range");
+					}
+				}
+			}
+		}
+		if (not in or (count != 0 and entry >= count)) {
+			invalid(path, "truncated");
+		}
+		index.entry_ = count == 0 ? no_entry : entry;
+		index.top_level_ = count == 0 ? -1 : top_level;
+		return index;
+	}
+
+	// Cosine vectors are normalised so that their distance is one minus a dot product. Zero vectors
+	// stay zero, which puts them at distance 1 from everything.
+	auto hnsw_index::prepare(std::span<double const> v) const -> prepared_vector {
+		auto result = prepared_vector{std::vector<double>(v.begin(), v.end()), 0.0};
+		result.squares = kernels::active().sum_squares(v.data(), v.size());
+		if (metric_ == knn_metric::cosine and result.squares != 0.0) {
+			kernels::active().divide(result.magnitudes.data(), std::sqrt(result.squares), v.size());
+			result.squares = 1.0;
+		}
+		return result;
+	}
+
+	// Stores a vector and draws its level, leaving it unlinked.
+	auto hnsw_index::reserve(std::span<double const> v) -> id_type {
+		auto const id = static_cast<id_type>(nodes_.size());
+		auto const prepared = this->prepare(v);
+		vectors_.insert(vectors_.end(), prepared.magnitudes.begin(), prepared.magnitudes.end());
+		squares_.push_back(prepared.squares);
+
+		// P(level >= l) = m^-l
+		auto uniform = std::uniform_real_distribution<double>(0.0, 1.0);
+		auto const u = 1.0 - uniform(levels_);
+		auto const level = static_cast<int>(-std::log(u) / std::log(parameters_.m));
+		nodes_.push_back({level, std::vector<std::vector<id_type>>(itos(level + 1))});
+		locks_.emplace_back();
+		return id;
+	}
+
+	// Links a reserved vector into every layer up to its level.
+	auto hnsw_index::link(id_type id, bool concurrent) -> void {
+		auto const level = nodes_[id].level;
+		auto const* q = this->magnitudes(id);
+		auto const q_squares = squares_[id];
+
+		auto entry_guard = std::unique_lock(*entry_lock_, std::defer_lock);
+		if (concurrent) {
+			entry_guard.lock();
+		}
+		if (entry_ == no_entry) {
+			entry_ = id;
+			top_level_ = level;
+			return;
+		}
+		auto const entry_id = entry_;
+		auto const top = top_level_;
+		// A vector that will become the new entry point holds the lock until it is linked.
+		if (concurrent and level <= top) {
+			entry_guard.unlock();
+		}
+
+		auto entry = candidate{this->distance(q, q_squares, entry_id), entry_id};
+		for (auto layer = top; layer > level; --layer) {
+			entry = this->greedy(q, q_squares, entry, layer, concurrent);
+		}
+		auto entries = std::vector<candidate>{entry};
+		auto const ef = itos(parameters_.ef_construction);
+		for (auto layer = std::min(level, top); layer >= 0; --layer) {
+			auto const found = this->search_layer(q, q_squares, entries, ef, layer, concurrent);
+			auto const chosen = this->select(found, itos(parameters_.m));
+			{
+				auto const guard = lock_if(locks_[id], concurrent);
+				this->merge_links(id, layer, chosen);
+			}
+			for (auto const n : chosen) {
+				auto const guard = lock_if(locks_[n], concurrent);
+				auto& links = nodes_[n].links[itos(layer)];
+				if (std::find(links.begin(), links.end(), id) != links.end()) {
+					continue;
+				}
+				if (links.size() < this->max_links(layer)) {
+					links.push_back(id);
+					continue;
+				}
+				// Full: keep the best spread of the old links plus the new one.
+				auto const* n_magnitudes = this->magnitudes(n);
+				auto pool = std::vector<candidate>{{this->distance(n_magnitudes, squares_[n], id), id}};
+				for (auto const l : links) {
+					pool.push_back({this->distance(n_magnitudes, squares_[n], l), l});
+				}
+				std::sort(pool.begin(), pool.end());
+				links = this->select(pool, this->max_links(layer));
+			}
+			entries = found;
+		}
+
+		if (level > top) {
+			entry_ = id;
+			top_level_ = level;
+		}
+	}
+
+	// Once a vector's upper layers are linked, other threads inserting concurrently can reach it
+	// and link back to it on the layers below, so its own links are merged with any already there
+	// rather than replacing them. Only when they no longer all fit is the selection heuristic run
+	// over the lot.
+	auto hnsw_index::merge_links(id_type id, int layer, std::vector<id_type> const& chosen)
+	   -> void {
+		auto& links = nodes_[id].links[itos(layer)];
+		for (auto const c : chosen) {
+			if (std::find(links.begin(), links.end(), c) == links.end()) {
+				links.push_back(c);
+			}
+		}
+		if (links.size() <= this->max_links(layer)) {
+			return;
+		}
+		auto const* magnitudes = this->magnitudes(id);
+		auto pool = std::vector<candidate>();
+		for (auto const l : links) {
+			pool.push_back({this->distance(magnitudes, squares_[id], l), l});
+		}
+		std::sort(pool.begin(), pool.end());
+		links = this->select(pool, this->max_links(layer));
+	}
+
+	auto hnsw_index::links(int id, int layer) const -> std::vector<int> {
+		if (id < 0 or id >= this->size() or layer < 0) {
+			auto err_msg = "Vector " + std::to_string(id) + " on layer " + std::to_string(layer)
+			               + " is not valid for this hnsw_index object";
+			throw euclidean_vector_error(err_msg);
+		}
+		auto const& n = nodes_[itos(id)];
+		if (layer > n.level) {
+			return {};
+		}
+		auto const& l = n.links[itos(layer)];
+		return std::vector<int>(l.begin(), l.end());
+	}
+
+	auto hnsw_index::max_links(int layer) const -> std::size_t {
+		return itos(layer == 0 ? 2 * parameters_.m : parameters_.m);
+	}
+
+	auto hnsw_index::magnitudes(id_type id) const -> double const* {
+		return std::span(vectors_).subspan(id * dimensions_).data();
+	}
+
+	// Squared euclidean distance for l2 (from the norm expansion), one minus the dot product of
+	// normalised vectors for cosine.
+	auto hnsw_index::distance(double const* q, double q_squares, id_type id) const -> double {
+		auto const d = kernels::active().dot(q, this->magnitudes(id), dimensions_);
+		if (metric_ == knn_metric::cosine) {
+			return squares_[id] == 0.0 or q_squares == 0.0 ? 1.0 : 1.0 - d;
+		}
+		return std::max(0.0, q_squares + squares_[id] - 2.0 * d);
+	}
+
+	// Without concurrent writers the links are read in place; otherwise they are copied under the
+	// node's lock.
+	auto hnsw_index::neighbours(id_type id,
+	                            int layer,
+	                            bool concurrent,
+	                            std::vector<id_type>& scratch) const -> std::span<id_type const> {
+		auto const& links = nodes_[id].links[itos(layer)];
+		if (not concurrent) {
+			return links;
+		}
+		auto const guard = std::scoped_lock(locks_[id]);
+		scratch.assign(links.begin(), links.end());
+		return scratch;
+	}
+
+	// Walks to ever nearer neighbours on one layer until none is nearer.
+	auto hnsw_index::greedy(double const* q,
+	                        double q_squares,
+	                        candidate entry,
+	                        int layer,
+	                        bool concurrent) const -> candidate {
+		auto scratch = std::vector<id_type>();
+		auto improved = true;
+		while (improved) {
+			improved = false;
+			for (auto const n : this->neighbours(entry.id, layer, concurrent, scratch)) {
+				auto const c = candidate{this->distance(q, q_squares, n), n};
+				if (c < entry) {
+					entry = c;
+					improved = true;
+				}
+			}
+		}
+		return entry;
+	}
+
+	// Best-first search of one layer keeping the `ef` nearest found so far. Returns them nearest
+	// first.
+	auto hnsw_index::search_layer(double const* q,
+	                              double q_squares,
+	                              std::vector<candidate> const& entries,
+	                              std::size_t ef,
+	                              int layer,
+	                              bool concurrent) const -> std::vector<candidate> {
+		auto [marks, epoch] = visited_marks(nodes_.size());
+		auto frontier = std::priority_queue<candidate, std::vector<candidate>, std::greater<>>();
+		auto nearest = std::priority_queue<candidate>();
+		for (auto const& e : entries) {
+			marks[e.id] = epoch;
+			frontier.push(e);
+			nearest.push(e);
+		}
+		while (nearest.size() > ef) {
+			nearest.pop();
+		}
+
+		auto scratch = std::vector<id_type>();
+		while (not frontier.empty()) {
+			auto const current = frontier.top();
+			if (nearest.size() >= ef and current.distance > nearest.top().distance) {
+				break;
+			}
+			frontier.pop();
+			for (auto const n : this->neighbours(current.id, layer, concurrent, scratch)) {
+				if (marks[n] == epoch) {
+					continue;
+				}
+				marks[n] = epoch;
+				auto const c = candidate{this->distance(q, q_squares, n), n};
+				if (nearest.size() < ef or c < nearest.top()) {
+					frontier.push(c);
+					nearest.push(c);
+					if (nearest.size() > ef) {
+						nearest.pop();
+					}
+				}
+			}
+		}
+
+		auto result = std::vector<candidate>(nearest.size());
+		for (auto i = result.size(); i-- > 0; nearest.pop()) {
+			result[i] = nearest.top();
+		}
+		return result;
+	}
+
+	// The neighbour-selection heuristic: walking candidates nearest first, keep one only if it is
+	// nearer to the query than to everything already kept. This favours links in different
+	// directions over a tight cluster of links in one.
+	auto hnsw_index::select(std::vector<candidate> const& sorted, std::size_t m) const
+	   -> std::vector<id_type> {
+		auto kept = std::vector<id_type>();
+		for (auto const& c : sorted) {
+			if (kept.size() == m) {
+				break;
+			}
+			auto const* c_magnitudes = this->magnitudes(c.id);
+			auto const diverse = std::all_of(kept.begin(), kept.end(), [&](id_type k) {
+				return this->distance(c_magnitudes, squares_[c.id], k) > c.distance;
+			});
+			if (diverse) {
+				kept.push_back(c.id);
+			}
+		}
+		return kept;
+	}
+} // namespace comp6771
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
@@ -0,0 +1,1075 @@
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#	include <immintrin.h>
+#	define COMP6771_KERNELS_X86 1
+#endif
+
+// The kernels below index raw buffers handed over by the owning containers; bounds are the
+// caller's responsibility.
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+namespace comp6771::kernels {
+	namespace {
+		// =========================== SCALAR ===========================
+		auto scalar_add(double* y, double const* x, std::size_t n) -> void {
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				y[i] += x[i];
+			}
+		}
+
+		auto scalar_scale(double* y, double a, std::size_t n) -> void {
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				y[i] *= a;
+			}
+		}
+
+		auto scalar_divide(double* y, double d, std::size_t n) -> void {
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				y[i] /= d;
+			}
+		}
+
+		// Four independent accumulators break the loop-carried dependency on a single sum.
+		auto scalar_dot(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = 0.0;
+			auto acc1 = 0.0;
+			auto acc2 = 0.0;
+			auto acc3 = 0.0;
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				acc0 += x[i] * y[i];
+				acc1 += x[i + 1] * y[i + 1];
+				acc2 += x[i + 2] * y[i + 2];
+				acc3 += x[i + 3] * y[i + 3];
+			}
+			auto total = (acc0 + acc1) + (acc2 + acc3);
+			for (; i < n; ++i) {
+				total += x[i] * y[i];
+			}
+			return total;
+		}
+
+		auto scalar_sum_squares(double const* x, std::size_t n) -> double {
+			return scalar_dot(x, x, n);
+		}
+
+		auto scalar_axpy(double* y, double a, double const* x, std::size_t n) -> void {
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				y[i] += a * x[i];
+			}
+		}
+
+		auto scalar_axpby(double* y, double a, double const* x, double b, std::size_t n) -> void {
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				y[i] = a * x[i] + b * y[i];
+			}
+		}
+
+		// Two accumulators per sum: six running sums is as many as stay comfortably in registers.
+		auto scalar_dot_and_squares(double const* x, double const* y, std::size_t n) -> dot_squares {
+			auto xy0 = 0.0;
+			auto xy1 = 0.0;
+			auto xx0 = 0.0;
+			auto xx1 = 0.0;
+			auto yy0 = 0.0;
+			auto yy1 = 0.0;
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				xy0 += x[i] * y[i];
+				xx0 += x[i] * x[i];
+				yy0 += y[i] * y[i];
+				xy1 += x[i + 1] * y[i + 1];
+				xx1 += x[i + 1] * x[i + 1];
+				yy1 += y[i + 1] * y[i + 1];
+			}
+			auto result = dot_squares{xy0 + xy1, xx0 + xx1, yy0 + yy1};
+			for (; i < n; ++i) {
+				result.dot += x[i] * y[i];
+				result.x_squares += x[i] * x[i];
+				result.y_squares += y[i] * y[i];
+			}
+			return result;
+		}
+
+		auto scalar_dot4(double const* x,
+		                 double const* rows,
+		                 std::size_t stride,
+		                 std::size_t n,
+		                 double* out) -> void {
+			for (auto r = std::size_t{0}; r < 4; ++r) {
+				out[r] = scalar_dot(x, rows + r * stride, n);
+			}
+		}
+
+		auto scalar_gemm_tile(std::size_t k,
+		                      double const* a,
+		                      double const* b,
+		                      double* c,
+		                      std::size_t ldc) -> void {
+			auto tile = std::array<std::array<double, gemm_cols>, gemm_rows>{};
+			for (auto p = std::size_t{0}; p < k; ++p) {
+				for (auto r = std::size_t{0}; r < gemm_rows; ++r) {
+					for (auto j = std::size_t{0}; j < gemm_cols; ++j) {
+						tile[r][j] += a[p * gemm_rows + r] * b[p * gemm_cols + j];
+					}
+				}
+			}
+			for (auto r = std::size_t{0}; r < gemm_rows; ++r) {
+				for (auto j = std::size_t{0}; j < gemm_cols; ++j) {
+					c[r * ldc + j] += tile[r][j];
+				}
+			}
+		}
+
+		auto scalar_l1_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = 0.0;
+			auto acc1 = 0.0;
+			auto acc2 = 0.0;
+			auto acc3 = 0.0;
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				acc0 += std::abs(x[i] - y[i]);
+				acc1 += std::abs(x[i + 1] - y[i + 1]);
+				acc2 += std::abs(x[i + 2] - y[i + 2]);
+				acc3 += std::abs(x[i + 3] - y[i + 3]);
+			}
+			auto total = (acc0 + acc1) + (acc2 + acc3);
+			for (; i < n; ++i) {
+				total += std::abs(x[i] - y[i]);
+			}
+			return total;
+		}
+
+		auto scalar_squared_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = 0.0;
+			auto acc1 = 0.0;
+			auto acc2 = 0.0;
+			auto acc3 = 0.0;
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const d0 = x[i] - y[i];
+				auto const d1 = x[i + 1] - y[i + 1];
+				auto const d2 = x[i + 2] - y[i + 2];
+				auto const d3 = x[i + 3] - y[i + 3];
+				acc0 += d0 * d0;
+				acc1 += d1 * d1;
+				acc2 += d2 * d2;
+				acc3 += d3 * d3;
+			}
+			auto total = (acc0 + acc1) + (acc2 + acc3);
+			for (; i < n; ++i) {
+				auto const d = x[i] - y[i];
+				total += d * d;
+			}
+			return total;
+		}
+
+		// Folds one more |x[i] - y[i]| into linf_distance's running maximum. std::max keeps a NaN
+		// already in largest but drops a new one, so that is caught first.
+		auto linf_step(double largest, double d) -> double {
+			return std::isnan(d) ? d : std::max(largest, std::abs(d));
+		}
+
+		auto scalar_linf_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto largest = 0.0;
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				largest = linf_step(largest, x[i] - y[i]);
+			}
+			return largest;
+		}
+
+		constexpr auto scalar_table = kernel_table{"scalar",
+		                                           scalar_add,
+		                                           scalar_scale,
+		                                           scalar_divide,
+		                                           scalar_dot,
+		                                           scalar_sum_squares,
+		                                           scalar_axpy,
+		                                           scalar_axpby,
+		                                           scalar_dot_and_squares,
+		                                           scalar_dot4,
+		                                           scalar_gemm_tile,
+		                                           scalar_l1_distance,
+		                                           scalar_squared_distance,
+		                                           scalar_linf_distance};
+
+#ifdef COMP6771_KERNELS_X86
+		// =========================== SSE2 ===========================
+		auto sse2_hsum(__m128d v) -> double {
+			return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+		}
+
+		auto sse2_add(double* y, double const* x, std::size_t n) -> void {
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				_mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_loadu_pd(x + i)));
+			}
+			scalar_add(y + i, x + i, n - i);
+		}
+
+		auto sse2_scale(double* y, double a, std::size_t n) -> void {
+			auto const va = _mm_set1_pd(a);
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				_mm_storeu_pd(y + i, _mm_mul_pd(_mm_loadu_pd(y + i), va));
+			}
+			scalar_scale(y + i, a, n - i);
+		}
+
+		auto sse2_divide(double* y, double d, std::size_t n) -> void {
+			auto const vd = _mm_set1_pd(d);
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				_mm_storeu_pd(y + i, _mm_div_pd(_mm_loadu_pd(y + i), vd));
+			}
+			scalar_divide(y + i, d, n - i);
+		}
+
+		auto sse2_dot(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm_setzero_pd();
+			auto acc1 = _mm_setzero_pd();
+			auto acc2 = _mm_setzero_pd();
+			auto acc3 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+				acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+				acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(x + i + 4), _mm_loadu_pd(y + i + 4)));
+				acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(x + i + 6), _mm_loadu_pd(y + i + 6)));
+			}
+			for (; i + 2 <= n; i += 2) {
+				acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+			}
+			auto total = sse2_hsum(_mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3)));
+			for (; i < n; ++i) {
+				total += x[i] * y[i];
+			}
+			return total;
+		}
+
+		auto sse2_sum_squares(double const* x, std::size_t n) -> double {
+			return sse2_dot(x, x, n);
+		}
+
+		auto sse2_axpy(double* y, double a, double const* x, std::size_t n) -> void {
+			auto const va = _mm_set1_pd(a);
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				auto const ax = _mm_mul_pd(va, _mm_loadu_pd(x + i));
+				_mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), ax));
+			}
+			scalar_axpy(y + i, a, x + i, n - i);
+		}
+
+		auto sse2_axpby(double* y, double a, double const* x, double b, std::size_t n) -> void {
+			auto const va = _mm_set1_pd(a);
+			auto const vb = _mm_set1_pd(b);
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				auto const ax = _mm_mul_pd(va, _mm_loadu_pd(x + i));
+				_mm_storeu_pd(y + i, _mm_add_pd(ax, _mm_mul_pd(vb, _mm_loadu_pd(y + i))));
+			}
+			scalar_axpby(y + i, a, x + i, b, n - i);
+		}
+
+		auto sse2_dot_and_squares(double const* x, double const* y, std::size_t n) -> dot_squares {
+			auto xy0 = _mm_setzero_pd();
+			auto xy1 = _mm_setzero_pd();
+			auto xx0 = _mm_setzero_pd();
+			auto xx1 = _mm_setzero_pd();
+			auto yy0 = _mm_setzero_pd();
+			auto yy1 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const x0 = _mm_loadu_pd(x + i);
+				auto const y0 = _mm_loadu_pd(y + i);
+				auto const x1 = _mm_loadu_pd(x + i + 2);
+				auto const y1 = _mm_loadu_pd(y + i + 2);
+				xy0 = _mm_add_pd(xy0, _mm_mul_pd(x0, y0));
+				xx0 = _mm_add_pd(xx0, _mm_mul_pd(x0, x0));
+				yy0 = _mm_add_pd(yy0, _mm_mul_pd(y0, y0));
+				xy1 = _mm_add_pd(xy1, _mm_mul_pd(x1, y1));
+				xx1 = _mm_add_pd(xx1, _mm_mul_pd(x1, x1));
+				yy1 = _mm_add_pd(yy1, _mm_mul_pd(y1, y1));
+			}
+			auto result = scalar_dot_and_squares(x + i, y + i, n - i);
+			result.dot += sse2_hsum(_mm_add_pd(xy0, xy1));
+			result.x_squares += sse2_hsum(_mm_add_pd(xx0, xx1));
+			result.y_squares += sse2_hsum(_mm_add_pd(yy0, yy1));
+			return result;
+		}
+
+		auto sse2_dot4(double const* x,
+		               double const* rows,
+		               std::size_t stride,
+		               std::size_t n,
+		               double* out) -> void {
+			auto const* const r0 = rows;
+			auto const* const r1 = rows + stride;
+			auto const* const r2 = rows + 2 * stride;
+			auto const* const r3 = rows + 3 * stride;
+			auto acc0 = _mm_setzero_pd();
+			auto acc1 = _mm_setzero_pd();
+			auto acc2 = _mm_setzero_pd();
+			auto acc3 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 2 <= n; i += 2) {
+				auto const vx = _mm_loadu_pd(x + i);
+				acc0 = _mm_add_pd(acc0, _mm_mul_pd(vx, _mm_loadu_pd(r0 + i)));
+				acc1 = _mm_add_pd(acc1, _mm_mul_pd(vx, _mm_loadu_pd(r1 + i)));
+				acc2 = _mm_add_pd(acc2, _mm_mul_pd(vx, _mm_loadu_pd(r2 + i)));
+				acc3 = _mm_add_pd(acc3, _mm_mul_pd(vx, _mm_loadu_pd(r3 + i)));
+			}
+			auto total0 = sse2_hsum(acc0);
+			auto total1 = sse2_hsum(acc1);
+			auto total2 = sse2_hsum(acc2);
+			auto total3 = sse2_hsum(acc3);
+			for (; i < n; ++i) {
+				total0 += x[i] * r0[i];
+				total1 += x[i] * r1[i];
+				total2 += x[i] * r2[i];
+				total3 += x[i] * r3[i];
+			}
+			out[0] = total0;
+			out[1] = total1;
+			out[2] = total2;
+			out[3] = total3;
+		}
+
+		// Sixteen accumulators and their operands would not fit in the sixteen SSE registers, so the
+		// tile is taken a row at a time.
+		auto sse2_gemm_tile(std::size_t k,
+		                    double const* a,
+		                    double const* b,
+		                    double* c,
+		                    std::size_t ldc) -> void {
+			for (auto r = std::size_t{0}; r < gemm_rows; ++r) {
+				auto acc0 = _mm_setzero_pd();
+				auto acc1 = _mm_setzero_pd();
+				auto acc2 = _mm_setzero_pd();
+				auto acc3 = _mm_setzero_pd();
+				for (auto p = std::size_t{0}; p < k; ++p) {
+					auto const va = _mm_set1_pd(a[p * gemm_rows + r]);
+					auto const* const row = b + p * gemm_cols;
+					acc0 = _mm_add_pd(acc0, _mm_mul_pd(va, _mm_loadu_pd(row)));
+					acc1 = _mm_add_pd(acc1, _mm_mul_pd(va, _mm_loadu_pd(row + 2)));
+					acc2 = _mm_add_pd(acc2, _mm_mul_pd(va, _mm_loadu_pd(row + 4)));
+					acc3 = _mm_add_pd(acc3, _mm_mul_pd(va, _mm_loadu_pd(row + 6)));
+				}
+				auto* const out = c + r * ldc;
+				_mm_storeu_pd(out, _mm_add_pd(_mm_loadu_pd(out), acc0));
+				_mm_storeu_pd(out + 2, _mm_add_pd(_mm_loadu_pd(out + 2), acc1));
+				_mm_storeu_pd(out + 4, _mm_add_pd(_mm_loadu_pd(out + 4), acc2));
+				_mm_storeu_pd(out + 6, _mm_add_pd(_mm_loadu_pd(out + 6), acc3));
+			}
+		}
+
+		auto sse2_abs(__m128d v) -> __m128d {
+			return _mm_andnot_pd(_mm_set1_pd(-0.0), v);
+		}
+
+		auto sse2_l1_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm_setzero_pd();
+			auto acc1 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const d0 = _mm_sub_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i));
+				auto const d1 = _mm_sub_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2));
+				acc0 = _mm_add_pd(acc0, sse2_abs(d0));
+				acc1 = _mm_add_pd(acc1, sse2_abs(d1));
+			}
+			auto total = sse2_hsum(_mm_add_pd(acc0, acc1));
+			for (; i < n; ++i) {
+				total += std::abs(x[i] - y[i]);
+			}
+			return total;
+		}
+
+		auto sse2_squared_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm_setzero_pd();
+			auto acc1 = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const d0 = _mm_sub_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i));
+				auto const d1 = _mm_sub_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2));
+				acc0 = _mm_add_pd(acc0, _mm_mul_pd(d0, d0));
+				acc1 = _mm_add_pd(acc1, _mm_mul_pd(d1, d1));
+			}
+			auto total = sse2_hsum(_mm_add_pd(acc0, acc1));
+			for (; i < n; ++i) {
+				auto const d = x[i] - y[i];
+				total += d * d;
+			}
+			return total;
+		}
+
+		auto sse2_linf_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm_setzero_pd();
+			auto acc1 = _mm_setzero_pd();
+			// maxpd drops NaN inputs, so lanes that saw one are tracked on the side.
+			auto unordered = _mm_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const d0 = _mm_sub_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i));
+				auto const d1 = _mm_sub_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2));
+				acc0 = _mm_max_pd(acc0, sse2_abs(d0));
+				acc1 = _mm_max_pd(acc1, sse2_abs(d1));
+				unordered =
+				   _mm_or_pd(unordered, _mm_or_pd(_mm_cmpunord_pd(d0, d0), _mm_cmpunord_pd(d1, d1)));
+			}
+			auto const acc = _mm_max_pd(acc0, acc1);
+			auto largest = _mm_movemask_pd(unordered) != 0
+			                  ? std::numeric_limits<double>::quiet_NaN()
+			                  : _mm_cvtsd_f64(_mm_max_sd(acc, _mm_unpackhi_pd(acc, acc)));
+			for (; i < n; ++i) {
+				largest = linf_step(largest, x[i] - y[i]);
+			}
+			return largest;
+		}
+
+		constexpr auto sse2_table = kernel_table{"sse2",
+		                                         sse2_add,
+		                                         sse2_scale,
+		                                         sse2_divide,
+		                                         sse2_dot,
+		                                         sse2_sum_squares,
+		                                         sse2_axpy,
+		                                         sse2_axpby,
+		                                         sse2_dot_and_squares,
+		                                         sse2_dot4,
+		                                         sse2_gemm_tile,
+		                                         sse2_l1_distance,
+		                                         sse2_squared_distance,
+		                                         sse2_linf_distance};
+
+		// =========================== AVX2 ===========================
+		__attribute__((target("avx2,fma"))) auto avx2_hsum(__m256d v) -> double {
+			auto const lo = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+			return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+		}
+
+		__attribute__((target("avx2,fma"))) auto avx2_hmax(__m256d v) -> double {
+			auto const lo = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+			return _mm_cvtsd_f64(_mm_max_sd(lo, _mm_unpackhi_pd(lo, lo)));
+		}
+
+		__attribute__((target("avx2,fma"))) auto avx2_add(double* y, double const* x, std::size_t n)
+		   -> void {
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				_mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i)));
+			}
+			scalar_add(y + i, x + i, n - i);
+		}
+
+		__attribute__((target("avx2,fma"))) auto avx2_scale(double* y, double a, std::size_t n)
+		   -> void {
+			auto const va = _mm256_set1_pd(a);
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				_mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), va));
+			}
+			scalar_scale(y + i, a, n - i);
+		}
+
+		__attribute__((target("avx2,fma"))) auto avx2_divide(double* y, double d, std::size_t n)
+		   -> void {
+			auto const vd = _mm256_set1_pd(d);
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				_mm256_storeu_pd(y + i, _mm256_div_pd(_mm256_loadu_pd(y + i), vd));
+			}
+			scalar_divide(y + i, d, n - i);
+		}
+
+		__attribute__((target("avx2,fma"))) auto
+		avx2_dot(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm256_setzero_pd();
+			auto acc1 = _mm256_setzero_pd();
+			auto acc2 = _mm256_setzero_pd();
+			auto acc3 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), acc0);
+				acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), acc1);
+				acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8), acc2);
+				acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), acc3);
+			}
+			for (; i + 4 <= n; i += 4) {
+				acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), acc0);
+			}
+			auto total =
+			   avx2_hsum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+			for (; i < n; ++i) {
+				total += x[i] * y[i];
+			}
+			return total;
+		}
+
+		__attribute__((target("avx2,fma"))) auto avx2_sum_squares(double const* x, std::size_t n)
+		   -> double {
+			return avx2_dot(x, x, n);
+		}
+
+		__attribute__((target("avx2,fma"))) auto
+		avx2_axpy(double* y, double a, double const* x, std::size_t n) -> void {
+			auto const va = _mm256_set1_pd(a);
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				_mm256_storeu_pd(y + i,
+				                 _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+			}
+			scalar_axpy(y + i, a, x + i, n - i);
+		}
+
+		__attribute__((target("avx2,fma"))) auto
+		avx2_axpby(double* y, double a, double const* x, double b, std::size_t n) -> void {
+			auto const va = _mm256_set1_pd(a);
+			auto const vb = _mm256_set1_pd(b);
+			auto i = std::size_t{0};
+			for (; i + 4 <= n; i += 4) {
+				auto const by = _mm256_mul_pd(vb, _mm256_loadu_pd(y + i));
+				_mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), by));
+			}
+			scalar_axpby(y + i, a, x + i, b, n - i);
+		}
+
+		__attribute__((target("avx2,fma"))) auto
+		avx2_dot_and_squares(double const* x, double const* y, std::size_t n) -> dot_squares {
+			auto xy0 = _mm256_setzero_pd();
+			auto xy1 = _mm256_setzero_pd();
+			auto xx0 = _mm256_setzero_pd();
+			auto xx1 = _mm256_setzero_pd();
+			auto yy0 = _mm256_setzero_pd();
+			auto yy1 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const x0 = _mm256_loadu_pd(x + i);
+				auto const y0 = _mm256_loadu_pd(y + i);
+				auto const x1 = _mm256_loadu_pd(x + i + 4);
+				auto const y1 = _mm256_loadu_pd(y + i + 4);
+				xy0 = _mm256_fmadd_pd(x0, y0, xy0);
+				xx0 = _mm256_fmadd_pd(x0, x0, xx0);
+				yy0 = _mm256_fmadd_pd(y0, y0, yy0);
+				xy1 = _mm256_fmadd_pd(x1, y1, xy1);
+				xx1 = _mm256_fmadd_pd(x1, x1, xx1);
+				yy1 = _mm256_fmadd_pd(y1, y1, yy1);
+			}
+			auto result = scalar_dot_and_squares(x + i, y + i, n - i);
+			result.dot += avx2_hsum(_mm256_add_pd(xy0, xy1));
+			result.x_squares += avx2_hsum(_mm256_add_pd(xx0, xx1));
+			result.y_squares += avx2_hsum(_mm256_add_pd(yy0, yy1));
+			return result;
+		}
+
+		// Two accumulators per row: eight independent chains keep both FMA units busy.
+		__attribute__((target("avx2,fma"))) auto avx2_dot4(double const* x,
+		                                                   double const* rows,
+		                                                   std::size_t stride,
+		                                                   std::size_t n,
+		                                                   double* out) -> void {
+			auto const* const r0 = rows;
+			auto const* const r1 = rows + stride;
+			auto const* const r2 = rows + 2 * stride;
+			auto const* const r3 = rows + 3 * stride;
+			auto lo0 = _mm256_setzero_pd();
+			auto lo1 = _mm256_setzero_pd();
+			auto lo2 = _mm256_setzero_pd();
+			auto lo3 = _mm256_setzero_pd();
+			auto hi0 = _mm256_setzero_pd();
+			auto hi1 = _mm256_setzero_pd();
+			auto hi2 = _mm256_setzero_pd();
+			auto hi3 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const x0 = _mm256_loadu_pd(x + i);
+				auto const x1 = _mm256_loadu_pd(x + i + 4);
+				lo0 = _mm256_fmadd_pd(x0, _mm256_loadu_pd(r0 + i), lo0);
+				lo1 = _mm256_fmadd_pd(x0, _mm256_loadu_pd(r1 + i), lo1);
+				lo2 = _mm256_fmadd_pd(x0, _mm256_loadu_pd(r2 + i), lo2);
+				lo3 = _mm256_fmadd_pd(x0, _mm256_loadu_pd(r3 + i), lo3);
+				hi0 = _mm256_fmadd_pd(x1, _mm256_loadu_pd(r0 + i + 4), hi0);
+				hi1 = _mm256_fmadd_pd(x1, _mm256_loadu_pd(r1 + i + 4), hi1);
+				hi2 = _mm256_fmadd_pd(x1, _mm256_loadu_pd(r2 + i + 4), hi2);
+				hi3 = _mm256_fmadd_pd(x1, _mm256_loadu_pd(r3 + i + 4), hi3);
+			}
+			auto total0 = avx2_hsum(_mm256_add_pd(lo0, hi0));
+			auto total1 = avx2_hsum(_mm256_add_pd(lo1, hi1));
+			auto total2 = avx2_hsum(_mm256_add_pd(lo2, hi2));
+			auto total3 = avx2_hsum(_mm256_add_pd(lo3, hi3));
+			for (; i < n; ++i) {
+				total0 += x[i] * r0[i];
+				total1 += x[i] * r1[i];
+				total2 += x[i] * r2[i];
+				total3 += x[i] * r3[i];
+			}
+			out[0] = total0;
+			out[1] = total1;
+			out[2] = total2;
+			out[3] = total3;
+		}
+
+		// out[0, 4) += v
+		__attribute__((target("avx2,fma"))) auto avx2_add_to(double* out, __m256d v) -> void {
+			_mm256_storeu_pd(out, _mm256_add_pd(_mm256_loadu_pd(out), v));
+		}
+
+		__attribute__((target("avx2,fma"))) auto avx2_gemm_tile(std::size_t k,
+		                                                        double const* a,
+		                                                        double const* b,
+		                                                        double* c,
+		                                                        std::size_t ldc) -> void {
+			auto lo0 = _mm256_setzero_pd();
+			auto lo1 = _mm256_setzero_pd();
+			auto lo2 = _mm256_setzero_pd();
+			auto lo3 = _mm256_setzero_pd();
+			auto hi0 = _mm256_setzero_pd();
+			auto hi1 = _mm256_setzero_pd();
+			auto hi2 = _mm256_setzero_pd();
+			auto hi3 = _mm256_setzero_pd();
+			for (auto p = std::size_t{0}; p < k; ++p) {
+				auto const b0 = _mm256_loadu_pd(b + p * gemm_cols);
+				auto const b1 = _mm256_loadu_pd(b + p * gemm_cols + 4);
+				auto const* const column = a + p * gemm_rows;
+				auto const a0 = _mm256_broadcast_sd(column);
+				lo0 = _mm256_fmadd_pd(a0, b0, lo0);
+				hi0 = _mm256_fmadd_pd(a0, b1, hi0);
+				auto const a1 = _mm256_broadcast_sd(column + 1);
+				lo1 = _mm256_fmadd_pd(a1, b0, lo1);
+				hi1 = _mm256_fmadd_pd(a1, b1, hi1);
+				auto const a2 = _mm256_broadcast_sd(column + 2);
+				lo2 = _mm256_fmadd_pd(a2, b0, lo2);
+				hi2 = _mm256_fmadd_pd(a2, b1, hi2);
+				auto const a3 = _mm256_broadcast_sd(column + 3);
+				lo3 = _mm256_fmadd_pd(a3, b0, lo3);
+				hi3 = _mm256_fmadd_pd(a3, b1, hi3);
+			}
+			avx2_add_to(c, lo0);
+			avx2_add_to(c + 4, hi0);
+			avx2_add_to(c + ldc, lo1);
+			avx2_add_to(c + ldc + 4, hi1);
+			avx2_add_to(c + 2 * ldc, lo2);
+			avx2_add_to(c + 2 * ldc + 4, hi2);
+			avx2_add_to(c + 3 * ldc, lo3);
+			avx2_add_to(c + 3 * ldc + 4, hi3);
+		}
+
+		__attribute__((target("avx2,fma"))) auto avx2_abs(__m256d v) -> __m256d {
+			return _mm256_andnot_pd(_mm256_set1_pd(-0.0), v);
+		}
+
+		__attribute__((target("avx2,fma"))) auto
+		avx2_l1_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm256_setzero_pd();
+			auto acc1 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const d0 = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+				auto const d1 = _mm256_sub_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+				acc0 = _mm256_add_pd(acc0, avx2_abs(d0));
+				acc1 = _mm256_add_pd(acc1, avx2_abs(d1));
+			}
+			auto total = avx2_hsum(_mm256_add_pd(acc0, acc1));
+			for (; i < n; ++i) {
+				total += std::abs(x[i] - y[i]);
+			}
+			return total;
+		}
+
+		__attribute__((target("avx2,fma"))) auto
+		avx2_squared_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm256_setzero_pd();
+			auto acc1 = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const d0 = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+				auto const d1 = _mm256_sub_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+				acc0 = _mm256_fmadd_pd(d0, d0, acc0);
+				acc1 = _mm256_fmadd_pd(d1, d1, acc1);
+			}
+			auto total = avx2_hsum(_mm256_add_pd(acc0, acc1));
+			for (; i < n; ++i) {
+				auto const d = x[i] - y[i];
+				total += d * d;
+			}
+			return total;
+		}
+
+		__attribute__((target("avx2,fma"))) auto
+		avx2_linf_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm256_setzero_pd();
+			auto acc1 = _mm256_setzero_pd();
+			auto unordered = _mm256_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const d0 = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+				auto const d1 = _mm256_sub_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+				acc0 = _mm256_max_pd(acc0, avx2_abs(d0));
+				acc1 = _mm256_max_pd(acc1, avx2_abs(d1));
+				unordered = _mm256_or_pd(unordered,
+				                         _mm256_or_pd(_mm256_cmp_pd(d0, d0, _CMP_UNORD_Q),
+				                                      _mm256_cmp_pd(d1, d1, _CMP_UNORD_Q)));
+			}
+			auto largest = _mm256_movemask_pd(unordered) != 0
+			                  ? std::numeric_limits<double>::quiet_NaN()
+			                  : avx2_hmax(_mm256_max_pd(acc0, acc1));
+			for (; i < n; ++i) {
+				largest = linf_step(largest, x[i] - y[i]);
+			}
+			return largest;
+		}
+
+		constexpr auto avx2_table = kernel_table{"avx2",
+		                                         avx2_add,
+		                                         avx2_scale,
+		                                         avx2_divide,
+		                                         avx2_dot,
+		                                         avx2_sum_squares,
+		                                         avx2_axpy,
+		                                         avx2_axpby,
+		                                         avx2_dot_and_squares,
+		                                         avx2_dot4,
+		                                         avx2_gemm_tile,
+		                                         avx2_l1_distance,
+		                                         avx2_squared_distance,
+		                                         avx2_linf_distance};
+
+		// =========================== AVX-512 ===========================
+		// GCC's unmasked AVX-512 extract and max intrinsics merge into an undefined register, which
+		// trips -Wuninitialized once LTO inlines them, and _mm512_reduce_*_pd are built on them.
+		// Zero-masking with every lane selected compiles to the same instructions.
+		constexpr auto avx512_lanes = __mmask8{0xFF};
+
+		__attribute__((target("avx512f"))) auto avx512_max(__m512d x, __m512d y) -> __m512d {
+			return _mm512_maskz_max_pd(avx512_lanes, x, y);
+		}
+
+		__attribute__((target("avx512f"))) auto avx512_hsum(__m512d v) -> double {
+			return avx2_hsum(_mm256_add_pd(_mm512_maskz_extractf64x4_pd(avx512_lanes, v, 0),
+			                               _mm512_maskz_extractf64x4_pd(avx512_lanes, v, 1)));
+		}
+
+		__attribute__((target("avx512f"))) auto avx512_hmax(__m512d v) -> double {
+			return avx2_hmax(_mm256_max_pd(_mm512_maskz_extractf64x4_pd(avx512_lanes, v, 0),
+			                               _mm512_maskz_extractf64x4_pd(avx512_lanes, v, 1)));
+		}
+
+		__attribute__((target("avx512f"))) auto
+		avx512_add(double* y, double const* x, std::size_t n) -> void {
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				_mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i), _mm512_loadu_pd(x + i)));
+			}
+			scalar_add(y + i, x + i, n - i);
+		}
+
+		__attribute__((target("avx512f"))) auto avx512_scale(double* y, double a, std::size_t n)
+		   -> void {
+			auto const va = _mm512_set1_pd(a);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				_mm512_storeu_pd(y + i, _mm512_mul_pd(_mm512_loadu_pd(y + i), va));
+			}
+			scalar_scale(y + i, a, n - i);
+		}
+
+		__attribute__((target("avx512f"))) auto avx512_divide(double* y, double d, std::size_t n)
+		   -> void {
+			auto const vd = _mm512_set1_pd(d);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				_mm512_storeu_pd(y + i, _mm512_div_pd(_mm512_loadu_pd(y + i), vd));
+			}
+			scalar_divide(y + i, d, n - i);
+		}
+
+		__attribute__((target("avx512f"))) auto
+		avx512_dot(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm512_setzero_pd();
+			auto acc1 = _mm512_setzero_pd();
+			auto acc2 = _mm512_setzero_pd();
+			auto acc3 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 32 <= n; i += 32) {
+				acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), acc0);
+				acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), acc1);
+				acc2 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 16), _mm512_loadu_pd(y + i + 16), acc2);
+				acc3 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 24), _mm512_loadu_pd(y + i + 24), acc3);
+			}
+			for (; i + 8 <= n; i += 8) {
+				acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), acc0);
+			}
+			auto total =
+			   avx512_hsum(_mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3)));
+			for (; i < n; ++i) {
+				total += x[i] * y[i];
+			}
+			return total;
+		}
+
+		__attribute__((target("avx512f"))) auto avx512_sum_squares(double const* x, std::size_t n)
+		   -> double {
+			return avx512_dot(x, x, n);
+		}
+
+		__attribute__((target("avx512f"))) auto
+		avx512_axpy(double* y, double a, double const* x, std::size_t n) -> void {
+			auto const va = _mm512_set1_pd(a);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				_mm512_storeu_pd(y + i,
+				                 _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+			}
+			scalar_axpy(y + i, a, x + i, n - i);
+		}
+
+		__attribute__((target("avx512f"))) auto
+		avx512_axpby(double* y, double a, double const* x, double b, std::size_t n) -> void {
+			auto const va = _mm512_set1_pd(a);
+			auto const vb = _mm512_set1_pd(b);
+			auto i = std::size_t{0};
+			for (; i + 8 <= n; i += 8) {
+				auto const by = _mm512_mul_pd(vb, _mm512_loadu_pd(y + i));
+				_mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), by));
+			}
+			scalar_axpby(y + i, a, x + i, b, n - i);
+		}
+
+		__attribute__((target("avx512f"))) auto
+		avx512_dot_and_squares(double const* x, double const* y, std::size_t n) -> dot_squares {
+			auto xy0 = _mm512_setzero_pd();
+			auto xy1 = _mm512_setzero_pd();
+			auto xx0 = _mm512_setzero_pd();
+			auto xx1 = _mm512_setzero_pd();
+			auto yy0 = _mm512_setzero_pd();
+			auto yy1 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const x0 = _mm512_loadu_pd(x + i);
+				auto const y0 = _mm512_loadu_pd(y + i);
+				auto const x1 = _mm512_loadu_pd(x + i + 8);
+				auto const y1 = _mm512_loadu_pd(y + i + 8);
+				xy0 = _mm512_fmadd_pd(x0, y0, xy0);
+				xx0 = _mm512_fmadd_pd(x0, x0, xx0);
+				yy0 = _mm512_fmadd_pd(y0, y0, yy0);
+				xy1 = _mm512_fmadd_pd(x1, y1, xy1);
+				xx1 = _mm512_fmadd_pd(x1, x1, xx1);
+				yy1 = _mm512_fmadd_pd(y1, y1, yy1);
+			}
+			auto result = scalar_dot_and_squares(x + i, y + i, n - i);
+			result.dot += avx512_hsum(_mm512_add_pd(xy0, xy1));
+			result.x_squares += avx512_hsum(_mm512_add_pd(xx0, xx1));
+			result.y_squares += avx512_hsum(_mm512_add_pd(yy0, yy1));
+			return result;
+		}
+
+		__attribute__((target("avx512f"))) auto avx512_dot4(double const* x,
+		                                                    double const* rows,
+		                                                    std::size_t stride,
+		                                                    std::size_t n,
+		                                                    double* out) -> void {
+			auto const* const r0 = rows;
+			auto const* const r1 = rows + stride;
+			auto const* const r2 = rows + 2 * stride;
+			auto const* const r3 = rows + 3 * stride;
+			auto lo0 = _mm512_setzero_pd();
+			auto lo1 = _mm512_setzero_pd();
+			auto lo2 = _mm512_setzero_pd();
+			auto lo3 = _mm512_setzero_pd();
+			auto hi0 = _mm512_setzero_pd();
+			auto hi1 = _mm512_setzero_pd();
+			auto hi2 = _mm512_setzero_pd();
+			auto hi3 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const x0 = _mm512_loadu_pd(x + i);
+				auto const x1 = _mm512_loadu_pd(x + i + 8);
+				lo0 = _mm512_fmadd_pd(x0, _mm512_loadu_pd(r0 + i), lo0);
+				lo1 = _mm512_fmadd_pd(x0, _mm512_loadu_pd(r1 + i), lo1);
+				lo2 = _mm512_fmadd_pd(x0, _mm512_loadu_pd(r2 + i), lo2);
+				lo3 = _mm512_fmadd_pd(x0, _mm512_loadu_pd(r3 + i), lo3);
+				hi0 = _mm512_fmadd_pd(x1, _mm512_loadu_pd(r0 + i + 8), hi0);
+				hi1 = _mm512_fmadd_pd(x1, _mm512_loadu_pd(r1 + i + 8), hi1);
+				hi2 = _mm512_fmadd_pd(x1, _mm512_loadu_pd(r2 + i + 8), hi2);
+				hi3 = _mm512_fmadd_pd(x1, _mm512_loadu_pd(r3 + i + 8), hi3);
+			}
+			auto total0 = avx512_hsum(_mm512_add_pd(lo0, hi0));
+			auto total1 = avx512_hsum(_mm512_add_pd(lo1, hi1));
+			auto total2 = avx512_hsum(_mm512_add_pd(lo2, hi2));
+			auto total3 = avx512_hsum(_mm512_add_pd(lo3, hi3));
+			for (; i < n; ++i) {
+				total0 += x[i] * r0[i];
+				total1 += x[i] * r1[i];
+				total2 += x[i] * r2[i];
+				total3 += x[i] * r3[i];
+			}
+			out[0] = total0;
+			out[1] = total1;
+			out[2] = total2;
+			out[3] = total3;
+		}
+
+		// out[0, 8) += v
+		__attribute__((target("avx512f"))) auto avx512_add_to(double* out, __m512d v) -> void {
+			_mm512_storeu_pd(out, _mm512_add_pd(_mm512_loadu_pd(out), v));
+		}
+
+		// A tile row is one register, so even and odd steps of k accumulate separately to keep
+		// eight chains in flight.
+		__attribute__((target("avx512f"))) auto avx512_gemm_tile(std::size_t k,
+		                                                         double const* a,
+		                                                         double const* b,
+		                                                         double* c,
+		                                                         std::size_t ldc) -> void {
+			auto even0 = _mm512_setzero_pd();
+			auto even1 = _mm512_setzero_pd();
+			auto even2 = _mm512_setzero_pd();
+			auto even3 = _mm512_setzero_pd();
+			auto odd0 = _mm512_setzero_pd();
+			auto odd1 = _mm512_setzero_pd();
+			auto odd2 = _mm512_setzero_pd();
+			auto odd3 = _mm512_setzero_pd();
+			auto p = std::size_t{0};
+			for (; p + 2 <= k; p += 2) {
+				auto const b0 = _mm512_loadu_pd(b + p * gemm_cols);
+				auto const b1 = _mm512_loadu_pd(b + (p + 1) * gemm_cols);
+				auto const* const column0 = a + p * gemm_rows;
+				auto const* const column1 = column0 + gemm_rows;
+				even0 = _mm512_fmadd_pd(_mm512_set1_pd(column0[0]), b0, even0);
+				even1 = _mm512_fmadd_pd(_mm512_set1_pd(column0[1]), b0, even1);
+				even2 = _mm512_fmadd_pd(_mm512_set1_pd(column0[2]), b0, even2);
+				even3 = _mm512_fmadd_pd(_mm512_set1_pd(column0[3]), b0, even3);
+				odd0 = _mm512_fmadd_pd(_mm512_set1_pd(column1[0]), b1, odd0);
+				odd1 = _mm512_fmadd_pd(_mm512_set1_pd(column1[1]), b1, odd1);
+				odd2 = _mm512_fmadd_pd(_mm512_set1_pd(column1[2]), b1, odd2);
+				odd3 = _mm512_fmadd_pd(_mm512_set1_pd(column1[3]), b1, odd3);
+			}
+			if (p < k) {
+				auto const b0 = _mm512_loadu_pd(b + p * gemm_cols);
+				auto const* const column = a + p * gemm_rows;
+				even0 = _mm512_fmadd_pd(_mm512_set1_pd(column[0]), b0, even0);
+				even1 = _mm512_fmadd_pd(_mm512_set1_pd(column[1]), b0, even1);
+				even2 = _mm512_fmadd_pd(_mm512_set1_pd(column[2]), b0, even2);
+				even3 = _mm512_fmadd_pd(_mm512_set1_pd(column[3]), b0, even3);
+			}
+			avx512_add_to(c, _mm512_add_pd(even0, odd0));
+			avx512_add_to(c + ldc, _mm512_add_pd(even1, odd1));
+			avx512_add_to(c + 2 * ldc, _mm512_add_pd(even2, odd2));
+			avx512_add_to(c + 3 * ldc, _mm512_add_pd(even3, odd3));
+		}
+
+		__attribute__((target("avx512f"))) auto
+		avx512_l1_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm512_setzero_pd();
+			auto acc1 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const d0 = _mm512_sub_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+				auto const d1 = _mm512_sub_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8));
+				acc0 = _mm512_add_pd(acc0, _mm512_abs_pd(d0));
+				acc1 = _mm512_add_pd(acc1, _mm512_abs_pd(d1));
+			}
+			auto total = avx512_hsum(_mm512_add_pd(acc0, acc1));
+			for (; i < n; ++i) {
+				total += std::abs(x[i] - y[i]);
+			}
+			return total;
+		}
+
+		__attribute__((target("avx512f"))) auto
+		avx512_squared_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm512_setzero_pd();
+			auto acc1 = _mm512_setzero_pd();
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const d0 = _mm512_sub_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+				auto const d1 = _mm512_sub_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8));
+				acc0 = _mm512_fmadd_pd(d0, d0, acc0);
+				acc1 = _mm512_fmadd_pd(d1, d1, acc1);
+			}
+			auto total = avx512_hsum(_mm512_add_pd(acc0, acc1));
+			for (; i < n; ++i) {
+				auto const d = x[i] - y[i];
+				total += d * d;
+			}
+			return total;
+		}
+
+		__attribute__((target("avx512f"))) auto
+		avx512_linf_distance(double const* x, double const* y, std::size_t n) -> double {
+			auto acc0 = _mm512_setzero_pd();
+			auto acc1 = _mm512_setzero_pd();
+			auto unordered = __mmask8{0};
+			auto i = std::size_t{0};
+			for (; i + 16 <= n; i += 16) {
+				auto const d0 = _mm512_sub_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+				auto const d1 = _mm512_sub_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8));
+				acc0 = avx512_max(acc0, _mm512_abs_pd(d0));
+				acc1 = avx512_max(acc1, _mm512_abs_pd(d1));
+				unordered = static_cast<__mmask8>(
+				   unordered | _mm512_mask_cmp_pd_mask(avx512_lanes, d0, d0, _CMP_UNORD_Q)
+				   | _mm512_mask_cmp_pd_mask(avx512_lanes, d1, d1, _CMP_UNORD_Q));
+			}
+			auto largest = unordered != 0 ? std::numeric_limits<double>::quiet_NaN()
+			                              : avx512_hmax(avx512_max(acc0, acc1));
+			for (; i < n; ++i) {
+				largest = linf_step(largest, x[i] - y[i]);
+			}
+			return largest;
+		}
+
+		constexpr auto avx512_table = kernel_table{"avx512",
+		                                           avx512_add,
+		                                           avx512_scale,
+		                                           avx512_divide,
+		                                           avx512_dot,
+		                                           avx512_sum_squares,
+		                                           avx512_axpy,
+		                                           avx512_axpby,
+		                                           avx512_dot_and_squares,
+		                                           avx512_dot4,
+		                                           avx512_gemm_tile,
+		                                           avx512_l1_distance,
+		                                           avx512_squared_distance,
+		                                           avx512_linf_distance};
+#endif // COMP6771_KERNELS_X86
+	} // namespace
+
+	// SUPPORTED KERNELS
+	auto supported() -> std::vector<kernel_table const*> {
+		auto tables = std::vector<kernel_table const*>{&scalar_table};
+#ifdef COMP6771_KERNELS_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("sse2")) {
+			tables.push_back(&sse2_table);
+		}
+		if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma")) {
+			tables.push_back(&avx2_table);
+		}
+		if (__builtin_cpu_supports("avx512f")) {
+			tables.push_back(&avx512_table);
+		}
+#endif // COMP6771_KERNELS_X86
+		return tables;
+	}
+
+	// ACTIVE KERNELS
+	auto active() -> kernel_table const& {
+		static auto const* const table = supported().back();
+		return *table;
+	}
+
+	namespace {
+		// Resolve the dispatch while the program starts rather than inside the first hot call.
+		[[maybe_unused]] auto const& startup_kernels = active();
+	} // namespace
+} // namespace comp6771::kernels
+
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
@@ -0,0 +1,473 @@
+#include "comp6771/kmeans.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		// Vectors scored against every centroid with one matrix product.
+		constexpr auto assign_block = std::size_t{256};
+		// Vectors per partial sum. Fixed, so the order partial sums are combined in is too.
+		constexpr auto reduce_block = std::size_t{1} << 14;
+
+		auto blocks(std::size_t n, std::size_t block) -> std::size_t {
+			return (n + block - 1) / block;
+		}
+
+		auto check_options(euclidean_vector_batch const& data, int k, kmeans_options const& options)
+		   -> void {
+			if (k < 1 or k > data.size()) {
+				auto err_msg = "Invalid k (" + std::to_string(k) + ") for kmeans over "
+				               + std::to_string(data.size()) + " vectors";
+				throw euclidean_vector_error(err_msg);
+			}
+			if (options.max_iterations < 0) {
+				auto err_msg =
+				   "Invalid max_iterations (" + std::to_string(options.max_iterations) + ") for kmeans";
+				throw euclidean_vector_error(err_msg);
+			}
+			if (options.mini_batch < 0) {
+				auto err_msg =
+				   "Invalid mini_batch (" + std::to_string(options.mini_batch) + ") for kmeans";
+				throw euclidean_vector_error(err_msg);
+			}
+		}
+
+		// The rows being clustered, read row-major, with their squared norms. Its rows may point
+		// into its own row-major copy, so it can be neither copied nor moved.
+		class dataset {
+		public:
+			dataset(thread_pool& pool, euclidean_vector_batch const& data)
+			: rows_{data}
+			, squares_(rows_.size()) {
+				auto const& kernels = kernels::active();
+				auto const size = rows_.size();
+				pool.run(blocks(size, reduce_block), [this, &kernels, size](std::size_t b) {
+					for (auto i = b * reduce_block; i < std::min(size, (b + 1) * reduce_block); ++i) {
+						squares_[i] = kernels.sum_squares(this->row(i).data(), rows_.dims());
+					}
+				});
+			}
+			dataset(dataset const&) = delete;
+			dataset(dataset&&) = delete;
+			~dataset() = default;
+
+			auto operator=(dataset const&) -> dataset& = delete;
+			auto operator=(dataset&&) -> dataset& = delete;
+
+			[[nodiscard]] auto size() const -> std::size_t {
+				return rows_.size();
+			}
+
+			[[nodiscard]] auto dims() const -> std::size_t {
+				return rows_.dims();
+			}
+
+			[[nodiscard]] auto row(std::size_t i) const -> std::span<double const> {
+				return rows_.row(i);
+			}
+
+			[[nodiscard]] auto square(std::size_t i) const -> double {
+				return squares_[i];
+			}
+
+		private:
+			row_major_view rows_;
+			std::vector<double> squares_;
+		};
+
+		auto squares_of(euclidean_matrix const& centroids, std::vector<double>& out) -> void {
+			auto const& kernels = kernels::active();
+			for (auto j = 0; j < centroids.rows(); ++j) {
+				out[itos(j)] = kernels.sum_squares(centroids.row(j).data(), itos(centroids.cols()));
+			}
+		}
+
+		// Scores blocks of vectors against every centroid. Each parallel block has its own, made
+		// before the first iteration and kept until the last, so the block buffers are never shared
+		// and never reallocated. The centroids and their squares are read at each assign().
+		class scorer {
+		public:
+			scorer(dataset const& set,
+			       euclidean_matrix const& centroids,
+			       std::vector<double> const& centroid_squares)
+			: set_{set}
+			, centroids_{centroids}
+			, centroid_squares_{centroid_squares}
+			, block_{static_cast<int>(assign_block), centroids.cols()}
+			, scores_{static_cast<int>(assign_block), centroids.rows()} {}
+
+			// Labels vectors index(0), ..., index(count - 1) with their nearest centroids, and
+			// records their squared distances to them. Returns how many labels changed.
+			template<typename Index>
+			auto assign(std::size_t count, Index const& index, int* labels, double* distances)
+			   -> std::size_t {
+				auto changed = std::size_t{0};
+				for (auto first = std::size_t{0}; first < count; first += assign_block) {
+					auto const n = std::min(assign_block, count - first);
+					// Rows of the block past n keep stale vectors; their scores are ignored.
+					for (auto i = std::size_t{0}; i < n; ++i) {
+						auto const row = set_.row(index(first + i));
+						std::copy(row.begin(), row.end(), block_.row(static_cast<int>(i)).begin());
+					}
+					multiply_transposed(block_, centroids_, scores_);
+					for (auto i = std::size_t{0}; i < n; ++i) {
+						auto const scores = std::as_const(scores_).row(static_cast<int>(i));
+						auto best = 0;
+						auto best_distance = std::numeric_limits<double>::infinity();
+						for (auto j = std::size_t{0}; j < scores.size(); ++j) {
+							auto const distance = centroid_squares_[j] - 2.0 * scores[j];
+							if (distance < best_distance) {
+								best = static_cast<int>(j);
+								best_distance = distance;
+							}
+						}
+						auto* const label = labels + first + i;
+						changed += *label != best ? 1 : 0;
+						*label = best;
+						auto const square = set_.square(index(first + i));
+						distances[first + i] = std::max(0.0, square + best_distance);
+					}
+				}
+				return changed;
+			}
+
+		private:
+			dataset const& set_;
+			euclidean_matrix const& centroids_;
+			std::vector<double> const& centroid_squares_;
+			euclidean_matrix block_;
+			euclidean_matrix scores_;
+		};
+
+		auto make_scorers(std::size_t count,
+		                  dataset const& set,
+		                  euclidean_matrix const& centroids,
+		                  std::vector<double> const& centroid_squares) -> std::vector<scorer> {
+			auto scorers = std::vector<scorer>();
+			scorers.reserve(count);
+			for (auto b = std::size_t{0}; b < count; ++b) {
+				scorers.emplace_back(set, centroids, centroid_squares);
+			}
+			return scorers;
+		}
+
+		// Labels every vector with one scorer per reduce block and returns the inertia, summed in
+		// block order.
+		auto label_all(thread_pool& pool,
+		               dataset const& set,
+		               std::vector<scorer>& scorers,
+		               std::vector<int>& labels,
+		               std::vector<double>& distances) -> double {
+			auto partial = std::vector<double>(scorers.size());
+			pool.run(partial.size(), [&](std::size_t b) {
+				auto const first = b * reduce_block;
+				auto const count = std::min(reduce_block, set.size() - first);
+				scorers[b].assign(
+				   count,
+				   [first](std::size_t i) { return first + i; },
+				   labels.data() + first,
+				   distances.data() + first);
+				auto const block = std::span<double const>(distances).subspan(first, count);
+				partial[b] = std::accumulate(block.begin(), block.end(), 0.0);
+			});
+			return std::accumulate(partial.begin(), partial.end(), 0.0);
+		}
+
+		// Labels every vector against `centroids` and returns the inertia.
+		auto label_all(thread_pool& pool,
+		               dataset const& set,
+		               euclidean_matrix const& centroids,
+		               std::vector<int>& labels,
+		               std::vector<double>& distances) -> double {
+			auto centroid_squares = std::vector<double>(itos(centroids.rows()));
+			squares_of(centroids, centroid_squares);
+			auto scorers =
+			   make_scorers(blocks(set.size(), reduce_block), set, centroids, centroid_squares);
+			return label_all(pool, set, scorers, labels, distances);
+		}
+
+		// The farthest any centroid moved, squared.
+		auto largest_shift(euclidean_matrix const& now, euclidean_matrix const& before) -> double {
+			auto largest = 0.0;
+			for (auto j = 0; j < now.rows(); ++j) {
+				auto const a = now.row(j);
+				auto const b = before.row(j);
+				auto shift = 0.0;
+				for (auto d = std::size_t{0}; d < a.size(); ++d) {
+					shift += (a[d] - b[d]) * (a[d] - b[d]);
+				}
+				largest = std::max(largest, shift);
+			}
+			return largest;
+		}
+
+		auto copy_row(std::span<double const> from, euclidean_matrix& to, std::size_t j) -> void {
+			std::copy(from.begin(), from.end(), to.row(static_cast<int>(j)).begin());
+		}
+
+		// The index whose weight covers `target`, walking the weights in order and taking target
+		// down by each one passed. Zero weights are never chosen; should rounding carry the target
+		// past the end, the last positive weight is.
+		auto pick(std::span<double const> weights, double& target) -> std::size_t {
+			auto chosen = std::size_t{0};
+			for (auto i = std::size_t{0}; i < weights.size(); ++i) {
+				if (weights[i] > 0.0) {
+					chosen = i;
+					if (target < weights[i]) {
+						break;
+					}
+					target -= weights[i];
+				}
+			}
+			return chosen;
+		}
+
+		// ========================== SEEDING ==========================
+		auto seed_random(dataset const& set, std::size_t k, std::mt19937_64& rng)
+		   -> euclidean_matrix {
+			auto centroids = euclidean_matrix(static_cast<int>(k), static_cast<int>(set.dims()));
+			auto indices = std::vector<std::size_t>(set.size());
+			std::iota(indices.begin(), indices.end(), std::size_t{0});
+			auto chosen = std::vector<std::size_t>();
+			std::sample(indices.begin(), indices.end(), std::back_inserter(chosen), k, rng);
+			for (auto j = std::size_t{0}; j < k; ++j) {
+				copy_row(set.row(chosen[j]), centroids, j);
+			}
+			return centroids;
+		}
+
+		// Each squared distance to the nearest centroid so far is kept, and updated against each
+		// new centroid in parallel blocks whose totals pick the block the next centroid comes from.
+		auto seed_plus_plus(thread_pool& pool,
+		                    dataset const& set,
+		                    std::size_t k,
+		                    std::mt19937_64& rng) -> euclidean_matrix {
+			auto const& kernels = kernels::active();
+			auto const n = set.size();
+			auto centroids = euclidean_matrix(static_cast<int>(k), static_cast<int>(set.dims()));
+			auto nearest = std::vector<double>(n, std::numeric_limits<double>::infinity());
+			auto totals = std::vector<double>(blocks(n, reduce_block));
+			auto any = std::uniform_int_distribution<std::size_t>(0, n - 1);
+			auto chosen = any(rng);
+			for (auto j = std::size_t{0}; j < k; ++j) {
+				copy_row(set.row(chosen), centroids, j);
+				if (j + 1 == k) {
+					break;
+				}
+				auto const centre = set.row(chosen);
+				auto const centre_square = set.square(chosen);
+				pool.run(totals.size(), [&](std::size_t b) {
+					auto total = 0.0;
+					for (auto i = b * reduce_block; i < std::min(n, (b + 1) * reduce_block); ++i) {
+						auto const dot = kernels.dot(set.row(i).data(), centre.data(), set.dims());
+						auto const distance = std::max(0.0, set.square(i) + centre_square - 2.0 * dot);
+						nearest[i] = std::min(nearest[i], distance);
+						total += nearest[i];
+					}
+					totals[b] = total;
+				});
+				auto const total = std::accumulate(totals.begin(), totals.end(), 0.0);
+				if (not(total > 0.0)) {
+					// Every vector is already a centroid.
+					chosen = any(rng);
+					continue;
+				}
+				auto target = std::uniform_real_distribution<double>(0.0, total)(rng);
+				auto const b = pick(totals, target);
+				auto const first = b * reduce_block;
+				auto const count = std::min(reduce_block, n - first);
+				chosen = first + pick(std::span<double const>(nearest).subspan(first, count), target);
+			}
+			return centroids;
+		}
+
+		// ========================== ITERATIONS ==========================
+		// Full Lloyd iterations. Each block of vectors is labelled and summed per cluster into its
+		// own slot of `sums`; the slots are then combined in block order into the new centroids.
+		auto lloyd(thread_pool& pool,
+		           dataset const& set,
+		           euclidean_matrix centroids,
+		           kmeans_options const& options) -> kmeans_result {
+			auto const& kernels = kernels::active();
+			auto const n = set.size();
+			auto const dims = set.dims();
+			auto const k = itos(centroids.rows());
+			auto const block_count = blocks(n, reduce_block);
+			auto labels = std::vector<int>(n, -1);
+			auto distances = std::vector<double>(n);
+			auto centroid_squares = std::vector<double>(k);
+			auto sums = std::vector<double>(block_count * k * dims);
+			auto counts = std::vector<std::size_t>(block_count * k);
+			auto changed = std::vector<std::size_t>(block_count);
+			auto cluster_sizes = std::vector<std::size_t>(k);
+			auto previous = euclidean_matrix(centroids.rows(), centroids.cols());
+			// Swapping with `previous` moves the centroids but not the variable the scorers read.
+			auto scorers = make_scorers(block_count, set, centroids, centroid_squares);
+
+			auto iterations = 0;
+			auto converged = false;
+			while (not converged and iterations < options.max_iterations) {
+				squares_of(centroids, centroid_squares);
+				pool.run(block_count, [&](std::size_t b) {
+					auto const first = b * reduce_block;
+					auto const count = std::min(reduce_block, n - first);
+					changed[b] = scorers[b].assign(
+					   count,
+					   [first](std::size_t i) { return first + i; },
+					   labels.data() + first,
+					   distances.data() + first);
+					auto* const block_sums = sums.data() + b * k * dims;
+					auto* const block_counts = counts.data() + b * k;
+					std::fill_n(block_sums, k * dims, 0.0);
+					std::fill_n(block_counts, k, std::size_t{0});
+					for (auto i = first; i < first + count; ++i) {
+						auto const j = itos(labels[i]);
+						kernels.add(block_sums + j * dims, set.row(i).data(), dims);
+						++block_counts[j];
+					}
+				});
+				++iterations;
+
+				std::swap(centroids, previous);
+				std::fill(centroids.data().begin(), centroids.data().end(), 0.0);
+				std::fill(cluster_sizes.begin(), cluster_sizes.end(), std::size_t{0});
+				for (auto b = std::size_t{0}; b < block_count; ++b) {
+					for (auto j = std::size_t{0}; j < k; ++j) {
+						auto const* const sum = sums.data() + (b * k + j) * dims;
+						kernels.add(centroids.row(static_cast<int>(j)).data(), sum, dims);
+						cluster_sizes[j] += counts[b * k + j];
+					}
+				}
+				for (auto j = std::size_t{0}; j < k; ++j) {
+					if (cluster_sizes[j] != 0) {
+						auto const size = static_cast<double>(cluster_sizes[j]);
+						kernels.divide(centroids.row(static_cast<int>(j)).data(), size, dims);
+						continue;
+					}
+					// An empty cluster takes the vector farthest from its centroid, which then
+					// can't be taken again.
+					auto const farthest = std::max_element(distances.begin(), distances.end());
+					auto const index = static_cast<std::size_t>(farthest - distances.begin());
+					copy_row(set.row(index), centroids, j);
+					*farthest = 0.0;
+				}
+
+				auto const moved = std::reduce(changed.begin(), changed.end(), std::size_t{0});
+				auto const shift = largest_shift(centroids, previous);
+				converged = moved == 0 or shift <= options.tolerance * options.tolerance;
+			}
+
+			squares_of(centroids, centroid_squares);
+			auto inertia = label_all(pool, set, scorers, labels, distances);
+			return {std::move(centroids), std::move(labels), inertia, iterations, converged};
+		}
+
+		// Mini-batch iterations: each samples vectors with replacement, labels them in parallel,
+		// and then moves each one's centroid towards it in sample order, by one over the number of
+		// vectors that centroid has been moved towards so far.
+		auto mini_batch(thread_pool& pool,
+		                dataset const& set,
+		                euclidean_matrix centroids,
+		                kmeans_options const& options,
+		                std::mt19937_64& rng) -> kmeans_result {
+			auto const& kernels = kernels::active();
+			auto const dims = set.dims();
+			auto const batch = itos(options.mini_batch);
+			auto sample = std::vector<std::size_t>(batch);
+			auto labels = std::vector<int>(batch);
+			auto distances = std::vector<double>(batch);
+			auto centroid_squares = std::vector<double>(itos(centroids.rows()));
+			auto seen = std::vector<std::size_t>(itos(centroids.rows()));
+			auto previous = euclidean_matrix(centroids.rows(), centroids.cols());
+			auto any = std::uniform_int_distribution<std::size_t>(0, set.size() - 1);
+			auto scorers = make_scorers(blocks(batch, assign_block), set, centroids, centroid_squares);
+
+			auto iterations = 0;
+			auto converged = false;
+			while (not converged and iterations < options.max_iterations) {
+				std::generate(sample.begin(), sample.end(), [&] { return any(rng); });
+				squares_of(centroids, centroid_squares);
+				pool.run(blocks(batch, assign_block), [&](std::size_t b) {
+					auto const first = b * assign_block;
+					scorers[b].assign(
+					   std::min(assign_block, batch - first),
+					   [&, first](std::size_t i) { return sample[first + i]; },
+					   labels.data() + first,
+					   distances.data() + first);
+				});
+				++iterations;
+
+				std::copy(centroids.data().begin(), centroids.data().end(), previous.data().begin());
+				for (auto i = std::size_t{0}; i < batch; ++i) {
+					auto const j = labels[i];
+					auto const rate = 1.0 / static_cast<double>(++seen[itos(j)]);
+					auto const* const x = set.row(sample[i]).data();
+					kernels.axpby(centroids.row(j).data(), rate, x, 1.0 - rate, dims);
+				}
+				converged = largest_shift(centroids, previous) <= options.tolerance * options.tolerance;
+			}
+
+			labels.resize(set.size());
+			distances.resize(set.size());
+			auto inertia = label_all(pool, set, centroids, labels, distances);
+			return {std::move(centroids), std::move(labels), inertia, iterations, converged};
+		}
+	} // namespace
+
+	// K-MEANS
+	auto kmeans(euclidean_vector_batch const& data, int k, kmeans_options const& options)
+	   -> kmeans_result {
+		auto one = thread_pool(1);
+		return kmeans(parallel_policy{&one}, data, k, options);
+	}
+
+	auto kmeans(parallel_policy const& policy,
+	            euclidean_vector_batch const& data,
+	            int k,
+	            kmeans_options const& options) -> kmeans_result {
+		check_options(data, k, options);
+		auto& pool = pool_of(policy);
+		auto const set = dataset(pool, data);
+		auto rng = std::mt19937_64(options.seed);
+		auto centroids = options.init == kmeans_init::kmeans_plus_plus
+		                    ? seed_plus_plus(pool, set, itos(k), rng)
+		                    : seed_random(set, itos(k), rng);
+		if (options.mini_batch == 0) {
+			return lloyd(pool, set, std::move(centroids), options);
+		}
+		return mini_batch(pool, set, std::move(centroids), options, rng);
+	}
+
+	// NEAREST CENTROIDS
+	auto nearest_centroids(euclidean_matrix const& centroids, euclidean_vector_batch const& data)
+	   -> std::vector<int> {
+		auto one = thread_pool(1);
+		return nearest_centroids(parallel_policy{&one}, centroids, data);
+	}
+
+	auto nearest_centroids(parallel_policy const& policy,
+	                       euclidean_matrix const& centroids,
+	                       euclidean_vector_batch const& data) -> std::vector<int> {
+		if (centroids.rows() == 0) {
+			const auto* err_msg = "Invalid centroids: there must be at least one";
+			throw euclidean_vector_error(err_msg);
+		}
+		euclidean_vector::check_dimensions(centroids.cols(), data.dimensions());
+		auto& pool = pool_of(policy);
+		auto const set = dataset(pool, data);
+		auto labels = std::vector<int>(set.size());
+		auto distances = std::vector<double>(set.size());
+		label_all(pool, set, centroids, labels, distances);
+		return labels;
+	}
+} // namespace comp6771
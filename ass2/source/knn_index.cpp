@@ -0,0 +1,155 @@
+#include "comp6771/knn_index.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		// Queries compared against each block of data before moving on to the next block.
+		constexpr auto query_block = std::size_t{8};
+		// Magnitudes per data block: 256 KiB, comfortably inside a per-core L2 cache.
+		constexpr auto block_magnitudes = std::size_t{1} << 15;
+
+		auto nearer(knn_neighbour const& a, knn_neighbour const& b) -> bool {
+			return a.distance < b.distance or (a.distance == b.distance and a.index < b.index);
+		}
+
+		// The k nearest neighbours seen so far, as a max-heap on distance so the farthest is the one
+		// to evict.
+		class top_k {
+		public:
+			explicit top_k(std::size_t k)
+			: k_{k} {
+				heap_.reserve(k);
+			}
+
+			auto push(knn_neighbour const& n) -> void {
+				if (heap_.size() < k_) {
+					heap_.push_back(n);
+					std::push_heap(heap_.begin(), heap_.end(), nearer);
+				}
+				else if (k_ != 0 and nearer(n, heap_.front())) {
+					std::pop_heap(heap_.begin(), heap_.end(), nearer);
+					heap_.back() = n;
+					std::push_heap(heap_.begin(), heap_.end(), nearer);
+				}
+			}
+
+			auto sorted() && -> std::vector<knn_neighbour> {
+				std::sort_heap(heap_.begin(), heap_.end(), nearer);
+				return std::move(heap_);
+			}
+
+		private:
+			std::size_t k_;
+			std::vector<knn_neighbour> heap_;
+		};
+
+		auto check_k(int k) -> std::size_t {
+			if (k < 0) {
+				auto err_msg = "Invalid k (" + std::to_string(k) + ") for a knn_index search";
+				throw euclidean_vector_error(err_msg);
+			}
+			return itos(k);
+		}
+	} // namespace
+
+	// ========================== CONSTRUCTORS ==========================
+	knn_index::knn_index(euclidean_vector_batch data, knn_metric metric)
+	: data_{row_major(std::move(data))}
+	, metric_{metric}
+	, norms_{metric_ == knn_metric::cosine ? euclidean_norm(data_) : std::vector<double>()} {}
+
+	// =========================== MEMBER FUNCTIONS ===========================
+	auto knn_index::search(const_euclidean_vector_view query, int k) const
+	   -> std::vector<knn_neighbour> {
+		euclidean_vector::check_dimensions(query.dimensions(), this->dimensions());
+		auto result = std::vector<std::vector<knn_neighbour>>(1);
+		this->search_block(query.magnitudes(), check_k(k), result);
+		return std::move(result.front());
+	}
+
+	auto knn_index::search(euclidean_vector_batch const& queries, int k) const
+	   -> std::vector<std::vector<knn_neighbour>> {
+		auto one = thread_pool(1);
+		return this->search(parallel_policy{&one}, queries, k);
+	}
+
+	auto knn_index::search(parallel_policy const& policy,
+	                       euclidean_vector_batch const& queries,
+	                       int k) const -> std::vector<std::vector<knn_neighbour>> {
+		euclidean_vector::check_dimensions(queries.dimensions(), this->dimensions());
+		auto const kk = check_k(k);
+		auto const rows = row_major_view(queries);
+		auto const dims = rows.dims();
+		auto const count = rows.size();
+		auto results = std::vector<std::vector<knn_neighbour>>(count);
+		auto& pool = pool_of(policy);
+		pool.run((count + query_block - 1) / query_block, [&](std::size_t b) {
+			auto const first = b * query_block;
+			auto const n = std::min(query_block, count - first);
+			this->search_block(rows.data().subspan(first * dims, n * dims),
+			                   kk,
+			                   std::span(results).subspan(first, n));
+		});
+		return results;
+	}
+
+	// Compares queries (row-major) with every data row, one cache-sized block of rows at a time.
+	// Heaps hold squared distances for l2; the square roots are taken once at the end. Those come
+	// straight from the squared_distance kernel rather than |q|² + |x|² - 2q·x, which cancels
+	// badly for near-duplicate vectors and could misorder them.
+	auto knn_index::search_block(std::span<double const> queries,
+	                             std::size_t k,
+	                             std::span<std::vector<knn_neighbour>> out) const -> void {
+		auto const& kernels = kernels::active();
+		auto const dims = itos(this->dimensions());
+		auto const size = itos(this->size());
+		auto const data = data_.data();
+
+		auto query_norms = std::vector<double>(out.size());
+		auto heaps = std::vector<top_k>(out.size(), top_k(k));
+		for (auto q = std::size_t{0}; q < out.size() and metric_ == knn_metric::cosine; ++q) {
+			query_norms[q] = std::sqrt(kernels.sum_squares(queries.subspan(q * dims).data(), dims));
+			if (query_norms[q] == 0.0) {
+				const auto* err_msg = "euclidean_vector with zero euclidean normal does not have a "
+				                      "cosine similarity";
+				throw euclidean_vector_error(err_msg);
+			}
+		}
+
+		auto const rows_per_block = block_magnitudes / std::max(dims, std::size_t{1});
+		auto const block = std::max(rows_per_block, std::size_t{1});
+		for (auto first = std::size_t{0}; first < size; first += block) {
+			auto const last = std::min(size, first + block);
+			for (auto q = std::size_t{0}; q < out.size(); ++q) {
+				auto const* query = queries.subspan(q * dims).data();
+				for (auto r = first; r < last; ++r) {
+					auto const* row = data.subspan(r * dims).data();
+					if (metric_ == knn_metric::l2) {
+						heaps[q].push({static_cast<int>(r), kernels.squared_distance(query, row, dims)});
+						continue;
+					}
+					auto const d = kernels.dot(query, row, dims);
+					auto const distance =
+					   norms_[r] == 0.0 ? 1.0 : 1.0 - d / (query_norms[q] * norms_[r]);
+					heaps[q].push({static_cast<int>(r), distance});
+				}
+			}
+		}
+
+		for (auto q = std::size_t{0}; q < out.size(); ++q) {
+			out[q] = std::move(heaps[q]).sorted();
+			if (metric_ == knn_metric::l2) {
+				for (auto& n : out[q]) {
+					n.distance = std::sqrt(n.distance);
+				}
+			}
+		}
+	}
+} // namespace comp6771
@@ -0,0 +1,198 @@
+#include "comp6771/parallel.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace comp6771 {
+	// ========================== CONSTRUCTORS ==========================
+	thread_pool::thread_pool(int threads) {
+		for (auto i = 1; i < threads; ++i) {
+			workers_.emplace_back([this](std::stop_token const& stop) { this->work(stop); });
+		}
+	}
+
+	// DESTRUCTOR
+	thread_pool::~thread_pool() {
+		for (auto& worker : workers_) {
+			worker.request_stop();
+		}
+		// The jthreads join as workers_ is destroyed.
+	}
+
+	// =========================== MEMBER FUNCTIONS ===========================
+	auto thread_pool::run(std::size_t tasks, std::function<void(std::size_t)> const& task) -> void {
+		if (tasks == 0) {
+			return;
+		}
+		if (workers_.empty() or tasks == 1) {
+			for (auto i = std::size_t{0}; i < tasks; ++i) {
+				task(i);
+			}
+			return;
+		}
+
+		auto const turn = std::scoped_lock(run_mutex_);
+		{
+			auto lock = std::unique_lock(mutex_);
+			// A worker may still be leaving the previous run.
+			done_.wait(lock, [this] { return busy_ == 0; });
+			task_ = &task;
+			tasks_ = tasks;
+			next_ = 0;
+			finished_ = 0;
+			error_ = nullptr;
+			++generation_;
+		}
+		wake_.notify_all();
+		this->drain(task, tasks);
+
+		auto lock = std::unique_lock(mutex_);
+		done_.wait(lock, [this] { return finished_ == tasks_ and busy_ == 0; });
+		task_ = nullptr;
+		if (error_ != nullptr) {
+			std::rethrow_exception(std::exchange(error_, nullptr));
+		}
+	}
+
+	auto thread_pool::global() -> thread_pool& {
+		static auto pool = thread_pool();
+		return pool;
+	}
+
+	auto thread_pool::work(std::stop_token const& stop) -> void {
+		auto seen = std::size_t{0};
+		while (true) {
+			auto lock = std::unique_lock(mutex_);
+			if (not wake_.wait(lock, stop, [&] { return generation_ != seen and task_ != nullptr; })) {
+				return;
+			}
+			seen = generation_;
+			auto const& task = *task_;
+			auto const tasks = tasks_;
+			++busy_;
+			lock.unlock();
+
+			this->drain(task, tasks);
+
+			lock.lock();
+			--busy_;
+			if (busy_ == 0) {
+				done_.notify_all();
+			}
+		}
+	}
+
+	// Claims tasks one at a time until none are left.
+	auto thread_pool::drain(std::function<void(std::size_t)> const& task, std::size_t tasks)
+	   -> void {
+		auto lock = std::unique_lock(mutex_);
+		while (next_ < tasks) {
+			auto const i = next_++;
+			lock.unlock();
+			try {
+				task(i);
+			} catch (...) {
+				lock.lock();
+				if (error_ == nullptr) {
+					error_ = std::current_exception();
+				}
+				lock.unlock();
+			}
+			lock.lock();
+			if (++finished_ == tasks) {
+				done_.notify_all();
+			}
+		}
+	}
+
+	namespace {
+		auto chunks(std::size_t n) -> std::size_t {
+			return (n + parallel_chunk - 1) / parallel_chunk;
+		}
+
+		// Runs partial(first, count) over each chunk and sums the results in chunk order.
+		template<typename Partial>
+		auto reduce(parallel_policy const& policy, std::size_t n, Partial partial) -> double {
+			auto const count = chunks(n);
+			if (count <= 1) {
+				return partial(std::size_t{0}, n);
+			}
+			auto sums = std::vector<double>(count);
+			pool_of(policy).run(count, [&](std::size_t c) {
+				auto const first = c * parallel_chunk;
+				sums[c] = partial(first, std::min(parallel_chunk, n - first));
+			});
+			return std::accumulate(sums.begin(), sums.end(), 0.0);
+		}
+	} // namespace
+
+	// =========================== UTILITY ===========================
+	// Summed per chunk, the norm can differ in its last bits from the serial one the cache holds,
+	// so it is only ever read from the cache, never stored in it.
+	auto euclidean_norm(parallel_policy const& policy, euclidean_vector const& v) -> double {
+		auto const norm = v.norm_.load(std::memory_order_relaxed);
+		ev_count_norm_lookup(norm != euclidean_vector::no_norm);
+		if (norm != euclidean_vector::no_norm) {
+			return norm;
+		}
+		return euclidean_norm(policy, std::span(v.data(), v.dimensions_));
+	}
+
+	auto euclidean_norm(parallel_policy const& policy, std::span<double const> v) -> double {
+		auto const& kernels = kernels::active();
+		auto const squares = reduce(policy, v.size(), [&](std::size_t first, std::size_t count) {
+			return kernels.sum_squares(v.subspan(first).data(), count);
+		});
+		return std::sqrt(squares);
+	}
+
+	auto dot(parallel_policy const& policy, euclidean_vector const& x, euclidean_vector const& y)
+	   -> double {
+		return dot(policy,
+		           std::span(x.data(), itos(x.dimensions())),
+		           std::span(y.data(), itos(y.dimensions())));
+	}
+
+	auto dot(parallel_policy const& policy, std::span<double const> x, std::span<double const> y)
+	   -> double {
+		euclidean_vector::check_dimensions(static_cast<int>(x.size()), static_cast<int>(y.size()));
+		auto const& kernels = kernels::active();
+		return reduce(policy, x.size(), [&](std::size_t first, std::size_t count) {
+			return kernels.dot(x.subspan(first).data(), y.subspan(first).data(), count);
+		});
+	}
+
+	auto add_assign(parallel_policy const& policy, euclidean_vector& y, euclidean_vector const& x)
+	   -> void {
+		euclidean_vector::check_dimensions(y.dimensions(), x.dimensions());
+		add_assign(policy,
+		           std::span(y.magnitudes_.get(), y.dimensions_),
+		           std::span(x.data(), x.dimensions_));
+		y.invalidate_norm();
+	}
+
+	auto add_assign(parallel_policy const& policy, std::span<double> y, std::span<double const> x)
+	   -> void {
+		euclidean_vector::check_dimensions(static_cast<int>(y.size()), static_cast<int>(x.size()));
+		auto const& kernels = kernels::active();
+		auto const count = chunks(y.size());
+		if (count <= 1) {
+			kernels.add(y.data(), x.data(), y.size());
+			return;
+		}
+		pool_of(policy).run(count, [&](std::size_t c) {
+			auto const first = c * parallel_chunk;
+			auto const n = std::min(parallel_chunk, y.size() - first);
+			kernels.add(y.subspan(first).data(), x.subspan(first).data(), n);
+		});
+	}
+} // namespace comp6771
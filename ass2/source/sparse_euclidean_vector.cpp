@@ -0,0 +1,300 @@
+#include "comp6771/sparse_euclidean_vector.hpp"
+#include "comp6771/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace comp6771 {
+	namespace {
+		// Sparse·sparse dot products gallop when one list is this many times longer than the other.
+		constexpr auto gallop_ratio = std::size_t{16};
+
+		// The first position at or after `first` whose index is not below `target`, found by
+		// doubling the step until it overshoots and then bisecting the last step.
+		auto gallop(std::span<int const> indices, std::size_t first, int target) -> std::size_t {
+			auto step = std::size_t{1};
+			auto last = first;
+			while (last < indices.size() and indices[last] < target) {
+				first = last + 1;
+				last += step;
+				step *= 2;
+			}
+			last = std::min(last, indices.size());
+			auto const it = std::lower_bound(indices.begin() + static_cast<std::ptrdiff_t>(first),
+			                                 indices.begin() + static_cast<std::ptrdiff_t>(last),
+			                                 target);
+			return static_cast<std::size_t>(it - indices.begin());
+		}
+
+		auto merge_dot(sparse_euclidean_vector const& x, sparse_euclidean_vector const& y)
+		   -> double {
+			auto const xi = x.indices();
+			auto const yi = y.indices();
+			auto result = 0.0;
+			auto i = std::size_t{0};
+			auto j = std::size_t{0};
+			while (i < xi.size() and j < yi.size()) {
+				if (xi[i] < yi[j]) {
+					++i;
+				}
+				else if (yi[j] < xi[i]) {
+					++j;
+				}
+				else {
+					result += x.values()[i++] * y.values()[j++];
+				}
+			}
+			return result;
+		}
+
+		// `shorter` has far fewer nonzeros than `longer`.
+		auto galloping_dot(sparse_euclidean_vector const& shorter,
+		                   sparse_euclidean_vector const& longer) -> double {
+			auto const li = longer.indices();
+			auto result = 0.0;
+			auto j = std::size_t{0};
+			for (auto i = std::size_t{0}; i < shorter.indices().size() and j < li.size(); ++i) {
+				j = gallop(li, j, shorter.indices()[i]);
+				if (j < li.size() and li[j] == shorter.indices()[i]) {
+					result += shorter.values()[i] * longer.values()[j];
+				}
+			}
+			return result;
+		}
+	} // namespace
+
+	// ========================== CONSTRUCTORS ==========================
+	// SINGLE-ARGUMENT CONSTRUCTOR
+	sparse_euclidean_vector::sparse_euclidean_vector(int dim, allocator_type const& alloc)
+	: dimensions_{dim}
+	, indices_{alloc.resource()}
+	, values_{alloc.resource()} {}
+
+	// ENTRIES CONSTRUCTOR
+	sparse_euclidean_vector::sparse_euclidean_vector(int dim,
+	                                                 std::span<int const> indices,
+	                                                 std::span<double const> values,
+	                                                 allocator_type const& alloc)
+	: sparse_euclidean_vector(dim, alloc) {
+		if (indices.size() != values.size()) {
+			auto err_msg = "Number of indices (" + std::to_string(indices.size())
+			               + ") and values (" + std::to_string(values.size()) + ") do not match";
+			throw euclidean_vector_error(err_msg);
+		}
+		std::for_each (indices.begin(), indices.end(), [this](int i) { this->check_index(i); });
+
+		// Entries usually arrive sorted already; only permute them when they don't.
+		auto order = std::vector<std::size_t>();
+		if (not std::is_sorted(indices.begin(), indices.end())) {
+			order.resize(indices.size());
+			std::iota(order.begin(), order.end(), std::size_t{0});
+			std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+				return indices[a] < indices[b];
+			});
+		}
+		indices_.reserve(indices.size());
+		values_.reserve(values.size());
+		for (auto k = std::size_t{0}; k < indices.size(); ++k) {
+			auto const from = order.empty() ? k : order[k];
+			if (not indices_.empty() and indices_.back() == indices[from]) {
+				values_.back() += values[from];
+			}
+			else {
+				indices_.push_back(indices[from]);
+				values_.push_back(values[from]);
+			}
+		}
+		this->drop_zeros();
+	}
+
+	// DENSE CONSTRUCTOR
+	sparse_euclidean_vector::sparse_euclidean_vector(euclidean_vector const& dense,
+	                                                 allocator_type const& alloc)
+	: sparse_euclidean_vector(std::span<double const>(dense.data(), itos(dense.dimensions())),
+	                          alloc) {}
+
+	sparse_euclidean_vector::sparse_euclidean_vector(std::span<double const> dense,
+	                                                 allocator_type const& alloc)
+	: sparse_euclidean_vector(static_cast<int>(dense.size()), alloc) {
+		// Counting first sizes the entries exactly.
+		auto const zeros = std::count(dense.begin(), dense.end(), 0.0);
+		auto const nonzeros = dense.size() - static_cast<std::size_t>(zeros);
+		indices_.reserve(nonzeros);
+		values_.reserve(nonzeros);
+		for (auto i = std::size_t{0}; i < dense.size(); ++i) {
+			if (dense[i] != 0.0) {
+				indices_.push_back(static_cast<int>(i));
+				values_.push_back(dense[i]);
+			}
+		}
+	}
+
+	// =========================== OPERATORS ===========================
+	// COMPOUND ADDITION OPERATOR
+	auto sparse_euclidean_vector::operator+=(sparse_euclidean_vector const& sv)
+	   -> sparse_euclidean_vector& {
+		this->merge(sv, 1.0);
+		return *this;
+	}
+
+	// COMPOUND SUBTRACTION OPERATOR
+	auto sparse_euclidean_vector::operator-=(sparse_euclidean_vector const& sv)
+	   -> sparse_euclidean_vector& {
+		this->merge(sv, -1.0);
+		return *this;
+	}
+
+	// COMPOUND MULTIPLICATION OPERATOR
+	auto sparse_euclidean_vector::operator*=(double d) -> sparse_euclidean_vector& {
+		kernels::active().scale(values_.data(), d, values_.size());
+		this->drop_zeros();
+		return *this;
+	}
+
+	// COMPOUND DIVISION OPERATOR
+	auto sparse_euclidean_vector::operator/=(double d) -> sparse_euclidean_vector& {
+		if (d == 0) {
+			const auto* err_msg = "Invalid vector division by 0";
+			throw euclidean_vector_error(err_msg);
+		}
+		kernels::active().divide(values_.data(), d, values_.size());
+		this->drop_zeros();
+		return *this;
+	}
+
+	// EUCLIDEAN VECTOR TYPE CONVERSION OPERATOR
+	sparse_euclidean_vector::operator euclidean_vector() const {
+		auto ev = euclidean_vector(dimensions_);
+		auto const magnitudes = ev.begin();
+		for (auto k = std::size_t{0}; k < indices_.size(); ++k) {
+			magnitudes[indices_[k]] = values_[k];
+		}
+		return ev;
+	}
+
+	// =========================== MEMBER FUNCTIONS ===========================
+	// AT METHOD
+	auto sparse_euclidean_vector::at(int i) const -> double {
+		this->check_index(i);
+		auto const it = std::lower_bound(indices_.begin(), indices_.end(), i);
+		if (it == indices_.end() or *it != i) {
+			return 0.0;
+		}
+		return values_[static_cast<std::size_t>(it - indices_.begin())];
+	}
+
+	auto sparse_euclidean_vector::check_index(int i) const -> void {
+		if (i < 0 or i >= dimensions_) {
+			auto err_msg =
+			   "Index " + std::to_string(i) + " is not valid for this sparse_euclidean_vector object";
+			throw euclidean_vector_error(err_msg);
+		}
+	}
+
+	// Builds the sum in fresh buffers from this vector's resource, sized for the worst case of no
+	// shared indices, then swaps them in.
+	auto sparse_euclidean_vector::merge(sparse_euclidean_vector const& sv, double sign) -> void {
+		euclidean_vector::check_dimensions(this->dimensions(), sv.dimensions());
+		if (sv.indices_.empty()) {
+			return;
+		}
+		auto indices = std::pmr::vector<int>(indices_.get_allocator());
+		auto values = std::pmr::vector<double>(values_.get_allocator());
+		indices.reserve(indices_.size() + sv.indices_.size());
+		values.reserve(values_.size() + sv.values_.size());
+
+		auto i = std::size_t{0};
+		auto j = std::size_t{0};
+		while (i < indices_.size() or j < sv.indices_.size()) {
+			if (j == sv.indices_.size() or (i < indices_.size() and indices_[i] < sv.indices_[j])) {
+				indices.push_back(indices_[i]);
+				values.push_back(values_[i++]);
+			}
+			else if (i == indices_.size() or sv.indices_[j] < indices_[i]) {
+				indices.push_back(sv.indices_[j]);
+				values.push_back(sign * sv.values_[j++]);
+			}
+			else if (auto const sum = values_[i] + sign * sv.values_[j]; sum != 0.0) {
+				indices.push_back(indices_[i++]);
+				values.push_back(sum);
+				++j;
+			}
+			else {
+				++i;
+				++j;
+			}
+		}
+		indices_ = std::move(indices);
+		values_ = std::move(values);
+	}
+
+	auto sparse_euclidean_vector::drop_zeros() -> void {
+		auto kept = std::size_t{0};
+		for (auto k = std::size_t{0}; k < values_.size(); ++k) {
+			if (values_[k] != 0.0) {
+				indices_[kept] = indices_[k];
+				values_[kept] = values_[k];
+				++kept;
+			}
+		}
+		indices_.resize(kept);
+		values_.resize(kept);
+	}
+
+	// =========================== UTILITY ===========================
+	// EUCLIDEAN NORMAL
+	auto euclidean_norm(sparse_euclidean_vector const& sv) -> double {
+		auto const values = sv.values();
+		return std::sqrt(kernels::active().sum_squares(values.data(), values.size()));
+	}
+
+	// DOT PRODUCT
+	auto dot(sparse_euclidean_vector const& x, sparse_euclidean_vector const& y) -> double {
+		euclidean_vector::check_dimensions(x.dimensions(), y.dimensions());
+		auto const x_nonzeros = itos(x.nonzeros());
+		auto const y_nonzeros = itos(y.nonzeros());
+		if (x_nonzeros * gallop_ratio < y_nonzeros) {
+			return galloping_dot(x, y);
+		}
+		if (y_nonzeros * gallop_ratio < x_nonzeros) {
+			return galloping_dot(y, x);
+		}
+		return merge_dot(x, y);
+	}
+
+	auto dot(sparse_euclidean_vector const& x, euclidean_vector const& y) -> double {
+		return dot(x, std::span<double const>(y.data(), itos(y.dimensions())));
+	}
+
+	auto dot(euclidean_vector const& x, sparse_euclidean_vector const& y) -> double {
+		return dot(y, x);
+	}
+
+	auto dot(sparse_euclidean_vector const& x, std::span<double const> y) -> double {
+		euclidean_vector::check_dimensions(x.dimensions(), static_cast<int>(y.size()));
+		auto const indices = x.indices();
+		auto const values = x.values();
+		auto result = 0.0;
+		for (auto k = std::size_t{0}; k < indices.size(); ++k) {
+			result += values[k] * y[itos(indices[k])];
+		}
+		return result;
+	}
+
+	// AXPY
+	auto axpy(double a, sparse_euclidean_vector const& x, euclidean_vector& y) -> void {
+		euclidean_vector::check_dimensions(x.dimensions(), y.dimensions());
+		auto const indices = x.indices();
+		auto const values = x.values();
+		// Mutable iterators drop y's cached norm.
+		auto const magnitudes = y.begin();
+		for (auto k = std::size_t{0}; k < indices.size(); ++k) {
+			magnitudes[indices[k]] += a * values[k];
+		}
+	}
+} // namespace comp6771
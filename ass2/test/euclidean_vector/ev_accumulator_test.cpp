@@ -0,0 +1,90 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_accumulator.hpp"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <vector>
+
+SCENARIO("Accumulator Test") {
+	GIVEN("An accumulator of 3 dimensions") {
+		auto total = comp6771::euclidean_vector_accumulator(3, 4);
+		CHECK(total.dimensions() == 3);
+		CHECK(total.shards() == 4);
+		CHECK(total.snapshot() == comp6771::euclidean_vector(3));
+		WHEN("Vectors are added to it") {
+			total.add(comp6771::euclidean_vector{1, 2, 3});
+			auto const magnitudes = std::vector<double>{0.5, -1, 4};
+			total.add(std::span<double const>(magnitudes));
+			THEN("The snapshot is their sum") {
+				CHECK(total.snapshot() == comp6771::euclidean_vector{1.5, 1, 7});
+				CHECK(total.snapshot() == total.snapshot());
+			}
+			THEN("Resetting it zeroes the total") {
+				total.reset();
+				CHECK(total.snapshot() == comp6771::euclidean_vector(3));
+				total.add(comp6771::euclidean_vector{1, 1, 1});
+				CHECK(total.snapshot() == comp6771::euclidean_vector{1, 1, 1});
+			}
+		}
+		WHEN("Something that doesn't fit is added") {
+			CHECK_THROWS_WITH(total.add(comp6771::euclidean_vector(2)),
+			                  "Dimensions of LHS(3) and RHS(2) do not match");
+		}
+	}
+	GIVEN("An accumulator of no dimensions") {
+		auto total = comp6771::euclidean_vector_accumulator(0, 1);
+		total.add(comp6771::euclidean_vector(0));
+		CHECK(total.snapshot().dimensions() == 0);
+	}
+	GIVEN("No shards") {
+		CHECK_THROWS_WITH(comp6771::euclidean_vector_accumulator(3, 0),
+		                  "Invalid shard count (0) for euclidean_vector_accumulator");
+	}
+	GIVEN("Negative dimensions") {
+		CHECK_THROWS_WITH(comp6771::euclidean_vector_accumulator(-1, 2),
+		                  "Invalid dimensions (-1) for euclidean_vector_accumulator");
+	}
+	GIVEN("The default shard count") {
+		CHECK(comp6771::euclidean_vector_accumulator(3).shards() >= 1);
+	}
+}
+
+SCENARIO("Concurrent Accumulator Test") {
+	GIVEN("More threads than shards adding at once while others take snapshots") {
+		constexpr auto dim = 37;
+		constexpr auto adds = 2000;
+		auto total = comp6771::euclidean_vector_accumulator(dim, 3);
+		auto const one = comp6771::euclidean_vector(dim, 1.0);
+		// Catch2 assertions aren't thread-safe, so the snapshots' findings are checked afterwards.
+		auto torn = std::atomic<bool>(false);
+		{
+			auto threads = std::vector<std::jthread>();
+			for (auto t = 0; t < 8; ++t) {
+				threads.emplace_back([&total, &one] {
+					for (auto i = 0; i < adds; ++i) {
+						total.add(one);
+					}
+				});
+			}
+			threads.emplace_back([&total, &torn] {
+				for (auto i = 0; i < 100; ++i) {
+					auto const snapshot = total.snapshot();
+					for (auto j = 1; j < dim; ++j) {
+						if (snapshot[j] != snapshot[0]) {
+							torn = true;
+						}
+					}
+				}
+			});
+		}
+		THEN("Adds are seen whole, so every dimension of a snapshot always agrees") {
+			CHECK_FALSE(torn);
+		}
+		THEN("No add is lost") {
+			CHECK(total.snapshot() == comp6771::euclidean_vector(dim, 8.0 * adds));
+		}
+	}
+}
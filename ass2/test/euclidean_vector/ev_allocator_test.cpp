@@ -0,0 +1,98 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Dimensions large enough that the magnitudes can't be kept inline.
+	auto constexpr dim = 64;
+
+	auto values() -> std::vector<double> {
+		auto v = std::vector<double>(dim);
+		for (auto i = std::size_t{0}; i < v.size(); ++i) {
+			v[i] = static_cast<double>(i);
+		}
+		return v;
+	}
+} // namespace
+
+SCENARIO("Allocator Construction Test") {
+	GIVEN("A euclidean vector backed by an arena") {
+		auto buffer = std::array<std::byte, 4096>{};
+		auto arena = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size());
+		auto const v = values();
+
+		auto const a = comp6771::euclidean_vector(v.begin(), v.end(), &arena);
+		auto const b = comp6771::euclidean_vector(dim, 1.0, &arena);
+		auto const c = comp6771::euclidean_vector(a + b, &arena);
+		CHECK(a.get_allocator().resource() == &arena);
+		CHECK(b.get_allocator().resource() == &arena);
+		CHECK(c.get_allocator().resource() == &arena);
+		CHECK(c.at(dim - 1) == static_cast<double>(dim - 1) + 1.0);
+
+		auto const* const first = reinterpret_cast<std::byte const*>(a.data());
+		CHECK(first >= buffer.data());
+		CHECK(first < buffer.data() + buffer.size());
+	}
+	GIVEN("A euclidean vector constructed without an allocator") {
+		auto const a = comp6771::euclidean_vector(dim);
+		CHECK(a.get_allocator().resource() == std::pmr::get_default_resource());
+	}
+}
+
+SCENARIO("Allocator Propagation Test") {
+	auto arena = std::pmr::monotonic_buffer_resource();
+	auto const v = values();
+
+	GIVEN("A copy") {
+		auto const a = comp6771::euclidean_vector(v.begin(), v.end(), &arena);
+		auto const b = a;
+		auto const c = comp6771::euclidean_vector(a, &arena);
+		CHECK(b.get_allocator().resource() == std::pmr::get_default_resource());
+		CHECK(c.get_allocator().resource() == &arena);
+		CHECK(b == a);
+		CHECK(c == a);
+	}
+	GIVEN("A move") {
+		auto a = comp6771::euclidean_vector(v.begin(), v.end(), &arena);
+		auto const* const data = a.data();
+		auto const b = std::move(a);
+		CHECK(b.get_allocator().resource() == &arena);
+		CHECK(b.data() == data);
+	}
+	GIVEN("A move into a different resource") {
+		auto a = comp6771::euclidean_vector(v.begin(), v.end(), &arena);
+		auto const b = comp6771::euclidean_vector(std::move(a), std::pmr::new_delete_resource());
+		CHECK(b.get_allocator().resource() == std::pmr::new_delete_resource());
+		CHECK(b == comp6771::euclidean_vector(v.begin(), v.end()));
+	}
+	GIVEN("Assignment never changes the target's resource") {
+		auto a = comp6771::euclidean_vector(dim, 2.0, &arena);
+		auto b = comp6771::euclidean_vector(v.begin(), v.end());
+		a = b;
+		CHECK(a.get_allocator().resource() == &arena);
+		CHECK(a == b);
+
+		auto c = comp6771::euclidean_vector(dim, 3.0, &arena);
+		b = std::move(c);
+		CHECK(b.get_allocator().resource() == std::pmr::get_default_resource());
+		CHECK(b == comp6771::euclidean_vector(dim, 3.0));
+	}
+}
+
+SCENARIO("Allocator Container Test") {
+	GIVEN("A pmr container of euclidean vectors") {
+		auto arena = std::pmr::monotonic_buffer_resource();
+		auto vectors = std::pmr::vector<comp6771::euclidean_vector>(&arena);
+		vectors.emplace_back(dim, 1.0);
+		vectors.push_back(comp6771::euclidean_vector(dim, 2.0));
+		for (auto const& v : vectors) {
+			CHECK(v.get_allocator().resource() == &arena);
+		}
+		CHECK(vectors[1].at(0) == 2.0);
+	}
+}
@@ -0,0 +1,173 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Fills row i with {i, i + 1, ..., i + dim - 1} through the layout-agnostic setter.
+	auto make_batch(int size, int dim, comp6771::batch_layout layout)
+	   -> comp6771::euclidean_vector_batch {
+		auto batch = comp6771::euclidean_vector_batch(size, dim, layout);
+		for (auto i = 0; i < size; ++i) {
+			auto values = std::vector<double>();
+			for (auto d = 0; d < dim; ++d) {
+				values.push_back(static_cast<double>(i + d));
+			}
+			batch.set_row(i, comp6771::euclidean_vector(values.begin(), values.end()));
+		}
+		return batch;
+	}
+} // namespace
+
+SCENARIO("Batch Construction Test") {
+	GIVEN("A new batch") {
+		auto const batch = comp6771::euclidean_vector_batch(5, 3);
+		CHECK(batch.size() == 5);
+		CHECK(batch.dimensions() == 3);
+		CHECK(batch.layout() == comp6771::batch_layout::row_major);
+		CHECK(batch.at(4, 2) == 0.0);
+		CHECK(reinterpret_cast<std::uintptr_t>(batch.data().data())
+		         % comp6771::euclidean_vector_batch::alignment
+		      == 0);
+		CHECK_THROWS_WITH(batch.at(5, 0),
+		                  "Index (5, 0) is not valid for this euclidean_vector_batch object");
+	}
+	GIVEN("Copies and moves") {
+		auto batch = make_batch(4, 3, comp6771::batch_layout::column_major);
+		auto copy = batch;
+		CHECK(copy.at(3, 2) == 5.0);
+		CHECK(copy.layout() == comp6771::batch_layout::column_major);
+
+		auto moved = std::move(batch);
+		CHECK(moved.at(3, 2) == 5.0);
+		CHECK(batch.size() == 0);
+
+		copy = comp6771::euclidean_vector_batch(1, 1);
+		CHECK(copy.size() == 1);
+		copy = moved;
+		CHECK(copy.copy_row(2) == comp6771::euclidean_vector{2.0, 3.0, 4.0});
+	}
+	GIVEN("A batch moved into one with a different resource") {
+		auto arena = std::pmr::monotonic_buffer_resource();
+		auto target =
+		   comp6771::euclidean_vector_batch(1, 1, comp6771::batch_layout::row_major, &arena);
+		auto source = make_batch(4, 3, comp6771::batch_layout::column_major);
+		target = std::move(source);
+		CHECK(target.get_allocator().resource() == &arena);
+		CHECK(target.layout() == comp6771::batch_layout::column_major);
+		CHECK(target.copy_row(3) == comp6771::euclidean_vector{3.0, 4.0, 5.0});
+		CHECK(source.size() == 0);
+	}
+	GIVEN("Sizes that can't be allocated") {
+		CHECK_THROWS_WITH(comp6771::euclidean_vector_batch(-1, 3),
+		                  "Invalid size (-1) or dimensions (3) for euclidean_vector_batch");
+		CHECK_THROWS_WITH(comp6771::euclidean_vector_batch(3, -2),
+		                  "Invalid size (3) or dimensions (-2) for euclidean_vector_batch");
+		auto const max = std::numeric_limits<int>::max();
+		CHECK_THROWS_WITH(comp6771::euclidean_vector_batch(max, max),
+		                  "2147483647 vectors of 2147483647 dimensions are too many for one "
+		                  "euclidean_vector_batch");
+		CHECK(comp6771::euclidean_vector_batch(max, 0).size() == max);
+	}
+}
+
+SCENARIO("Batch Layout Test") {
+	GIVEN("The same vectors in both layouts") {
+		auto const rows = make_batch(3, 2, comp6771::batch_layout::row_major);
+		auto const columns = make_batch(3, 2, comp6771::batch_layout::column_major);
+		CHECK(std::vector<double>(rows.data().begin(), rows.data().end())
+		      == std::vector<double>{0, 1, 1, 2, 2, 3});
+		CHECK(std::vector<double>(columns.data().begin(), columns.data().end())
+		      == std::vector<double>{0, 1, 2, 1, 2, 3});
+		CHECK(rows.copy_row(1) == columns.copy_row(1));
+	}
+}
+
+SCENARIO("Row-Major View Test") {
+	GIVEN("The same vectors in both layouts") {
+		auto const rows = make_batch(3, 2, comp6771::batch_layout::row_major);
+		auto const columns = make_batch(3, 2, comp6771::batch_layout::column_major);
+		auto const in_place = comp6771::row_major_view(rows);
+		auto const copied = comp6771::row_major_view(columns);
+
+		THEN("Both read the rows contiguously, and only the column-major one is copied") {
+			CHECK(in_place.data().data() == rows.data().data());
+			CHECK(copied.data().data() != columns.data().data());
+			CHECK(std::equal(copied.data().begin(),
+			                 copied.data().end(),
+			                 in_place.data().begin(),
+			                 in_place.data().end()));
+			CHECK(copied.size() == 3);
+			CHECK(copied.dims() == 2);
+			CHECK(copied.row(2)[1] == 3.0);
+		}
+		THEN("row_major rearranges only the column-major batch") {
+			auto const rearranged = comp6771::row_major(columns);
+			CHECK(rearranged.layout() == comp6771::batch_layout::row_major);
+			CHECK(std::vector<double>(rearranged.data().begin(), rearranged.data().end())
+			      == std::vector<double>(rows.data().begin(), rows.data().end()));
+			auto copy = rows;
+			auto const* const buffer = copy.data().data();
+			CHECK(comp6771::row_major(std::move(copy)).data().data() == buffer);
+		}
+	}
+}
+
+SCENARIO("Batch Row View Test") {
+	GIVEN("Rows of a row-major batch") {
+		auto batch = make_batch(3, 4, comp6771::batch_layout::row_major);
+		auto const v = comp6771::euclidean_vector{1.0, 1.0, 1.0, 1.0};
+		CHECK(comp6771::dot(batch.row(2), v) == 2.0 + 3.0 + 4.0 + 5.0);
+		CHECK(comp6771::euclidean_norm(batch.row(0)) == std::sqrt(14.0));
+		CHECK(comp6771::unit(batch.row(1)) == comp6771::unit(batch.copy_row(1)));
+
+		batch.row(0)[3] = 10.0;
+		CHECK(batch.at(0, 3) == 10.0);
+		CHECK_THROWS_WITH(batch.row(3), "Row 3 is not valid for this euclidean_vector_batch object");
+	}
+	GIVEN("Rows of a column-major batch") {
+		auto const batch = make_batch(3, 4, comp6771::batch_layout::column_major);
+		CHECK_THROWS_WITH(batch.row(0),
+		                  "Rows of a column_major euclidean_vector_batch are not contiguous");
+	}
+}
+
+SCENARIO("Batch Bulk Operation Test") {
+	for (auto layout : {comp6771::batch_layout::row_major, comp6771::batch_layout::column_major}) {
+		GIVEN("A batch and a query") {
+			auto const batch = make_batch(37, 5, layout);
+			auto const query = comp6771::euclidean_vector{0.5, -1.0, 2.0, 0.25, 1.0};
+
+			auto const dots = comp6771::dot(batch, query);
+			auto const norms = comp6771::euclidean_norm(batch);
+			auto const units = comp6771::unit(batch);
+			REQUIRE(dots.size() == 37);
+			for (auto i = 0; i < batch.size(); ++i) {
+				auto const row = batch.copy_row(i);
+				auto const idx = static_cast<std::size_t>(i);
+				CHECK(dots[idx] == Approx(comp6771::dot(row, query)));
+				CHECK(norms[idx] == Approx(comp6771::euclidean_norm(row)));
+				CHECK(comp6771::euclidean_norm(units.copy_row(i)) == Approx(1.0));
+			}
+			CHECK(units.layout() == layout);
+		}
+		GIVEN("Invalid bulk operations") {
+			auto const batch = make_batch(2, 3, layout);
+			auto out = std::vector<double>(3);
+			CHECK_THROWS_WITH(comp6771::dot(batch, comp6771::euclidean_vector(2)),
+			                  "Dimensions of LHS(3) and RHS(2) do not match");
+			CHECK_THROWS_WITH(comp6771::euclidean_norm(batch, out),
+			                  "Output of size 3 does not match euclidean_vector_batch of size 2");
+			CHECK_THROWS_WITH(comp6771::unit(comp6771::euclidean_vector_batch(2, 3, layout)),
+			                  "euclidean_vector with zero euclidean normal does not have a unit "
+			                  "vector");
+		}
+	}
+}
@@ -0,0 +1,125 @@
+#include "comp6771/counters.hpp"
+
+#include "comp6771/euclidean_vector.hpp"
+#include <catch2/catch.hpp>
+#include <thread>
+#include <utility>
+
+// Built with COMP6771_EV_COUNTERS=1 against euclidean_vector_counted.
+static_assert(comp6771::ev_counters_enabled);
+
+namespace {
+	// Dimensions large enough that the magnitudes can't be kept inline.
+	auto constexpr dim = 64;
+	auto constexpr bytes = dim * sizeof(double);
+} // namespace
+
+SCENARIO("Allocation Counter Test") {
+	GIVEN("A counter scope") {
+		auto const scope = comp6771::ev_counter_scope();
+
+		WHEN("Vectors are constructed") {
+			auto const a = comp6771::euclidean_vector(dim, 1.0);
+			auto const small = comp6771::euclidean_vector(4, 1.0);
+
+			THEN("Only the heap buffer is counted") {
+				CHECK(scope.counted().allocations == 1);
+				CHECK(scope.counted().allocated_bytes == bytes);
+			}
+		}
+
+		WHEN("A vector is copied") {
+			auto const a = comp6771::euclidean_vector(dim, 1.0);
+			auto b = a;
+			b = a;
+
+			THEN("Each copy is counted, and only the construction allocates") {
+				CHECK(scope.counted().copies == 2);
+				CHECK(scope.counted().allocations == 2);
+			}
+		}
+
+		WHEN("A vector is moved") {
+			auto a = comp6771::euclidean_vector(dim, 1.0);
+			auto b = std::move(a);
+			a = std::move(b);
+
+			THEN("Each move is counted and nothing is copied") {
+				CHECK(scope.counted().moves == 2);
+				CHECK(scope.counted().copies == 0);
+				CHECK(scope.counted().allocations == 1);
+			}
+		}
+
+		WHEN("A vector changes precision") {
+			auto const a = comp6771::euclidean_vector(dim, 1.0);
+			auto const b = comp6771::float_euclidean_vector(a);
+
+			THEN("The conversion counts as a copy") {
+				CHECK(scope.counted().copies == 1);
+				CHECK(scope.counted().allocated_bytes == bytes + dim * sizeof(float));
+			}
+		}
+
+		WHEN("An expression is evaluated") {
+			auto const a = comp6771::euclidean_vector(dim, 1.0);
+			auto const b = comp6771::euclidean_vector(dim, 2.0);
+			auto const before = scope.counted();
+			auto const c = comp6771::euclidean_vector(a + b * 2.0);
+
+			THEN("Only the result is allocated") {
+				auto const counted = scope.counted() - before;
+				CHECK(counted.allocations == 1);
+				CHECK(counted.copies == 0);
+			}
+		}
+	}
+}
+
+SCENARIO("Norm Cache Counter Test") {
+	GIVEN("A vector") {
+		auto v = comp6771::euclidean_vector(dim, 2.0);
+		auto const scope = comp6771::ev_counter_scope();
+
+		WHEN("Its norm is read twice") {
+			comp6771::euclidean_norm(v);
+			comp6771::euclidean_norm(v);
+
+			THEN("The first misses and the second hits") {
+				CHECK(scope.counted().norm_cache_misses == 1);
+				CHECK(scope.counted().norm_cache_hits == 1);
+			}
+		}
+
+		WHEN("It changes between reads") {
+			comp6771::euclidean_norm(v);
+			v += v;
+			comp6771::euclidean_norm(v);
+
+			THEN("Both miss") {
+				CHECK(scope.counted().norm_cache_misses == 2);
+				CHECK(scope.counted().norm_cache_hits == 0);
+			}
+		}
+	}
+}
+
+SCENARIO("Per-Thread Counter Test") {
+	GIVEN("A counter scope on this thread") {
+		auto const scope = comp6771::ev_counter_scope();
+
+		WHEN("Another thread allocates") {
+			auto other = comp6771::ev_counters();
+			auto worker = std::thread([&other] {
+				auto const a = comp6771::euclidean_vector(dim, 1.0);
+				other = comp6771::ev_counters_snapshot();
+			});
+			worker.join();
+
+			THEN("Only that thread counts it") {
+				CHECK(other.allocations == 1);
+				CHECK(scope.counted() == comp6771::ev_counters());
+			}
+		}
+	}
+}
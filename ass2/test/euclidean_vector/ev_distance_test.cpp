@@ -0,0 +1,177 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_distance.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace {
+	using comp6771::distance_metric;
+
+	constexpr auto metrics = std::array{distance_metric::l1,
+	                                    distance_metric::squared_l2,
+	                                    distance_metric::linf,
+	                                    distance_metric::cosine};
+
+	auto make_batch(int size, int dim, double seed, comp6771::batch_layout layout = {})
+	   -> comp6771::euclidean_vector_batch {
+		auto batch = comp6771::euclidean_vector_batch(size, dim, layout);
+		for (auto i = 0; i < size; ++i) {
+			for (auto d = 0; d < dim; ++d) {
+				batch.at(i, d) = seed * static_cast<double>((i * 5 + d * 3) % 11) - (d % 4);
+			}
+		}
+		return batch;
+	}
+
+	// The textbook definition of each metric, one pair at a time.
+	auto naive_distance(distance_metric metric,
+	                    std::vector<double> const& x,
+	                    std::vector<double> const& y) -> double {
+		auto sum = 0.0;
+		auto dot = 0.0;
+		auto xx = 0.0;
+		auto yy = 0.0;
+		for (auto i = std::size_t{0}; i < x.size(); ++i) {
+			auto const d = std::abs(x[i] - y[i]);
+			switch (metric) {
+			case distance_metric::l1: sum += d; break;
+			case distance_metric::squared_l2: sum += d * d; break;
+			case distance_metric::linf: sum = std::max(sum, d); break;
+			case distance_metric::cosine:
+				dot += x[i] * y[i];
+				xx += x[i] * x[i];
+				yy += y[i] * y[i];
+				break;
+			}
+		}
+		if (metric != distance_metric::cosine) {
+			return sum;
+		}
+		return xx == 0.0 or yy == 0.0 ? 1.0 : 1.0 - dot / std::sqrt(xx * yy);
+	}
+
+	auto row_of(comp6771::euclidean_vector_batch const& batch, int i) -> std::vector<double> {
+		auto row = std::vector<double>();
+		for (auto d = 0; d < batch.dimensions(); ++d) {
+			row.push_back(batch.at(i, d));
+		}
+		return row;
+	}
+} // namespace
+
+SCENARIO("One-To-Many Distance Test") {
+	GIVEN("Batches in either layout and dimensions that exercise the vector tails") {
+		using comp6771::batch_layout;
+		for (auto layout : {batch_layout::row_major, batch_layout::column_major}) {
+			for (auto dim : {0, 1, 3, 8, 17, 100}) {
+				auto const batch = make_batch(13, dim, 1.5, layout);
+				auto const query_magnitudes = row_of(make_batch(1, dim, -0.75), 0);
+				auto const query =
+				   comp6771::euclidean_vector(query_magnitudes.begin(), query_magnitudes.end());
+				for (auto metric : metrics) {
+					auto const result = comp6771::distances(metric, batch, query);
+					REQUIRE(result.size() == 13);
+					for (auto i = 0; i < batch.size(); ++i) {
+						auto const x = row_of(batch, i);
+						auto const expected = naive_distance(metric, x, query_magnitudes);
+						CHECK(result[static_cast<std::size_t>(i)] == Approx(expected));
+					}
+				}
+			}
+		}
+	}
+	GIVEN("Vectors with zero norm") {
+		auto const batch = comp6771::euclidean_vector_batch(2, 3);
+		auto const result =
+		   comp6771::distances(distance_metric::cosine, batch, comp6771::euclidean_vector{1, 2, 3});
+		CHECK(result == std::vector<double>{1.0, 1.0});
+	}
+	GIVEN("A NaN in the first dimension of a row, in either layout") {
+		using comp6771::batch_layout;
+		auto results = std::vector<double>();
+		for (auto layout : {batch_layout::row_major, batch_layout::column_major}) {
+			auto batch = make_batch(2, 17, 1.5, layout);
+			batch.at(0, 0) = std::numeric_limits<double>::quiet_NaN();
+			auto const result =
+			   comp6771::distances(distance_metric::linf, batch, comp6771::euclidean_vector(17));
+			results.insert(results.end(), result.begin(), result.end());
+		}
+		THEN("linf is NaN for that row only, whichever layout computed it") {
+			CHECK(std::isnan(results[0]));
+			CHECK(results[1] == results[3]);
+			CHECK(std::isnan(results[2]));
+		}
+	}
+	GIVEN("Operands that do not fit") {
+		auto const batch = comp6771::euclidean_vector_batch(2, 3);
+		CHECK_THROWS_WITH(
+		   comp6771::distances(distance_metric::l1, batch, comp6771::euclidean_vector(2)),
+		   "Dimensions of LHS(3) and RHS(2) do not match");
+		auto out = std::vector<double>(3);
+		CHECK_THROWS_WITH(
+		   comp6771::distances(distance_metric::l1, batch, comp6771::euclidean_vector(3), out),
+		   "Output of size 3 does not match euclidean_vector_batch of size 2");
+	}
+}
+
+SCENARIO("Pairwise Distance Test") {
+	GIVEN("Batches in either layout, one bigger than a cache block") {
+		using comp6771::batch_layout;
+		auto const a = make_batch(7, 33, 1.5);
+		auto const b = make_batch(1100, 33, -0.25, batch_layout::column_major);
+		for (auto metric : metrics) {
+			auto const result = comp6771::pairwise_distances(metric, a, b);
+			REQUIRE(result.rows() == 7);
+			REQUIRE(result.cols() == 1100);
+			for (auto i = 0; i < a.size(); ++i) {
+				auto const x = row_of(a, i);
+				for (auto j = 0; j < b.size(); j += 37) {
+					CHECK(result.at(i, j) == Approx(naive_distance(metric, x, row_of(b, j))));
+				}
+			}
+			THEN("Each row is the one-to-many distances of that row of the first batch") {
+				auto const query = a.copy_row(3);
+				auto const row = comp6771::distances(metric, make_batch(1100, 33, -0.25), query);
+				for (auto j = 0; j < b.size(); ++j) {
+					CHECK(result.at(3, j) == Approx(row[static_cast<std::size_t>(j)]));
+				}
+			}
+		}
+	}
+	GIVEN("Operands that do not fit") {
+		auto const a = comp6771::euclidean_vector_batch(2, 3);
+		auto const b = comp6771::euclidean_vector_batch(4, 3);
+		CHECK_THROWS_WITH(comp6771::pairwise_distances(distance_metric::linf,
+		                                               a,
+		                                               comp6771::euclidean_vector_batch(4, 2)),
+		                  "Dimensions of LHS(3) and RHS(2) do not match");
+		auto out = std::vector<double>(6);
+		CHECK_THROWS_WITH(comp6771::pairwise_distances(distance_metric::linf, a, b, out),
+		                  "Output of size 6 does not match 2x4 distances");
+	}
+}
+
+SCENARIO("Parallel Pairwise Distance Test") {
+	GIVEN("Enough pairs to split across threads") {
+		auto const a = make_batch(300, 64, 1.5);
+		auto const b = make_batch(200, 64, -0.25);
+		for (auto metric : metrics) {
+			auto const serial = comp6771::pairwise_distances(metric, a, b);
+			for (auto threads : {2, 3, 8}) {
+				auto pool = comp6771::thread_pool(threads);
+				auto const policy = comp6771::parallel_policy{&pool};
+				THEN("Every pool size gives the serial result exactly") {
+					CHECK(comp6771::pairwise_distances(policy, metric, a, b) == serial);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+SCENARIO("Expression Laziness Test") {
+	GIVEN("Arithmetic between euclidean vectors") {
+		auto const a = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		auto const b = comp6771::euclidean_vector{4.0, 5.0, 6.0};
+		auto const expr = a + b * 2.0;
+
+		CHECK(!std::is_same_v<std::remove_cvref_t<decltype(expr)>, comp6771::euclidean_vector>);
+		CHECK(expr.dimensions() == 3);
+		CHECK(expr.at(2) == 3.0 + 6.0 * 2.0);
+		CHECK_THROWS_WITH(expr.at(3), "Index 3 is not valid for this euclidean_vector object");
+	}
+}
+
+SCENARIO("Expression Evaluation Test 1") {
+	GIVEN("A chained expression assigned to a euclidean vector") {
+		auto const a = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		auto const b = comp6771::euclidean_vector{4.0, 5.0, 6.0};
+		auto const c = comp6771::euclidean_vector{0.5, 0.25, 0.125};
+
+		comp6771::euclidean_vector const r = a + b * 2.0 - c / 0.5;
+		CHECK(r.dimensions() == 3);
+		CHECK(r.at(0) == a.at(0) + b.at(0) * 2.0 - c.at(0) / 0.5);
+		CHECK(r.at(1) == a.at(1) + b.at(1) * 2.0 - c.at(1) / 0.5);
+		CHECK(r.at(2) == a.at(2) + b.at(2) * 2.0 - c.at(2) / 0.5);
+	}
+}
+
+SCENARIO("Expression Evaluation Test 2") {
+	GIVEN("An expression assigned over one of its own operands") {
+		auto a = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		auto const b = comp6771::euclidean_vector{4.0, 5.0, 6.0};
+		a = 3.0 * a + b;
+		CHECK(a == comp6771::euclidean_vector{7.0, 11.0, 15.0});
+	}
+	GIVEN("An expression assigned to a vector of a different dimension") {
+		auto a = comp6771::euclidean_vector{1.0};
+		auto const b = comp6771::euclidean_vector{4.0, 5.0, 6.0};
+		a = b + b;
+		CHECK(a == comp6771::euclidean_vector{8.0, 10.0, 12.0});
+	}
+}
+
+SCENARIO("Expression Evaluation Test 3") {
+	GIVEN("Compound assignment from an expression") {
+		auto a = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		auto const b = comp6771::euclidean_vector{4.0, 5.0, 6.0};
+		a += b * 2.0;
+		CHECK(a == comp6771::euclidean_vector{9.0, 12.0, 15.0});
+		a -= b + b;
+		CHECK(a == comp6771::euclidean_vector{1.0, 2.0, 3.0});
+		CHECK_THROWS_WITH(a += comp6771::euclidean_vector(2) * 2.0,
+		                  "Dimensions of LHS(3) and RHS(2) do not match");
+	}
+}
+
+SCENARIO("Expression Lifetime Test") {
+	GIVEN("An expression holding a temporary euclidean vector") {
+		auto const b = comp6771::euclidean_vector{4.0, 5.0, 6.0};
+		auto const expr = comp6771::euclidean_vector{1.0, 1.0, 1.0} + b;
+		CHECK(expr.at(0) == 5.0);
+		CHECK(comp6771::euclidean_vector(expr) == comp6771::euclidean_vector{5.0, 6.0, 7.0});
+	}
+}
+
+SCENARIO("Expression Error Test") {
+	GIVEN("A mismatch nested inside a chain") {
+		auto const a = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		auto const b = comp6771::euclidean_vector{1.0, 2.0};
+		CHECK_THROWS_AS(a * 2.0 + b, comp6771::euclidean_vector_error);
+		CHECK_THROWS_WITH(a + a - b, "Dimensions of LHS(3) and RHS(2) do not match");
+		CHECK_THROWS_WITH((a + a) / 0.0, "Invalid vector division by 0");
+	}
+}
+
+SCENARIO("Expression Interoperability Test") {
+	GIVEN("Expressions passed where a euclidean vector is expected") {
+		auto const a = comp6771::euclidean_vector{3.0, 4.0};
+		auto oss = std::ostringstream{};
+		oss << a * 2.0;
+		CHECK(oss.str() == "[6 8]");
+		CHECK(comp6771::euclidean_norm(a + a) == 10.0);
+		CHECK(comp6771::dot(a - a, a) == 0.0);
+		CHECK(a * 2.0 == a + a);
+	}
+}
@@ -0,0 +1,140 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_file.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "scratch_file.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using comp6771_test::scratch_file;
+
+SCENARIO("File Round Trip Test") {
+	GIVEN("Vectors streamed to a file") {
+		auto const file = scratch_file("round_trip", "ev");
+		auto const a = comp6771::euclidean_vector{1.0, -2.0, 3.5};
+		auto const b = comp6771::euclidean_vector{0.0, 1e-300, -1e300};
+		{
+			auto writer = comp6771::euclidean_vector_writer(file.path(), 3);
+			writer.write(a);
+			writer.write(b);
+			CHECK(writer.size() == 2);
+			CHECK_THROWS_WITH(writer.write(comp6771::euclidean_vector(2)),
+			                  "Dimensions of LHS(2) and RHS(3) do not match");
+		}
+		CHECK(std::filesystem::file_size(file.path()) == 64 + 2 * 3 * sizeof(double));
+
+		auto const header = comp6771::read_euclidean_vector_file_header(file.path());
+		CHECK(header.version == 1);
+		CHECK(header.count == 2);
+		CHECK(header.dimensions == 3);
+		CHECK(header.data_offset == 64);
+
+		WHEN("It is mapped") {
+			auto mapped = comp6771::mapped_euclidean_vector_file(file.path());
+			REQUIRE(mapped.size() == 2);
+			CHECK(mapped.dimensions() == 3);
+			CHECK(reinterpret_cast<std::uintptr_t>(mapped.data().data()) % 64 == 0);
+			CHECK(static_cast<comp6771::euclidean_vector>(mapped[0]) == a);
+			CHECK(static_cast<comp6771::euclidean_vector>(mapped.at(1)) == b);
+			CHECK(comp6771::dot(mapped[0], a) == comp6771::dot(a, a));
+			CHECK_THROWS_WITH(mapped.at(2),
+			                  "Index 2 is not valid for this mapped_euclidean_vector_file");
+
+			auto moved = std::move(mapped);
+			CHECK(moved.size() == 2);
+		}
+		WHEN("It is loaded into a batch") {
+			auto const batch = comp6771::load_euclidean_vector_batch(file.path());
+			REQUIRE(batch.size() == 2);
+			CHECK(batch.copy_row(0) == a);
+			CHECK(batch.copy_row(1) == b);
+		}
+	}
+	GIVEN("A column-major batch saved to a file") {
+		auto const file = scratch_file("column_major", "ev");
+		auto batch = comp6771::euclidean_vector_batch(3, 2, comp6771::batch_layout::column_major);
+		batch.set_row(0, {1.0, 2.0});
+		batch.set_row(1, {3.0, 4.0});
+		batch.set_row(2, {5.0, 6.0});
+		comp6771::save_euclidean_vector_batch(file.path(), batch);
+
+		auto const mapped = comp6771::mapped_euclidean_vector_file(file.path());
+		CHECK(std::vector<double>(mapped.data().begin(), mapped.data().end())
+		      == std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+	}
+	GIVEN("A writer moved over one that is still writing") {
+		auto const first = scratch_file("move_assigned_first", "ev");
+		auto const second = scratch_file("move_assigned_second", "ev");
+		auto writer = comp6771::euclidean_vector_writer(first.path(), 2);
+		writer.write(comp6771::euclidean_vector{1.0, 2.0});
+		writer = comp6771::euclidean_vector_writer(second.path(), 3);
+		THEN("The first file is finished before the writer moves on") {
+			CHECK(comp6771::read_euclidean_vector_file_header(first.path()).count == 1);
+			writer.write(comp6771::euclidean_vector{1.0, 2.0, 3.0});
+			writer.close();
+			CHECK(comp6771::load_euclidean_vector_batch(second.path()).copy_row(0)
+			      == comp6771::euclidean_vector{1.0, 2.0, 3.0});
+		}
+	}
+	GIVEN("An empty collection") {
+		auto const file = scratch_file("empty", "ev");
+		comp6771::euclidean_vector_writer(file.path(), 4).close();
+		auto const mapped = comp6771::mapped_euclidean_vector_file(file.path());
+		CHECK(mapped.size() == 0);
+		CHECK(mapped.dimensions() == 4);
+	}
+}
+
+SCENARIO("File Validation Test") {
+	GIVEN("A file that isn't a euclidean vector file") {
+		auto const file = scratch_file("not_ev", "ev");
+		std::ofstream(file.path()) << "[1 2 3]\n";
+		auto const message =
+		   file.path().string() + " is not a valid euclidean_vector file: bad magic";
+		CHECK_THROWS_WITH(comp6771::mapped_euclidean_vector_file(file.path()), message);
+		CHECK_THROWS_WITH(comp6771::load_euclidean_vector_batch(file.path()), message);
+	}
+	GIVEN("A truncated file") {
+		auto const file = scratch_file("truncated", "ev");
+		{
+			auto writer = comp6771::euclidean_vector_writer(file.path(), 2);
+			writer.write(comp6771::euclidean_vector{1.0, 2.0});
+		}
+		std::filesystem::resize_file(file.path(), 64 + sizeof(double));
+		auto const message =
+		   file.path().string() + " is not a valid euclidean_vector file: truncated";
+		CHECK_THROWS_WITH(comp6771::mapped_euclidean_vector_file(file.path()), message);
+		CHECK_THROWS_WITH(comp6771::load_euclidean_vector_batch(file.path()), message);
+	}
+	GIVEN("Headers with more vectors or dimensions than an int can count") {
+		auto const file = scratch_file("too_big", "ev");
+		auto const patch = [&](std::streamoff offset, std::uint64_t value) {
+			comp6771::euclidean_vector_writer(file.path(), 0).close();
+			auto out = std::fstream(file.path(), std::ios::in | std::ios::out | std::ios::binary);
+			out.seekp(offset);
+			for (auto i = 0; i < 8; ++i) {
+				out.put(static_cast<char>(value >> (8U * static_cast<unsigned>(i))));
+			}
+		};
+		auto const prefix = file.path().string() + " is not a valid euclidean_vector file: ";
+		patch(16, std::uint64_t{1} << 32U);
+		CHECK_THROWS_WITH(comp6771::mapped_euclidean_vector_file(file.path()),
+		                  prefix + "too many vectors");
+		CHECK_THROWS_WITH(comp6771::load_euclidean_vector_batch(file.path()),
+		                  prefix + "too many vectors");
+		patch(24, std::uint64_t{1} << 31U);
+		CHECK_THROWS_WITH(comp6771::read_euclidean_vector_file_header(file.path()),
+		                  prefix + "too many dimensions");
+	}
+	GIVEN("A file that doesn't exist") {
+		auto const file = scratch_file("missing", "ev");
+		CHECK_THROWS_WITH(comp6771::mapped_euclidean_vector_file(file.path()),
+		                  "Cannot open " + file.path().string());
+	}
+}
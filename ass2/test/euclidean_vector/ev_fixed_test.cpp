@@ -0,0 +1,79 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/fixed_euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+using comp6771::fixed_euclidean_vector;
+
+SCENARIO("Fixed Constexpr Test") {
+	GIVEN("Fixed vectors evaluated at compile time") {
+		constexpr auto a = fixed_euclidean_vector{1.0, 2.0, 2.0};
+		constexpr auto b = fixed_euclidean_vector<3>(0.5);
+		constexpr auto c = a + b * 2.0 - a / 2.0;
+
+		static_assert(a.dimensions() == 3);
+		static_assert(c == fixed_euclidean_vector{1.5, 2.0, 2.0});
+		static_assert(comp6771::dot(a, b) == 2.5);
+		static_assert(comp6771::euclidean_norm(a) == 3.0);
+		static_assert(comp6771::unit(a) == fixed_euclidean_vector{1.0 / 3.0, 2.0 / 3.0, 2.0 / 3.0});
+		static_assert(-a == fixed_euclidean_vector{-1.0, -2.0, -2.0});
+		static_assert(fixed_euclidean_vector<4>() == fixed_euclidean_vector<4>(0.0));
+		CHECK(comp6771::euclidean_norm(fixed_euclidean_vector{3.0, 4.0}) == 5.0);
+	}
+	GIVEN("Magnitudes that are not finite") {
+		constexpr auto inf = std::numeric_limits<double>::infinity();
+		constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+
+		static_assert(comp6771::constexpr_sqrt(inf) == inf);
+		static_assert(comp6771::euclidean_norm(fixed_euclidean_vector{1.0, inf}) == inf);
+		constexpr auto root = comp6771::constexpr_sqrt(nan);
+		static_assert(root != root);
+		CHECK(std::isnan(comp6771::euclidean_norm(fixed_euclidean_vector{nan, 1.0})));
+	}
+}
+
+SCENARIO("Fixed Arithmetic Test") {
+	GIVEN("Runtime fixed vectors") {
+		auto a = fixed_euclidean_vector{1.782364, 2.987634, 3.982345, 0.5};
+		auto const b = fixed_euclidean_vector{2.876238, 3.986235, 4.871264, 0.25};
+		auto const sum = a + b;
+		CHECK(sum.at(0) == a.at(0) + b.at(0));
+		CHECK(sum[3] == 0.75);
+
+		a *= 2.0;
+		CHECK(a.at(3) == 1.0);
+		a -= a;
+		CHECK(a == fixed_euclidean_vector<4>());
+		CHECK(comp6771::euclidean_norm(b) == std::sqrt(comp6771::dot(b, b)));
+	}
+	GIVEN("Invalid operations") {
+		auto a = fixed_euclidean_vector{1.0, 2.0};
+		CHECK_THROWS_WITH(a / 0.0, "Invalid vector division by 0");
+		CHECK_THROWS_WITH(a.at(2), "Index 2 is not valid for this euclidean_vector object");
+		CHECK_THROWS_WITH(comp6771::unit(fixed_euclidean_vector<2>()),
+		                  "euclidean_vector with zero euclidean normal does not have a unit vector");
+	}
+}
+
+SCENARIO("Fixed Conversion Test") {
+	GIVEN("A fixed vector converted to a dynamic one and back") {
+		auto const a = fixed_euclidean_vector{7.0, 11.0, 360.0};
+		auto const ev = static_cast<comp6771::euclidean_vector>(a);
+		CHECK(ev == comp6771::euclidean_vector{7.0, 11.0, 360.0});
+		CHECK(fixed_euclidean_vector<3>(ev) == a);
+
+		auto os1 = std::ostringstream{};
+		auto os2 = std::ostringstream{};
+		os1 << a;
+		os2 << ev;
+		CHECK(os1.str() == os2.str());
+	}
+	GIVEN("A dynamic vector of the wrong dimension") {
+		auto const ev = comp6771::euclidean_vector{1.0, 2.0};
+		CHECK_THROWS_WITH(fixed_euclidean_vector<3>(ev),
+		                  "Dimensions of LHS(3) and RHS(2) do not match");
+	}
+}
@@ -0,0 +1,69 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <vector>
+
+SCENARIO("Fused Update Test") {
+	GIVEN("Two euclidean vectors") {
+		auto const x = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		auto y = comp6771::euclidean_vector{4.0, 5.0, 6.0};
+		CHECK(comp6771::euclidean_norm(y) == Approx(std::sqrt(77.0)));
+
+		comp6771::axpy(2.0, x, y);
+		CHECK(y == comp6771::euclidean_vector{6.0, 9.0, 12.0});
+		CHECK(comp6771::euclidean_norm(y) == Approx(std::sqrt(261.0)));
+
+		comp6771::axpby(2.0, x, -0.5, y);
+		CHECK(y == comp6771::euclidean_vector{-1.0, -0.5, 0.0});
+		CHECK(comp6771::euclidean_norm(y) == Approx(std::sqrt(1.25)));
+
+		CHECK_THROWS_WITH(comp6771::axpy(1.0, comp6771::euclidean_vector(2), y),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+	}
+	GIVEN("Views over external buffers") {
+		auto const x_mags = std::vector<double>{1.0, 2.0};
+		auto y_mags = std::vector<double>{3.0, 4.0};
+		auto const x = comp6771::const_euclidean_vector_view(x_mags);
+		auto const y = comp6771::euclidean_vector_view(y_mags);
+		comp6771::axpy(-1.0, x, y);
+		CHECK(y_mags == std::vector<double>{2.0, 2.0});
+		comp6771::axpby(1.0, x, 2.0, y);
+		CHECK(y_mags == std::vector<double>{5.0, 6.0});
+	}
+}
+
+SCENARIO("Fused Reduction Test") {
+	GIVEN("Two euclidean vectors") {
+		auto const x = comp6771::euclidean_vector{3.0, 4.0};
+		auto const y = comp6771::euclidean_vector{-4.0, 3.0};
+		auto const r = comp6771::dot_and_norms(x, y);
+		CHECK(r.dot == 0.0);
+		CHECK(r.x_norm == 5.0);
+		CHECK(r.y_norm == 5.0);
+		CHECK(comp6771::cosine_similarity(x, y) == 0.0);
+		CHECK(comp6771::cosine_similarity(x, x * 2.0) == Approx(1.0));
+		CHECK(comp6771::cosine_similarity(x, x * -3.0) == Approx(-1.0));
+		CHECK_THROWS_WITH(comp6771::cosine_similarity(x, comp6771::euclidean_vector(2)),
+		                  "euclidean_vector with zero euclidean normal does not have a cosine "
+		                  "similarity");
+		CHECK_THROWS_WITH(comp6771::dot_and_norms(x, comp6771::euclidean_vector(3)),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+	}
+	GIVEN("A long vector that exercises the vector kernels") {
+		auto mags = std::vector<double>(1001);
+		for (auto i = std::size_t{0}; i < mags.size(); ++i) {
+			mags[i] = static_cast<double>(i % 13) - 6.0;
+		}
+		auto const x = comp6771::euclidean_vector(mags.begin(), mags.end());
+		auto const y = x * 0.5 + comp6771::euclidean_vector(1001, 1.0);
+		auto const r = comp6771::dot_and_norms(x, y);
+		CHECK(r.dot == Approx(comp6771::dot(x, y)));
+		CHECK(r.x_norm == Approx(comp6771::euclidean_norm(mags)));
+		CHECK(r.y_norm == Approx(comp6771::euclidean_norm(y)));
+		CHECK(comp6771::cosine_similarity(comp6771::const_euclidean_vector_view(x),
+		                                  comp6771::const_euclidean_vector_view(y))
+		      == Approx(r.dot / (r.x_norm * r.y_norm)));
+	}
+}
@@ -0,0 +1,250 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/hnsw_index.hpp"
+#include "comp6771/knn_index.hpp"
+#include "comp6771/parallel.hpp"
+#include "scratch_file.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using comp6771_test::scratch_file;
+
+namespace {
+	// Points scattered around a handful of centres, which is closer to real embeddings than
+	// uniform noise.
+	auto clustered_batch(int size, int dim, unsigned seed) -> comp6771::euclidean_vector_batch {
+		auto engine = std::mt19937(seed);
+		auto centre = std::uniform_real_distribution<double>(-10.0, 10.0);
+		auto noise = std::normal_distribution<double>(0.0, 1.0);
+		auto centres = std::vector<double>(static_cast<std::size_t>(16 * dim));
+		std::generate(centres.begin(), centres.end(), [&] { return centre(engine); });
+		auto batch = comp6771::euclidean_vector_batch(size, dim);
+		for (auto i = 0; i < size; ++i) {
+			auto const c = static_cast<std::size_t>((i % 16) * dim);
+			for (auto d = 0; d < dim; ++d) {
+				batch.at(i, d) = centres[c + static_cast<std::size_t>(d)] + noise(engine);
+			}
+		}
+		return batch;
+	}
+
+	// The fraction of the exact k nearest neighbours that the index found.
+	auto recall(comp6771::hnsw_index const& index,
+	            comp6771::knn_index const& exact,
+	            comp6771::euclidean_vector_batch const& queries,
+	            int k,
+	            int ef) -> double {
+		auto found = 0;
+		for (auto q = 0; q < queries.size(); ++q) {
+			auto const query = queries.copy_row(q);
+			auto const approximate = index.search(query, k, ef);
+			for (auto const& n : exact.search(query, k)) {
+				found += std::any_of(approximate.begin(), approximate.end(), [&](auto const& a) {
+					return a.index == n.index;
+				});
+			}
+		}
+		return static_cast<double>(found) / (queries.size() * k);
+	}
+} // namespace
+
+SCENARIO("HNSW Recall Test") {
+	GIVEN("Clustered vectors and queries") {
+		auto const data = clustered_batch(2000, 16, 1);
+		auto const queries = clustered_batch(50, 16, 2);
+		for (auto metric : {comp6771::knn_metric::l2, comp6771::knn_metric::cosine}) {
+			auto const exact = comp6771::knn_index(data, metric);
+			auto index = comp6771::hnsw_index(16, metric, {.m = 8, .ef_construction = 100});
+			index.insert(data);
+			CHECK(index.size() == 2000);
+			CHECK(index.metric() == metric);
+
+			CHECK(recall(index, exact, queries, 10, 100) >= 0.9);
+			// Wider searches never do worse in aggregate.
+			CHECK(recall(index, exact, queries, 10, 200) >= recall(index, exact, queries, 10, 10));
+
+			auto const query = queries.copy_row(0);
+			auto const result = index.search(query, 10, 100);
+			REQUIRE(result.size() == 10);
+			CHECK(std::is_sorted(result.begin(), result.end(), [](auto const& a, auto const& b) {
+				return a.distance < b.distance;
+			}));
+			// Distances are the same ones knn_index reports.
+			auto const nearest = exact.search(query, 1).front();
+			CHECK(result.front().index == nearest.index);
+			CHECK(result.front().distance == Approx(nearest.distance).margin(1e-9));
+		}
+	}
+
+	GIVEN("An index built on several threads") {
+		auto const data = clustered_batch(2000, 16, 3);
+		auto const queries = clustered_batch(50, 16, 4);
+		auto const exact = comp6771::knn_index(data);
+		auto pool = comp6771::thread_pool(4);
+		auto index =
+		   comp6771::hnsw_index(16, comp6771::knn_metric::l2, {.m = 8, .ef_construction = 100});
+		index.insert(comp6771::parallel_policy{&pool}, data);
+		CHECK(index.size() == 2000);
+		CHECK(recall(index, exact, queries, 10, 100) >= 0.9);
+
+		auto const batched = index.search(comp6771::parallel_policy{&pool}, queries, 10, 100);
+		REQUIRE(batched.size() == 50);
+		for (auto q = 0; q < queries.size(); ++q) {
+			CHECK(batched[static_cast<std::size_t>(q)] == index.search(queries.copy_row(q), 10, 100));
+		}
+	}
+}
+
+SCENARIO("HNSW Concurrent Link Test") {
+	GIVEN("Small indices built on several threads, too small for any link list to fill up") {
+		auto pool = comp6771::thread_pool(4);
+		auto one_way = 0;
+		for (auto round = 0U; round < 50; ++round) {
+			auto index =
+			   comp6771::hnsw_index(4, comp6771::knn_metric::l2, {.m = 16, .ef_construction = 40});
+			index.insert(comp6771::parallel_policy{&pool}, clustered_batch(32, 4, round));
+			for (auto id = 0; id < index.size(); ++id) {
+				for (auto layer = 0; not index.links(id, layer).empty(); ++layer) {
+					for (auto const n : index.links(id, layer)) {
+						auto const back = index.links(n, layer);
+						one_way += std::count(back.begin(), back.end(), id) != 1;
+					}
+				}
+			}
+		}
+		THEN("Every link has its reverse") {
+			CHECK(one_way == 0);
+		}
+		CHECK_THROWS_WITH(comp6771::hnsw_index(2).links(0, 0),
+		                  "Vector 0 on layer 0 is not valid for this hnsw_index object");
+	}
+}
+
+SCENARIO("HNSW Incremental Insert Test") {
+	GIVEN("An empty index") {
+		auto index = comp6771::hnsw_index(2);
+		CHECK(index.size() == 0);
+		CHECK(index.search(comp6771::euclidean_vector{0.0, 0.0}, 3, 10).empty());
+
+		WHEN("Vectors are added one at a time") {
+			for (auto i = 0; i < 100; ++i) {
+				CHECK(index.insert(comp6771::euclidean_vector{i * 1.0, 0.0}) == i);
+			}
+			THEN("Each one can be found") {
+				CHECK(index.size() == 100);
+				for (auto i = 0; i < 100; i += 7) {
+					auto const result = index.search(comp6771::euclidean_vector{i * 1.0, 0.5}, 1, 20);
+					REQUIRE(result.size() == 1);
+					CHECK(result.front().index == i);
+					CHECK(result.front().distance == Approx(0.5));
+				}
+			}
+			THEN("A k larger than the index returns everything") {
+				CHECK(index.search(comp6771::euclidean_vector{0.0, 0.0}, 500, 10).size() == 100);
+				CHECK(index.search(comp6771::euclidean_vector{0.0, 0.0}, 0, 10).empty());
+			}
+		}
+	}
+}
+
+SCENARIO("HNSW Save And Load Test") {
+	GIVEN("A built index") {
+		auto const file = scratch_file("hnsw_round_trip", "hnsw");
+		auto const data = clustered_batch(500, 8, 5);
+		auto const queries = clustered_batch(20, 8, 6);
+		auto index = comp6771::hnsw_index(8, comp6771::knn_metric::cosine, {.m = 6, .seed = 7});
+		index.insert(data);
+		index.save(file.path());
+
+		THEN("Loading it gives the same searches") {
+			auto const loaded = comp6771::hnsw_index::load(file.path());
+			CHECK(loaded.size() == index.size());
+			CHECK(loaded.dimensions() == 8);
+			CHECK(loaded.metric() == comp6771::knn_metric::cosine);
+			CHECK(loaded.parameters().m == 6);
+			CHECK(loaded.parameters().seed == 7);
+			for (auto q = 0; q < queries.size(); ++q) {
+				auto const query = queries.copy_row(q);
+				CHECK(loaded.search(query, 5, 30) == index.search(query, 5, 30));
+			}
+		}
+
+		THEN("Size fields beyond what an index can hold are rejected") {
+			auto const bytes = std::filesystem::file_size(file.path());
+			auto const patched = [&](std::streamoff offset, std::uint64_t value, int width) {
+				auto const copy = scratch_file("hnsw_patched", "hnsw");
+				std::filesystem::copy_file(file.path(), copy.path());
+				{
+					auto const mode = std::ios::in | std::ios::out | std::ios::binary;
+					auto out = std::fstream(copy.path(), mode);
+					out.seekp(offset);
+					for (auto i = 0; i < width; ++i) {
+						out.put(static_cast<char>(value >> (8U * static_cast<unsigned>(i))));
+					}
+				}
+				REQUIRE(std::filesystem::file_size(copy.path()) == bytes);
+				try {
+					comp6771::hnsw_index::load(copy.path());
+				} catch (comp6771::euclidean_vector_error const& e) {
+					auto const prefix = copy.path().string() + " is not a valid hnsw_index file: ";
+					return std::string(e.what()).substr(prefix.size());
+				}
+				return std::string();
+			};
+			CHECK(patched(40, std::uint64_t{1} << 32U, 8) == "too many vectors");
+			CHECK(patched(32, std::uint64_t{1} << 31U, 8) == "too many dimensions");
+			CHECK(patched(52, 0x7FFFFFFF, 4) == "too many layers");
+			// The first vector's layer-0 link count follows its level.
+			CHECK(patched(64 + 500 * 8 * 8 + 4, 0xFFFFFFFF, 4) == "too many links");
+		}
+
+		THEN("A truncated copy is rejected") {
+			std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 4);
+			CHECK_THROWS_WITH(comp6771::hnsw_index::load(file.path()),
+			                  file.path().string() + " is not a valid hnsw_index file: truncated");
+		}
+	}
+
+	GIVEN("Files that are not indices") {
+		auto const file = scratch_file("hnsw_bad_magic", "hnsw");
+		std::ofstream(file.path()) << "not an index";
+		CHECK_THROWS_WITH(comp6771::hnsw_index::load(file.path()),
+		                  file.path().string() + " is not a valid hnsw_index file: bad magic");
+		CHECK_THROWS_WITH(comp6771::hnsw_index::load("/nonexistent/index.hnsw"),
+		                  "Cannot open /nonexistent/index.hnsw");
+	}
+}
+
+SCENARIO("HNSW Error Test") {
+	GIVEN("A small index") {
+		auto index = comp6771::hnsw_index(3, comp6771::knn_metric::cosine);
+		index.insert(comp6771::euclidean_vector{1.0, 0.0, 0.0});
+		index.insert(comp6771::euclidean_vector{0.0, 0.0, 0.0});
+
+		CHECK_THROWS_WITH(index.insert(comp6771::euclidean_vector{1.0, 2.0}),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+		CHECK_THROWS_WITH(index.search(comp6771::euclidean_vector{1.0}, 1, 10),
+		                  "Dimensions of LHS(1) and RHS(3) do not match");
+		CHECK_THROWS_WITH(index.search(comp6771::euclidean_vector{1.0, 0.0, 0.0}, -1, 10),
+		                  "Invalid k (-1) for an hnsw_index search");
+		CHECK_THROWS_WITH(index.search(comp6771::euclidean_vector{0.0, 0.0, 0.0}, 1, 10),
+		                  "euclidean_vector with zero euclidean normal does not have a cosine "
+		                  "similarity");
+		CHECK_THROWS_WITH(comp6771::hnsw_index(3, comp6771::knn_metric::l2, {.m = 1}),
+		                  "hnsw_index needs m of at least 2 and a positive ef_construction");
+
+		// The zero vector is at distance 1 from everything.
+		auto const result = index.search(comp6771::euclidean_vector{2.0, 0.0, 0.0}, 2, 10);
+		REQUIRE(result.size() == 2);
+		CHECK(result[0] == comp6771::knn_neighbour{0, 0.0});
+		CHECK(result[1] == comp6771::knn_neighbour{1, 1.0});
+	}
+}
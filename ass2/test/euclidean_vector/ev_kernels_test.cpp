@@ -0,0 +1,151 @@
+#include "comp6771/kernels.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+	auto sample(std::size_t n, double seed) -> std::vector<double> {
+		auto v = std::vector<double>(n);
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			v[i] = seed * static_cast<double>(i % 7) - static_cast<double>(i % 3);
+		}
+		return v;
+	}
+} // namespace
+
+SCENARIO("Kernel Selection Test") {
+	GIVEN("The kernels supported by this CPU") {
+		auto const tables = comp6771::kernels::supported();
+		REQUIRE(!tables.empty());
+		CHECK(std::string(tables.front()->name) == "scalar");
+		CHECK(&comp6771::kernels::active() == tables.back());
+	}
+}
+
+SCENARIO("Kernel Agreement Test") {
+	GIVEN("Every supported kernel table and lengths that exercise the vector tails") {
+		for (auto const* table : comp6771::kernels::supported()) {
+			for (auto n : {0, 1, 2, 3, 4, 5, 7, 8, 15, 16, 17, 31, 32, 33, 67, 1000}) {
+				auto const size = static_cast<std::size_t>(n);
+				auto const x = sample(size, 1.5);
+				auto const y = sample(size, -0.25);
+
+				auto expected_dot = 0.0;
+				auto expected_squares = 0.0;
+				for (auto i = std::size_t{0}; i < size; ++i) {
+					expected_dot += x[i] * y[i];
+					expected_squares += x[i] * x[i];
+				}
+				CHECK(table->dot(x.data(), y.data(), size) == Approx(expected_dot));
+				CHECK(table->sum_squares(x.data(), size) == Approx(expected_squares));
+				auto const fused = table->dot_and_squares(x.data(), y.data(), size);
+				CHECK(fused.dot == Approx(expected_dot));
+				CHECK(fused.x_squares == Approx(expected_squares));
+				CHECK(fused.y_squares == Approx(table->sum_squares(y.data(), size)));
+
+				auto sum = x;
+				table->add(sum.data(), y.data(), size);
+				auto scaled = x;
+				table->scale(scaled.data(), 3.0, size);
+				auto divided = x;
+				table->divide(divided.data(), 3.0, size);
+				auto axpy = y;
+				table->axpy(axpy.data(), 3.0, x.data(), size);
+				auto axpby = y;
+				table->axpby(axpby.data(), 3.0, x.data(), -2.0, size);
+				for (auto i = std::size_t{0}; i < size; ++i) {
+					CHECK(sum[i] == x[i] + y[i]);
+					CHECK(scaled[i] == x[i] * 3.0);
+					CHECK(divided[i] == x[i] / 3.0);
+					CHECK(axpy[i] == Approx(y[i] + 3.0 * x[i]));
+					CHECK(axpby[i] == Approx(3.0 * x[i] - 2.0 * y[i]));
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Matrix Kernel Agreement Test") {
+	GIVEN("Every supported kernel table and lengths that exercise the vector tails") {
+		using comp6771::kernels::gemm_cols;
+		using comp6771::kernels::gemm_rows;
+		for (auto const* table : comp6771::kernels::supported()) {
+			for (auto n : {0, 1, 3, 8, 15, 16, 17, 33, 257}) {
+				auto const size = static_cast<std::size_t>(n);
+				auto const x = sample(size, 1.5);
+				// Four rows of `size` magnitudes, `size + 3` apart.
+				auto const rows = sample(4 * (size + 3), -0.25);
+				auto out = std::vector<double>(4);
+				table->dot4(x.data(), rows.data(), size + 3, size, out.data());
+				for (auto r = std::size_t{0}; r < 4; ++r) {
+					auto const* const row = rows.data() + r * (size + 3);
+					CHECK(out[r] == Approx(table->dot(x.data(), row, size)));
+				}
+
+				auto const a = sample(size * gemm_rows, 0.5);
+				auto const b = sample(size * gemm_cols, 2.0);
+				// A tile inside a wider output, which must be added to and not overwritten.
+				auto const ldc = gemm_cols + 5;
+				auto c = std::vector<double>(gemm_rows * ldc, 1.0);
+				table->gemm_tile(size, a.data(), b.data(), c.data(), ldc);
+				for (auto r = std::size_t{0}; r < gemm_rows; ++r) {
+					for (auto j = std::size_t{0}; j < ldc; ++j) {
+						auto expected = 1.0;
+						for (auto p = std::size_t{0}; p < size and j < gemm_cols; ++p) {
+							expected += a[p * gemm_rows + r] * b[p * gemm_cols + j];
+						}
+						CHECK(c[r * ldc + j] == Approx(expected));
+					}
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Distance Kernel Agreement Test") {
+	GIVEN("Every supported kernel table and lengths that exercise the vector tails") {
+		for (auto const* table : comp6771::kernels::supported()) {
+			for (auto n : {0, 1, 2, 3, 4, 5, 7, 8, 15, 16, 17, 31, 32, 33, 67, 1000}) {
+				auto const size = static_cast<std::size_t>(n);
+				auto const x = sample(size, 1.5);
+				auto const y = sample(size, -0.25);
+
+				auto expected_l1 = 0.0;
+				auto expected_squares = 0.0;
+				auto expected_linf = 0.0;
+				for (auto i = std::size_t{0}; i < size; ++i) {
+					auto const d = x[i] - y[i];
+					expected_l1 += std::abs(d);
+					expected_squares += d * d;
+					expected_linf = std::max(expected_linf, std::abs(d));
+				}
+				CHECK(table->l1_distance(x.data(), y.data(), size) == Approx(expected_l1));
+				CHECK(table->squared_distance(x.data(), y.data(), size) == Approx(expected_squares));
+				CHECK(table->linf_distance(x.data(), y.data(), size) == expected_linf);
+				CHECK(table->linf_distance(y.data(), x.data(), size) == expected_linf);
+			}
+		}
+	}
+	GIVEN("Every supported kernel table and a NaN in a vector lane or in the tail") {
+		auto const nan = std::numeric_limits<double>::quiet_NaN();
+		auto results = std::vector<double>();
+		for (auto const* table : comp6771::kernels::supported()) {
+			// Lane 1 is inside the first vector of every kernel; lane 34 is past the last one.
+			for (auto at : {std::size_t{1}, std::size_t{34}}) {
+				auto x = sample(35, 1.5);
+				auto const y = sample(35, -0.25);
+				x[at] = nan;
+				results.push_back(table->linf_distance(x.data(), y.data(), x.size()));
+				results.push_back(table->linf_distance(y.data(), x.data(), x.size()));
+			}
+		}
+		THEN("linf_distance is NaN in every kernel") {
+			CHECK(std::all_of(results.begin(), results.end(), [](double d) { return std::isnan(d); }));
+		}
+	}
+}
@@ -0,0 +1,164 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/kmeans.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace {
+	// `per_blob` vectors scattered within 1 of each of three centres far apart: (0, 0), (20, 20)
+	// and (-20, 20), padded with zeros to `dim` dimensions. Vector i is in blob i % 3.
+	auto make_blobs(int per_blob, int dim, comp6771::batch_layout layout = {})
+	   -> comp6771::euclidean_vector_batch {
+		auto const centres = std::vector<std::vector<double>>{{0, 0}, {20, 20}, {-20, 20}};
+		auto data = comp6771::euclidean_vector_batch(3 * per_blob, dim, layout);
+		for (auto i = 0; i < data.size(); ++i) {
+			auto const& centre = centres[static_cast<std::size_t>(i % 3)];
+			data.at(i, 0) = centre[0] + static_cast<double>(i % 17) / 17.0 - 0.5;
+			data.at(i, 1) = centre[1] + static_cast<double>(i % 13) / 13.0 - 0.5;
+		}
+		return data;
+	}
+
+	// Every blob is one cluster, and no two blobs share one.
+	auto check_blobs(std::vector<int> const& labels) -> void {
+		auto blob_labels = std::set<int>();
+		for (auto blob = std::size_t{0}; blob < 3; ++blob) {
+			blob_labels.insert(labels[blob]);
+			for (auto i = blob; i < labels.size(); i += 3) {
+				REQUIRE(labels[i] == labels[blob]);
+			}
+		}
+		CHECK(blob_labels.size() == 3);
+	}
+} // namespace
+
+SCENARIO("K-Means Clustering Test") {
+	GIVEN("Three well separated blobs") {
+		auto const data = make_blobs(100, 4);
+		WHEN("They are clustered with k-means++ seeding") {
+			auto const result = comp6771::kmeans(data, 3);
+			THEN("Each blob is a cluster whose centroid is its mean") {
+				check_blobs(result.labels);
+				CHECK(result.converged);
+				CHECK(result.iterations <= 3);
+				REQUIRE(result.centroids.rows() == 3);
+				REQUIRE(result.centroids.cols() == 4);
+				auto inertia = 0.0;
+				for (auto j = 0; j < 3; ++j) {
+					auto mean = std::vector<double>(4);
+					auto count = 0;
+					for (auto i = 0; i < data.size(); ++i) {
+						if (result.labels[static_cast<std::size_t>(i)] == j) {
+							for (auto d = 0; d < 4; ++d) {
+								mean[static_cast<std::size_t>(d)] += data.at(i, d);
+							}
+							++count;
+						}
+					}
+					for (auto d = 0; d < 4; ++d) {
+						auto const expected = mean[static_cast<std::size_t>(d)] / count;
+						CHECK(result.centroids.at(j, d) == Approx(expected));
+					}
+				}
+				for (auto i = 0; i < data.size(); ++i) {
+					auto const j = result.labels[static_cast<std::size_t>(i)];
+					for (auto d = 0; d < 4; ++d) {
+						auto const diff = data.at(i, d) - result.centroids.at(j, d);
+						inertia += diff * diff;
+					}
+				}
+				CHECK(result.inertia == Approx(inertia));
+			}
+			THEN("New vectors are labelled by their nearest centroid") {
+				CHECK(comp6771::nearest_centroids(result.centroids, data) == result.labels);
+				auto const far = comp6771::euclidean_vector_batch(1, 4);
+				CHECK(comp6771::nearest_centroids(result.centroids, far).front()
+				      == result.labels.front());
+			}
+		}
+		WHEN("They are seeded at random or clustered a mini-batch at a time") {
+			auto options = comp6771::kmeans_options();
+			options.init = comp6771::kmeans_init::random;
+			options.seed = 7;
+			auto const random = comp6771::kmeans(data, 3, options);
+			options.mini_batch = 64;
+			options.max_iterations = 50;
+			auto const mini_batch = comp6771::kmeans(data, 3, options);
+			THEN("The blobs are still found") {
+				check_blobs(mini_batch.labels);
+				CHECK(mini_batch.iterations <= 50);
+				CHECK(mini_batch.labels.size() == 300);
+				CHECK(random.labels.size() == 300);
+			}
+		}
+		WHEN("The same vectors are laid out column-major") {
+			auto const columns = make_blobs(100, 4, comp6771::batch_layout::column_major);
+			THEN("The clustering is the same") {
+				auto const rows = comp6771::kmeans(data, 3);
+				auto const cols = comp6771::kmeans(columns, 3);
+				CHECK(cols.labels == rows.labels);
+				CHECK(cols.centroids == rows.centroids);
+			}
+		}
+	}
+	GIVEN("Fewer distinct vectors than clusters") {
+		auto data = comp6771::euclidean_vector_batch(6, 2);
+		data.at(5, 0) = 5.0;
+		auto const result = comp6771::kmeans(data, 3);
+		THEN("Empty clusters are refilled and every label is valid") {
+			CHECK(std::all_of(result.labels.begin(), result.labels.end(), [](int label) {
+				return label >= 0 and label < 3;
+			}));
+			CHECK(result.inertia == Approx(0.0));
+		}
+	}
+	GIVEN("Invalid arguments") {
+		auto const data = make_blobs(2, 2);
+		CHECK_THROWS_WITH(comp6771::kmeans(data, 0), "Invalid k (0) for kmeans over 6 vectors");
+		CHECK_THROWS_WITH(comp6771::kmeans(data, 7), "Invalid k (7) for kmeans over 6 vectors");
+		auto options = comp6771::kmeans_options();
+		options.max_iterations = -1;
+		CHECK_THROWS_WITH(comp6771::kmeans(data, 2, options),
+		                  "Invalid max_iterations (-1) for kmeans");
+		options = comp6771::kmeans_options();
+		options.mini_batch = -1;
+		CHECK_THROWS_WITH(comp6771::kmeans(data, 2, options), "Invalid mini_batch (-1) for kmeans");
+		CHECK_THROWS_WITH(comp6771::nearest_centroids(comp6771::euclidean_matrix(2, 3), data),
+		                  "Dimensions of LHS(3) and RHS(2) do not match");
+		CHECK_THROWS_WITH(comp6771::nearest_centroids(comp6771::euclidean_matrix(0, 2), data),
+		                  "Invalid centroids: there must be at least one");
+	}
+}
+
+SCENARIO("Parallel K-Means Determinism Test") {
+	GIVEN("More vectors than one block of partial sums") {
+		auto const data = make_blobs(12000, 3);
+		for (auto mini_batch : {0, 1000}) {
+			auto options = comp6771::kmeans_options();
+			options.seed = 42;
+			options.max_iterations = 5;
+			options.mini_batch = mini_batch;
+			auto const serial = comp6771::kmeans(data, 5, options);
+			THEN("Every pool size gives the serial clustering exactly") {
+				for (auto threads : {2, 3, 8}) {
+					auto pool = comp6771::thread_pool(threads);
+					auto const policy = comp6771::parallel_policy{&pool};
+					auto const result = comp6771::kmeans(policy, data, 5, options);
+					CHECK(result.centroids == serial.centroids);
+					CHECK(result.labels == serial.labels);
+					CHECK(result.inertia == serial.inertia);
+					CHECK(result.iterations == serial.iterations);
+				}
+			}
+			THEN("Running again with the same seed gives the same clustering") {
+				CHECK(comp6771::kmeans(data, 5, options).centroids == serial.centroids);
+			}
+		}
+	}
+}
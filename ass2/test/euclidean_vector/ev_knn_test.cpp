@@ -0,0 +1,122 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/knn_index.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+	auto random_batch(int size, int dim, unsigned seed) -> comp6771::euclidean_vector_batch {
+		auto engine = std::mt19937(seed);
+		auto dist = std::uniform_real_distribution<double>(-1.0, 1.0);
+		auto batch = comp6771::euclidean_vector_batch(size, dim);
+		for (auto& d : batch.data()) {
+			d = dist(engine);
+		}
+		return batch;
+	}
+
+	// The obvious quadratic search the index has to agree with.
+	auto brute_force(comp6771::euclidean_vector_batch const& data,
+	                 comp6771::euclidean_vector const& query,
+	                 comp6771::knn_metric metric,
+	                 int k) -> std::vector<comp6771::knn_neighbour> {
+		auto all = std::vector<comp6771::knn_neighbour>();
+		for (auto i = 0; i < data.size(); ++i) {
+			auto const row = data.copy_row(i);
+			auto const difference = comp6771::euclidean_vector(row - query);
+			auto const distance = metric == comp6771::knn_metric::l2
+			                         ? comp6771::euclidean_norm(difference)
+			                         : 1.0 - comp6771::cosine_similarity(row, query);
+			all.push_back({i, distance});
+		}
+		std::sort(all.begin(), all.end(), [](auto const& a, auto const& b) {
+			return a.distance < b.distance or (a.distance == b.distance and a.index < b.index);
+		});
+		all.resize(static_cast<std::size_t>(std::min(k, data.size())));
+		return all;
+	}
+
+	auto check_matches(std::vector<comp6771::knn_neighbour> const& actual,
+	                   std::vector<comp6771::knn_neighbour> const& expected) -> void {
+		REQUIRE(actual.size() == expected.size());
+		for (auto i = std::size_t{0}; i < actual.size(); ++i) {
+			CHECK(actual[i].index == expected[i].index);
+			CHECK(actual[i].distance == Approx(expected[i].distance).margin(1e-9));
+		}
+	}
+} // namespace
+
+SCENARIO("Exact KNN Test") {
+	GIVEN("Random vectors and queries") {
+		// Enough rows to need several data blocks at this dimension.
+		auto const data = random_batch(3000, 24, 1);
+		auto const queries = random_batch(19, 24, 2);
+		for (auto metric : {comp6771::knn_metric::l2, comp6771::knn_metric::cosine}) {
+			auto const index = comp6771::knn_index(data, metric);
+			CHECK(index.size() == 3000);
+			CHECK(index.metric() == metric);
+
+			auto const batched = index.search(queries, 10);
+			REQUIRE(batched.size() == 19);
+			for (auto q = 0; q < queries.size(); ++q) {
+				auto const query = queries.copy_row(q);
+				auto const expected = brute_force(data, query, metric, 10);
+				check_matches(index.search(query, 10), expected);
+				check_matches(batched[static_cast<std::size_t>(q)], expected);
+			}
+
+			auto pool = comp6771::thread_pool(4);
+			CHECK(index.search(comp6771::parallel_policy{&pool}, queries, 10) == batched);
+		}
+	}
+}
+
+SCENARIO("KNN Edge Case Test") {
+	GIVEN("A small column-major index") {
+		auto data = comp6771::euclidean_vector_batch(3, 2, comp6771::batch_layout::column_major);
+		data.set_row(0, {0.0, 0.0});
+		data.set_row(1, {3.0, 4.0});
+		data.set_row(2, {1.0, 0.0});
+		auto const index = comp6771::knn_index(data);
+		auto const query = comp6771::euclidean_vector{0.0, 0.0};
+
+		auto const all = index.search(query, 5);
+		REQUIRE(all.size() == 3);
+		CHECK(all[0] == comp6771::knn_neighbour{0, 0.0});
+		CHECK(all[1] == comp6771::knn_neighbour{2, 1.0});
+		CHECK(all[2] == comp6771::knn_neighbour{1, 5.0});
+		CHECK(index.search(query, 0).empty());
+
+		CHECK_THROWS_WITH(index.search(query, -1), "Invalid k (-1) for a knn_index search");
+		CHECK_THROWS_WITH(index.search(comp6771::euclidean_vector(3), 1),
+		                  "Dimensions of LHS(3) and RHS(2) do not match");
+	}
+	GIVEN("Near-duplicate vectors far from the origin") {
+		auto data = comp6771::euclidean_vector_batch(3, 2);
+		data.set_row(0, {1e8, 1e8 + 1.0});
+		data.set_row(1, {1e8, 1e8 + 0.25});
+		data.set_row(2, {1e8 + 0.5, 1e8});
+		auto const index = comp6771::knn_index(data);
+		auto const nearest = index.search(comp6771::euclidean_vector{1e8, 1e8}, 3);
+		REQUIRE(nearest.size() == 3);
+		CHECK(nearest[0] == comp6771::knn_neighbour{1, 0.25});
+		CHECK(nearest[1] == comp6771::knn_neighbour{2, 0.5});
+		CHECK(nearest[2] == comp6771::knn_neighbour{0, 1.0});
+	}
+	GIVEN("A cosine index with a zero vector") {
+		auto data = comp6771::euclidean_vector_batch(2, 2);
+		data.set_row(1, {0.0, 2.0});
+		auto const index = comp6771::knn_index(data, comp6771::knn_metric::cosine);
+		auto const nearest = index.search(comp6771::euclidean_vector{0.0, 1.0}, 2);
+		CHECK(nearest[0] == comp6771::knn_neighbour{1, 0.0});
+		CHECK(nearest[1] == comp6771::knn_neighbour{0, 1.0});
+		CHECK_THROWS_WITH(index.search(comp6771::euclidean_vector(2), 1),
+		                  "euclidean_vector with zero euclidean normal does not have a cosine "
+		                  "similarity");
+	}
+}
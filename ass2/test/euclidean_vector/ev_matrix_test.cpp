@@ -0,0 +1,185 @@
+#include "comp6771/euclidean_matrix.hpp"
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto make_matrix(int rows, int cols, double seed) -> comp6771::euclidean_matrix {
+		auto m = comp6771::euclidean_matrix(rows, cols);
+		for (auto i = 0; i < rows; ++i) {
+			for (auto j = 0; j < cols; ++j) {
+				auto const k = static_cast<double>((i * 7 + j * 3) % 11);
+				m.at(i, j) = seed * k - static_cast<double>(j % 5);
+			}
+		}
+		return m;
+	}
+
+	// The textbook triple loop, to check the tiled products against.
+	auto naive_product(comp6771::euclidean_matrix const& a, comp6771::euclidean_matrix const& b)
+	   -> std::vector<double> {
+		auto c = std::vector<double>();
+		for (auto i = 0; i < a.rows(); ++i) {
+			for (auto j = 0; j < b.cols(); ++j) {
+				auto sum = 0.0;
+				for (auto p = 0; p < a.cols(); ++p) {
+					sum += a.at(i, p) * b.at(p, j);
+				}
+				c.push_back(sum);
+			}
+		}
+		return c;
+	}
+
+	auto check_close(std::span<double const> actual, std::vector<double> const& expected) -> void {
+		REQUIRE(actual.size() == expected.size());
+		for (auto i = std::size_t{0}; i < actual.size(); ++i) {
+			CHECK(actual[i] == Approx(expected[i]));
+		}
+	}
+} // namespace
+
+SCENARIO("Matrix Construction Test") {
+	GIVEN("A new matrix") {
+		auto const m = comp6771::euclidean_matrix(3, 4);
+		CHECK(m.rows() == 3);
+		CHECK(m.cols() == 4);
+		CHECK(m.at(2, 3) == 0.0);
+		CHECK(reinterpret_cast<std::uintptr_t>(m.data().data())
+		         % comp6771::euclidean_vector_batch::alignment
+		      == 0);
+	}
+	GIVEN("A matrix written out row by row") {
+		auto m = comp6771::euclidean_matrix{{1, 2, 3}, {4, 5, 6}};
+		CHECK(m.rows() == 2);
+		CHECK(m.cols() == 3);
+		CHECK(m.at(1, 0) == 4.0);
+		CHECK(m.copy_row(0) == comp6771::euclidean_vector{1, 2, 3});
+		m.set_row(1, comp6771::euclidean_vector{7, 8, 9});
+		CHECK(m == comp6771::euclidean_matrix{{1, 2, 3}, {7, 8, 9}});
+		CHECK(m != comp6771::euclidean_matrix{{1, 2, 3}});
+		CHECK_THROWS_WITH((comp6771::euclidean_matrix{{1, 2}, {3}}),
+		                  "euclidean_matrix rows of 1 and 2 columns do not match");
+	}
+	GIVEN("Batches in either layout") {
+		using comp6771::batch_layout;
+		for (auto layout : {batch_layout::row_major, batch_layout::column_major}) {
+			auto batch = comp6771::euclidean_vector_batch(2, 3, layout);
+			batch.set_row(1, comp6771::euclidean_vector{4, 5, 6});
+			auto const m = comp6771::euclidean_matrix(std::move(batch));
+			CHECK(m == comp6771::euclidean_matrix{{0, 0, 0}, {4, 5, 6}});
+			CHECK(m.batch().layout() == batch_layout::row_major);
+		}
+	}
+	GIVEN("A transpose") {
+		auto const m = make_matrix(37, 70, 0.5);
+		auto const t = comp6771::transpose(m);
+		REQUIRE(t.rows() == 70);
+		REQUIRE(t.cols() == 37);
+		for (auto i = 0; i < m.rows(); ++i) {
+			for (auto j = 0; j < m.cols(); ++j) {
+				CHECK(t.at(j, i) == m.at(i, j));
+			}
+		}
+		CHECK(comp6771::transpose(t) == m);
+	}
+}
+
+SCENARIO("Matrix-Vector Product Test") {
+	GIVEN("Shapes with and without whole groups of rows, and rows longer than a block") {
+		for (auto [rows, cols] : {std::pair{1, 1}, {3, 5}, {4, 8}, {9, 33}, {13, 10000}, {0, 4}}) {
+			auto const a = make_matrix(rows, cols, 1.5);
+			auto magnitudes = std::vector<double>();
+			for (auto j = 0; j < cols; ++j) {
+				magnitudes.push_back(static_cast<double>(j % 13) - 6.0);
+			}
+			auto const x = comp6771::euclidean_vector(magnitudes.begin(), magnitudes.end());
+			auto expected = std::vector<double>();
+			for (auto i = 0; i < rows; ++i) {
+				expected.push_back(comp6771::dot(comp6771::const_euclidean_vector_view(a.row(i)), x));
+			}
+			auto const y = a * x;
+			REQUIRE(y.dimensions() == rows);
+			check_close(std::span<double const>(y.data(), expected.size()), expected);
+
+			auto out = std::vector<double>(static_cast<std::size_t>(rows), -1.0);
+			comp6771::multiply(comp6771::par, a, magnitudes, out);
+			check_close(out, expected);
+		}
+	}
+	GIVEN("Operands that do not fit") {
+		auto const a = comp6771::euclidean_matrix(2, 3);
+		CHECK_THROWS_WITH(a * comp6771::euclidean_vector(2),
+		                  "Dimensions of LHS(3) and RHS(2) do not match");
+		auto out = std::vector<double>(3);
+		CHECK_THROWS_WITH(comp6771::multiply(a, std::vector<double>(3), out),
+		                  "Output of size 3 does not match euclidean_matrix of 2 rows");
+	}
+}
+
+SCENARIO("Matrix Product Test") {
+	GIVEN("Shapes that cross every tile and block boundary") {
+		for (auto [m, k, n] : {std::tuple{1, 1, 1}, {4, 3, 8}, {5, 7, 9}, {67, 300, 21}, {3, 0, 2}}) {
+			auto const a = make_matrix(m, k, 1.5);
+			auto const b = make_matrix(k, n, -0.25);
+			auto const expected = naive_product(a, b);
+			check_close((a * b).data(), expected);
+
+			auto c = comp6771::euclidean_matrix(m, n);
+			c.at(0, 0) = 42.0;
+			comp6771::multiply(a, b, c);
+			check_close(c.data(), expected);
+
+			auto const bt = comp6771::transpose(b);
+			check_close(comp6771::multiply_transposed(a, bt).data(), expected);
+		}
+	}
+	GIVEN("A product that overwrites one of its operands") {
+		auto a = make_matrix(6, 6, 1.5);
+		auto const b = make_matrix(6, 6, -0.25);
+		auto const expected = naive_product(a, b);
+		comp6771::multiply(a, b, a);
+		check_close(a.data(), expected);
+	}
+	GIVEN("Operands that do not fit") {
+		auto const a = comp6771::euclidean_matrix(2, 3);
+		auto const b = comp6771::euclidean_matrix(4, 5);
+		CHECK_THROWS_WITH(a * b, "Dimensions of LHS(3) and RHS(4) do not match");
+		CHECK_THROWS_WITH(comp6771::multiply_transposed(a, b),
+		                  "Dimensions of LHS(3) and RHS(5) do not match");
+		auto c = comp6771::euclidean_matrix(2, 4);
+		CHECK_THROWS_WITH(comp6771::multiply(a, comp6771::euclidean_matrix(3, 5), c),
+		                  "euclidean_matrix of shape 2x4 cannot hold a product of shape 2x5");
+	}
+}
+
+SCENARIO("Parallel Matrix Product Test") {
+	GIVEN("Products big enough to split across threads") {
+		auto const a = make_matrix(300, 520, 1.5);
+		auto const b = make_matrix(520, 40, -0.25);
+		auto const tall = comp6771::transpose(a);
+		auto const x = tall.copy_row(7);
+		auto const serial = a * b;
+		auto const serial_scores = comp6771::multiply_transposed(a, a);
+		auto const serial_y = tall * x;
+		for (auto threads : {1, 2, 3, 8}) {
+			auto pool = comp6771::thread_pool(threads);
+			auto const policy = comp6771::parallel_policy{&pool};
+			THEN("Every pool size gives the serial result exactly") {
+				CHECK(comp6771::multiply(policy, a, b) == serial);
+				CHECK(comp6771::multiply_transposed(policy, a, a) == serial_scores);
+				CHECK(comp6771::multiply(policy, tall, x) == serial_y);
+			}
+		}
+		check_close(serial.data(), naive_product(a, b));
+	}
+}
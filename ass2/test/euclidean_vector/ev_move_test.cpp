@@ -0,0 +1,139 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+
+namespace {
+	// Dimensions large enough that the magnitudes can't be kept inline.
+	auto constexpr dim = 64;
+
+	// Counts the allocations made through the default resource while it is installed.
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		counting_resource()
+		: upstream_{std::pmr::set_default_resource(this)} {}
+
+		counting_resource(counting_resource const&) = delete;
+		auto operator=(counting_resource const&) -> counting_resource& = delete;
+
+		~counting_resource() override {
+			std::pmr::set_default_resource(upstream_);
+		}
+
+		[[nodiscard]] auto allocations() const -> int {
+			return allocations_;
+		}
+
+		auto reset() -> void {
+			allocations_ = 0;
+		}
+
+	private:
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			++allocations_;
+			return upstream_->allocate(bytes, alignment);
+		}
+
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			upstream_->deallocate(p, bytes, alignment);
+		}
+
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+
+		std::pmr::memory_resource* upstream_;
+		int allocations_ = 0;
+	};
+} // namespace
+
+SCENARIO("Expression Allocation Test") {
+	auto resource = counting_resource();
+	auto const a = comp6771::euclidean_vector(dim, 1.0);
+	auto const b = comp6771::euclidean_vector(dim, 2.0);
+	auto const c = comp6771::euclidean_vector(dim, 4.0);
+	resource.reset();
+
+	GIVEN("A chain of lvalue operands") {
+		auto const sum = comp6771::euclidean_vector(a + b + c);
+		CHECK(resource.allocations() == 1);
+		auto const mixed = comp6771::euclidean_vector(a * 2.0 + b / 4.0 - c);
+		CHECK(resource.allocations() == 2);
+
+		CHECK(sum == comp6771::euclidean_vector(dim, 7.0));
+		CHECK(mixed == comp6771::euclidean_vector(dim, -1.5));
+	}
+	GIVEN("A target that already has room") {
+		auto target = comp6771::euclidean_vector(dim);
+		resource.reset();
+		target = a + b - c;
+		CHECK(resource.allocations() == 0);
+		CHECK(target == comp6771::euclidean_vector(dim, -1.0));
+	}
+	GIVEN("A moved operand") {
+		auto x = comp6771::euclidean_vector(dim, 8.0);
+		auto y = comp6771::euclidean_vector(dim, 8.0);
+		auto const* const x_buffer = x.data();
+		auto const* const y_buffer = y.data();
+		resource.reset();
+
+		THEN("The result reuses its buffer") {
+			auto const sum = comp6771::euclidean_vector(std::move(x) + b + c);
+			auto const scaled = comp6771::euclidean_vector(a - std::move(y) * 0.5);
+			CHECK(resource.allocations() == 0);
+
+			CHECK(sum.data() == x_buffer);
+			CHECK(sum == comp6771::euclidean_vector(dim, 14.0));
+			CHECK(scaled.data() == y_buffer);
+			CHECK(scaled == comp6771::euclidean_vector(dim, -3.0));
+		}
+		THEN("A named expression is never stolen from") {
+			auto const expr = std::move(x) + a;
+			auto const first = comp6771::euclidean_vector(expr);
+			auto const second = comp6771::euclidean_vector(expr);
+			CHECK(resource.allocations() == 2);
+
+			CHECK(first == comp6771::euclidean_vector(dim, 9.0));
+			CHECK(second == first);
+		}
+		THEN("An operand the rest of the expression also reads is copied instead") {
+			auto const twice = comp6771::euclidean_vector(std::move(x) + x);
+			auto const none = comp6771::euclidean_vector(y - std::move(y));
+			CHECK(resource.allocations() == 2);
+
+			CHECK(twice == comp6771::euclidean_vector(dim, 16.0));
+			CHECK(x == comp6771::euclidean_vector(dim, 8.0));
+			CHECK(none == comp6771::euclidean_vector(dim, 0.0));
+		}
+	}
+}
+
+SCENARIO("Compound Operator Allocation Test") {
+	auto resource = counting_resource();
+	auto x = comp6771::euclidean_vector(dim, 3.0);
+	auto const y = comp6771::euclidean_vector(dim, 1.0);
+	CHECK(comp6771::euclidean_norm(x) == Approx(3.0 * 8.0));
+	resource.reset();
+
+	GIVEN("Subtraction") {
+		x -= y;
+		CHECK(resource.allocations() == 0);
+		CHECK(x == comp6771::euclidean_vector(dim, 2.0));
+		CHECK(comp6771::euclidean_norm(x) == Approx(2.0 * 8.0));
+		x -= x;
+		CHECK(x == comp6771::euclidean_vector(dim, 0.0));
+	}
+	GIVEN("Every compound operator") {
+		x -= y;
+		x += y;
+		x *= 2.0;
+		x /= 3.0;
+		x += y + y;
+		x -= y * 4.0;
+		CHECK(resource.allocations() == 0);
+		CHECK(x == comp6771::euclidean_vector(dim, 0.0));
+	}
+}
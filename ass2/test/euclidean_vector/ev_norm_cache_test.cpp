@@ -0,0 +1,65 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <vector>
+
+SCENARIO("Norm Cache Invalidation Test") {
+	GIVEN("A euclidean vector whose norm has been cached") {
+		auto a = comp6771::euclidean_vector{3.0, 4.0};
+		auto const b = comp6771::euclidean_vector{1.0, 1.0};
+		CHECK(comp6771::euclidean_norm(a) == 5.0);
+
+		a += b;
+		CHECK(comp6771::euclidean_norm(a) == Approx(std::sqrt(16.0 + 25.0)));
+		a -= b;
+		CHECK(comp6771::euclidean_norm(a) == 5.0);
+		a += b * 2.0;
+		CHECK(comp6771::euclidean_norm(a) == Approx(std::sqrt(25.0 + 36.0)));
+		a = b + b;
+		CHECK(comp6771::euclidean_norm(a) == Approx(std::sqrt(8.0)));
+		a = comp6771::euclidean_vector{3.0, 4.0};
+		CHECK(comp6771::euclidean_norm(a) == 5.0);
+		*a.begin() = 0.0;
+		CHECK(comp6771::euclidean_norm(a) == 4.0);
+	}
+}
+
+SCENARIO("Norm Cache Update Test") {
+	GIVEN("A euclidean vector whose norm has been cached") {
+		auto a = comp6771::euclidean_vector{3.0, 4.0};
+		CHECK(comp6771::euclidean_norm(a) == 5.0);
+
+		a *= -2.0;
+		CHECK(comp6771::euclidean_norm(a) == 10.0);
+		a /= -4.0;
+		CHECK(comp6771::euclidean_norm(a) == 2.5);
+		CHECK(comp6771::euclidean_norm(-a) == 2.5);
+		CHECK(comp6771::euclidean_norm(comp6771::unit(a)) == Approx(1.0));
+
+		auto const copy = a;
+		CHECK(comp6771::euclidean_norm(copy) == 2.5);
+		auto const moved = std::move(a);
+		CHECK(comp6771::euclidean_norm(moved) == 2.5);
+		CHECK(comp6771::euclidean_norm(a) == 0.0); // NOLINT(bugprone-use-after-move)
+	}
+}
+
+SCENARIO("Norm Cache Concurrency Test") {
+	GIVEN("A const euclidean vector shared between threads") {
+		auto const a = comp6771::euclidean_vector(1000, 2.0);
+		auto const expected = std::sqrt(1000.0 * 4.0);
+		auto results = std::vector<double>(8);
+		{
+			auto readers = std::vector<std::jthread>();
+			for (auto& result : results) {
+				readers.emplace_back([&a, &result] { result = comp6771::euclidean_norm(a); });
+			}
+		}
+		for (auto const result : results) {
+			CHECK(result == Approx(expected));
+		}
+	}
+}
@@ -0,0 +1,100 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/parallel.hpp"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace {
+	// Large enough to span several chunks, with a ragged last one.
+	auto sample(double seed) -> comp6771::euclidean_vector {
+		auto mags = std::vector<double>(5 * comp6771::parallel_chunk + 123);
+		for (auto i = std::size_t{0}; i < mags.size(); ++i) {
+			mags[i] = seed * static_cast<double>(i % 11) - static_cast<double>(i % 5) / 3.0;
+		}
+		return comp6771::euclidean_vector(mags.begin(), mags.end());
+	}
+} // namespace
+
+SCENARIO("Thread Pool Test") {
+	GIVEN("Pools of different sizes") {
+		for (auto threads : {1, 2, 4}) {
+			auto pool = comp6771::thread_pool(threads);
+			CHECK(pool.size() == threads);
+			auto hits = std::vector<std::atomic<int>>(100);
+			for (auto round = 0; round < 3; ++round) {
+				pool.run(hits.size(), [&](std::size_t i) { ++hits[i]; });
+			}
+			for (auto const& hit : hits) {
+				CHECK(hit == 3);
+			}
+			CHECK_THROWS_AS(pool.run(10,
+			                         [](std::size_t i) {
+				                         if (i == 7) {
+					                         throw std::runtime_error("task failed");
+				                         }
+			                         }),
+			                std::runtime_error);
+		}
+	}
+}
+
+SCENARIO("Parallel Reduction Test") {
+	GIVEN("Vectors spanning several chunks") {
+		auto const x = sample(1.5);
+		auto const y = sample(-0.75);
+		CHECK(comp6771::dot(comp6771::par, x, y) == Approx(comp6771::dot(x, y)));
+		auto const magnitudes = std::span(x.data(), static_cast<std::size_t>(x.dimensions()));
+		auto const serial_norm = comp6771::euclidean_norm(magnitudes);
+		CHECK(comp6771::euclidean_norm(comp6771::par, x) == Approx(serial_norm));
+		CHECK_THROWS_WITH(comp6771::dot(comp6771::par, x, comp6771::euclidean_vector(2)),
+		                  "Dimensions of LHS(163963) and RHS(2) do not match");
+	}
+	GIVEN("Pools of different sizes") {
+		auto const x = sample(1.5);
+		auto const y = sample(-0.75);
+		auto one = comp6771::thread_pool(1);
+		auto const serial = comp6771::parallel_policy{&one};
+		auto const magnitudes = std::span(x.data(), static_cast<std::size_t>(x.dimensions()));
+		auto const expected_dot = comp6771::dot(serial, x, y);
+		auto const expected_norm = comp6771::euclidean_norm(serial, magnitudes);
+		for (auto threads : {2, 3, 8}) {
+			auto pool = comp6771::thread_pool(threads);
+			auto const policy = comp6771::parallel_policy{&pool};
+			CHECK(comp6771::dot(policy, x, y) == expected_dot);
+			CHECK(comp6771::euclidean_norm(policy, magnitudes) == expected_norm);
+		}
+	}
+	GIVEN("A vector whose norm is not cached yet") {
+		auto const x = sample(1.5);
+		auto const expected = comp6771::euclidean_norm(sample(1.5));
+		std::ignore = comp6771::euclidean_norm(comp6771::par, x);
+		THEN("The serial norm is the same as if the parallel one had never been taken") {
+			CHECK(comp6771::euclidean_norm(x) == expected);
+			CHECK(comp6771::euclidean_norm(comp6771::par, x) == expected);
+		}
+	}
+	GIVEN("A vector no bigger than one chunk") {
+		auto const x = comp6771::euclidean_vector{3.0, 4.0};
+		CHECK(comp6771::euclidean_norm(comp6771::par, x) == 5.0);
+		CHECK(comp6771::dot(comp6771::par, x, x) == 25.0);
+	}
+}
+
+SCENARIO("Parallel Addition Test") {
+	GIVEN("Vectors spanning several chunks") {
+		auto y = sample(1.5);
+		auto const x = sample(-0.75);
+		auto expected = y;
+		expected += x;
+		CHECK(comp6771::euclidean_norm(y) > 0.0);
+		comp6771::add_assign(comp6771::par, y, x);
+		CHECK(y == expected);
+		CHECK(comp6771::euclidean_norm(y) == comp6771::euclidean_norm(expected));
+	}
+}
@@ -0,0 +1,126 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <concepts>
+#include <list>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	template<typename L, typename R>
+	concept addable = requires(L const& l, R const& r) { l + r; };
+} // namespace
+
+SCENARIO("Magnitude Type Test") {
+	GIVEN("The double and float vectors") {
+		static_assert(
+		   std::same_as<comp6771::euclidean_vector, comp6771::basic_euclidean_vector<double>>);
+		static_assert(std::same_as<comp6771::float_euclidean_vector::value_type, float>);
+		// Only the inline buffer differs, and it holds as many floats as doubles.
+		static_assert(sizeof(comp6771::float_euclidean_vector) < sizeof(comp6771::euclidean_vector));
+
+		// Precision only changes on request.
+		static_assert(not std::is_convertible_v<comp6771::euclidean_vector,
+		                                        comp6771::float_euclidean_vector>);
+		static_assert(not std::is_convertible_v<comp6771::float_euclidean_vector,
+		                                        comp6771::euclidean_vector>);
+		static_assert(std::is_constructible_v<comp6771::float_euclidean_vector,
+		                                      comp6771::euclidean_vector>);
+		static_assert(not addable<comp6771::float_euclidean_vector, comp6771::euclidean_vector>);
+		static_assert(addable<comp6771::float_euclidean_vector, comp6771::float_euclidean_vector>);
+	}
+}
+
+SCENARIO("Float Euclidean Vector Test") {
+	GIVEN("Two float vectors") {
+		auto a = comp6771::float_euclidean_vector{3.0F, 4.0F};
+		auto const b = comp6771::float_euclidean_vector{1.0F, -2.0F};
+		CHECK(a.dimensions() == 2);
+		CHECK(a[0] == 3.0F);
+		CHECK(a.at(1) == 4.0F);
+
+		CHECK(comp6771::euclidean_norm(a) == 5.0);
+		CHECK(comp6771::dot(a, b) == -5.0);
+		CHECK(comp6771::unit(a) == comp6771::float_euclidean_vector{0.6F, 0.8F});
+		CHECK(comp6771::cosine_similarity(a, a) == Approx(1.0));
+
+		auto const sum = comp6771::float_euclidean_vector(a + b * 2.0);
+		CHECK(sum == comp6771::float_euclidean_vector{5.0F, 0.0F});
+		CHECK(comp6771::euclidean_norm(a - b) == Approx(std::sqrt(40.0)));
+
+		a *= 2.0;
+		CHECK(comp6771::euclidean_norm(a) == 10.0);
+		a /= 4.0;
+		CHECK(a == comp6771::float_euclidean_vector{1.5F, 2.0F});
+		a += b;
+		CHECK(a == comp6771::float_euclidean_vector{2.5F, 0.0F});
+		a -= b;
+		comp6771::axpy(2.0, b, a);
+		CHECK(a == comp6771::float_euclidean_vector{3.5F, -2.0F});
+		comp6771::axpby(1.0, b, 0.0, a);
+		CHECK(a == b);
+
+		CHECK(static_cast<std::vector<float>>(b) == std::vector<float>{1.0F, -2.0F});
+		CHECK(static_cast<std::list<float>>(b) == std::list<float>{1.0F, -2.0F});
+		auto out = std::ostringstream();
+		out << b;
+		CHECK(out.str() == "[1 -2]");
+
+		auto const mags = std::vector<float>{1.0F, 2.0F, 2.0F};
+		CHECK(comp6771::euclidean_norm(comp6771::float_euclidean_vector(mags.begin(), mags.end()))
+		      == 3.0);
+	}
+}
+
+SCENARIO("Precision Conversion Test") {
+	GIVEN("A double vector") {
+		auto const d = comp6771::euclidean_vector{0.1, -2.5, 1e40};
+		WHEN("It is converted to float") {
+			auto const f = comp6771::float_euclidean_vector(d);
+			THEN("Each magnitude is rounded to the nearest float") {
+				CHECK(f[0] == 0.1F);
+				CHECK(f[1] == -2.5F);
+				CHECK(std::isinf(f[2]));
+			}
+			THEN("Converting back widens without further change") {
+				auto const back = comp6771::euclidean_vector(f);
+				CHECK(back[0] == static_cast<double>(0.1F));
+				CHECK(back[1] == -2.5);
+			}
+		}
+	}
+}
+
+SCENARIO("Accumulation Precision Test") {
+	GIVEN("A long float vector") {
+		auto constexpr dim = 1 << 20;
+		auto const v = comp6771::float_euclidean_vector(dim, 0.1F);
+		auto const square = static_cast<double>(0.1F) * static_cast<double>(0.1F);
+		auto const exact = std::sqrt(dim * square);
+
+		THEN("Reductions accumulate in double by default") {
+			CHECK(comp6771::euclidean_norm(v) == Approx(exact).epsilon(1e-9));
+			CHECK(comp6771::dot(v, v) == Approx(dim * square).epsilon(1e-9));
+			CHECK(comp6771::euclidean_norm(v, comp6771::accumulate_in<double>)
+			      == Approx(exact).epsilon(1e-9));
+		}
+		THEN("Accumulating in float drifts") {
+			auto const narrow =
+			   static_cast<double>(comp6771::euclidean_norm(v, comp6771::accumulate_in<float>));
+			CHECK(std::abs(narrow - exact) > 1e-6 * exact);
+			auto const narrow_dot =
+			   static_cast<double>(comp6771::dot(v, v, comp6771::accumulate_in<float>));
+			CHECK(std::abs(narrow_dot - dim * square) > 1e-6 * dim * square);
+		}
+	}
+	GIVEN("A double vector") {
+		auto const v = comp6771::euclidean_vector{3.0, 4.0};
+		CHECK(comp6771::euclidean_norm(v, comp6771::accumulate_in<long double>) == 5.0L);
+		CHECK(comp6771::dot(v, v, comp6771::accumulate_in<long double>) == 25.0L);
+		CHECK_THROWS_WITH(comp6771::dot(v, comp6771::euclidean_vector(3),
+		                                comp6771::accumulate_in<long double>),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+	}
+}
@@ -0,0 +1,139 @@
+#include "comp6771/euclidean_vector.hpp"
+
+#include <array>
+#include <catch2/catch.hpp>
+#include <iterator>
+#include <list>
+#include <span>
+#include <utility>
+#include <vector>
+
+SCENARIO("Adopt And Release Test") {
+	GIVEN("A euclidean_vector adopted from a std::vector") {
+		auto magnitudes = std::vector<double>{1.0, 2.0, 3.0, 4.0};
+		auto const* buffer = magnitudes.data();
+		auto ev = comp6771::euclidean_vector(std::move(magnitudes));
+
+		THEN("It uses the vector's buffer") {
+			CHECK(ev.dimensions() == 4);
+			CHECK(ev.data() == buffer);
+			CHECK(ev == comp6771::euclidean_vector{1.0, 2.0, 3.0, 4.0});
+		}
+
+		WHEN("It is released") {
+			auto const released = std::move(ev).release_to_vector();
+
+			THEN("The same buffer comes back and the vector is left empty") {
+				CHECK(released.data() == buffer);
+				CHECK(released == std::vector<double>{1.0, 2.0, 3.0, 4.0});
+				CHECK(ev.dimensions() == 0); // NOLINT(bugprone-use-after-move)
+			}
+		}
+
+		WHEN("It is moved before being released") {
+			auto moved = std::move(ev);
+			auto assigned = comp6771::euclidean_vector(100);
+			assigned = std::move(moved);
+
+			THEN("The buffer follows it") {
+				CHECK(assigned.data() == buffer);
+				CHECK(std::move(assigned).release_to_vector().data() == buffer);
+			}
+		}
+
+		WHEN("It is copied") {
+			auto const copy = ev;
+
+			THEN("The copy has its own buffer") {
+				CHECK(copy.data() != buffer);
+				CHECK(copy == ev);
+			}
+		}
+
+		WHEN("It is copy assigned a vector of the same dimensions") {
+			auto const fives = comp6771::euclidean_vector(4, 5.0);
+			ev = fives;
+
+			THEN("The magnitudes are overwritten in place") {
+				CHECK(ev.data() == buffer);
+				CHECK(std::move(ev).release_to_vector() == std::vector<double>(4, 5.0));
+			}
+		}
+	}
+
+	GIVEN("A euclidean_vector that owns its buffer") {
+		auto ev = comp6771::euclidean_vector(100, 2.5);
+
+		WHEN("It is released") {
+			auto const released = std::move(ev).release_to_vector();
+
+			THEN("The magnitudes are copied out") {
+				CHECK(released == std::vector<double>(100, 2.5));
+				CHECK(ev.dimensions() == 0); // NOLINT(bugprone-use-after-move)
+				CHECK(comp6771::euclidean_norm(ev) == 0.0);
+			}
+		}
+	}
+
+	GIVEN("An empty std::vector") {
+		auto const ev = comp6771::euclidean_vector(std::vector<double>());
+
+		THEN("The euclidean_vector has no dimensions") {
+			CHECK(ev.dimensions() == 0);
+		}
+	}
+
+	GIVEN("A float_euclidean_vector adopted from a std::vector") {
+		auto magnitudes = std::vector<float>{1.5F, -2.0F};
+		auto const* buffer = magnitudes.data();
+		auto ev = comp6771::float_euclidean_vector(std::move(magnitudes));
+
+		THEN("It round trips without a copy") {
+			CHECK(ev.data() == buffer);
+			CHECK(std::move(ev).release_to_vector().data() == buffer);
+		}
+	}
+}
+
+SCENARIO("Bulk Export Test") {
+	GIVEN("A euclidean_vector") {
+		auto const ev = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+
+		THEN("The conversions copy every magnitude") {
+			CHECK(static_cast<std::vector<double>>(ev) == std::vector<double>{1.0, 2.0, 3.0});
+			CHECK(static_cast<std::list<double>>(ev) == std::list<double>{1.0, 2.0, 3.0});
+		}
+
+		WHEN("It is copied to an output iterator") {
+			auto out = std::vector<double>{0.0};
+			auto it = ev.copy_to(std::back_inserter(out));
+			*it = 4.0;
+
+			THEN("The magnitudes are appended") {
+				CHECK(out == std::vector<double>{0.0, 1.0, 2.0, 3.0, 4.0});
+			}
+		}
+
+		WHEN("It is copied to a larger span") {
+			auto out = std::array<double, 5>{};
+			auto const written = ev.copy_to(std::span(out));
+
+			THEN("The written prefix is returned") {
+				CHECK(written.data() == out.data());
+				CHECK(written.size() == 3);
+				CHECK(out == std::array<double, 5>{1.0, 2.0, 3.0, 0.0, 0.0});
+			}
+		}
+
+		WHEN("It is copied to a span that is too small") {
+			auto out = std::array<double, 2>{};
+
+			THEN("An exception is thrown") {
+				CHECK_THROWS_MATCHES(ev.copy_to(std::span(out)),
+				                     comp6771::euclidean_vector_error,
+				                     Catch::Matchers::Message("Cannot copy 3 magnitudes into a span of "
+				                                              "2"));
+			}
+		}
+	}
+}
@@ -0,0 +1,177 @@
+#include "comp6771/sparse_euclidean_vector.hpp"
+
+#include "comp6771/euclidean_vector.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <span>
+#include <vector>
+
+namespace {
+	auto sparse(int dim, std::vector<int> const& indices, std::vector<double> const& values)
+	   -> comp6771::sparse_euclidean_vector {
+		return comp6771::sparse_euclidean_vector(dim, indices, values);
+	}
+} // namespace
+
+SCENARIO("Sparse Constructor Test") {
+	GIVEN("Entries out of order, repeated and zero") {
+		auto const sv = sparse(10, {7, 2, 7, 4, 9}, {1.0, 3.0, 2.0, 0.0, -1.0});
+
+		THEN("They are sorted, summed and pruned") {
+			CHECK(sv.dimensions() == 10);
+			CHECK(sv.nonzeros() == 3);
+			CHECK(std::vector<int>(sv.indices().begin(), sv.indices().end())
+			      == std::vector<int>{2, 7, 9});
+			CHECK(std::vector<double>(sv.values().begin(), sv.values().end())
+			      == std::vector<double>{3.0, 3.0, -1.0});
+			CHECK(sv.at(7) == 3.0);
+			CHECK(sv.at(4) == 0.0);
+		}
+	}
+
+	GIVEN("A million dimensions with a handful of nonzeros") {
+		auto const sv = sparse(1'000'000, {999'999, 0}, {2.0, 1.0});
+
+		THEN("Only the nonzeros are stored") {
+			CHECK(sv.nonzeros() == 2);
+			CHECK(sv.at(999'999) == 2.0);
+		}
+	}
+
+	GIVEN("A dense euclidean_vector") {
+		auto const ev = comp6771::euclidean_vector{0.0, 1.5, 0.0, -2.0};
+		auto const sv = comp6771::sparse_euclidean_vector(ev);
+
+		THEN("The round trip restores it") {
+			CHECK(sv.nonzeros() == 2);
+			CHECK(static_cast<comp6771::euclidean_vector>(sv) == ev);
+		}
+	}
+
+	GIVEN("Bad entries") {
+		auto const indices = std::vector<int>{1, 10};
+		auto const values = std::vector<double>{1.0, 2.0};
+
+		THEN("An exception is thrown") {
+			CHECK_THROWS_MATCHES(comp6771::sparse_euclidean_vector(10, indices, values),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Index 10 is not valid for this "
+			                                              "sparse_euclidean_vector object"));
+			auto const one_value = std::span(values).first(1);
+			CHECK_THROWS_MATCHES(comp6771::sparse_euclidean_vector(10, indices, one_value),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Number of indices (2) and values (1) do "
+			                                              "not match"));
+		}
+	}
+}
+
+SCENARIO("Sparse Operator Test") {
+	GIVEN("Two sparse vectors") {
+		auto a = sparse(8, {1, 3, 5}, {1.0, 2.0, 3.0});
+		auto const b = sparse(8, {0, 3, 5}, {4.0, 1.0, -3.0});
+
+		WHEN("They are added") {
+			a += b;
+
+			THEN("Shared indices are summed and cancelled ones dropped") {
+				CHECK(a == sparse(8, {0, 1, 3}, {4.0, 1.0, 3.0}));
+			}
+		}
+
+		WHEN("They are subtracted") {
+			a -= b;
+
+			THEN("Indices only in the right operand are negated") {
+				CHECK(a == sparse(8, {0, 1, 3, 5}, {-4.0, 1.0, 1.0, 6.0}));
+			}
+		}
+
+		WHEN("One is scaled") {
+			a *= 2.0;
+
+			THEN("Every value is scaled") {
+				CHECK(a == sparse(8, {1, 3, 5}, {2.0, 4.0, 6.0}));
+			}
+		}
+
+		WHEN("One is scaled by zero") {
+			a *= 0.0;
+
+			THEN("No entries remain") {
+				CHECK(a.nonzeros() == 0);
+				CHECK(a == comp6771::sparse_euclidean_vector(8));
+			}
+		}
+
+		WHEN("One is divided") {
+			a /= 2.0;
+
+			THEN("Every value is divided") {
+				CHECK(a == sparse(8, {1, 3, 5}, {0.5, 1.0, 1.5}));
+			}
+		}
+
+		THEN("Bad operations throw") {
+			CHECK_THROWS_MATCHES(a /= 0.0,
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Invalid vector division by 0"));
+			CHECK_THROWS_MATCHES(a += comp6771::sparse_euclidean_vector(4),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Dimensions of LHS(8) and RHS(4) do not "
+			                                              "match"));
+			CHECK_THROWS_MATCHES(a.at(8),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Index 8 is not valid for this "
+			                                              "sparse_euclidean_vector object"));
+		}
+	}
+}
+
+SCENARIO("Sparse Utility Test") {
+	GIVEN("Sparse vectors of similar density") {
+		auto const a = sparse(10, {0, 2, 4, 6}, {1.0, 2.0, 3.0, 4.0});
+		auto const b = sparse(10, {1, 2, 6, 9}, {5.0, 6.0, 7.0, 8.0});
+
+		THEN("The norm and merged dot product match the dense ones") {
+			auto const da = static_cast<comp6771::euclidean_vector>(a);
+			auto const db = static_cast<comp6771::euclidean_vector>(b);
+			CHECK(comp6771::euclidean_norm(a) == comp6771::euclidean_norm(da));
+			CHECK(comp6771::dot(a, b) == 40.0);
+			CHECK(comp6771::dot(a, db) == 40.0);
+			CHECK(comp6771::dot(da, b) == 40.0);
+			CHECK(comp6771::dot(a, std::span<double const>(db.data(), 10)) == 40.0);
+		}
+	}
+
+	GIVEN("A short sparse vector and a much longer one") {
+		auto long_indices = std::vector<int>();
+		auto long_values = std::vector<double>();
+		for (auto i = 0; i < 1000; i += 2) {
+			long_indices.push_back(i);
+			long_values.push_back(1.0);
+		}
+		auto const longer = sparse(1000, long_indices, long_values);
+		auto const shorter = sparse(1000, {0, 3, 500, 998, 999}, {1.0, 2.0, 3.0, 4.0, 5.0});
+
+		THEN("The galloping dot product finds every shared index") {
+			CHECK(comp6771::dot(shorter, longer) == 8.0);
+			CHECK(comp6771::dot(longer, shorter) == 8.0);
+			CHECK(comp6771::dot(shorter, static_cast<comp6771::euclidean_vector>(longer)) == 8.0);
+		}
+	}
+
+	GIVEN("A dense vector with a cached norm") {
+		auto y = comp6771::euclidean_vector{3.0, 4.0, 0.0};
+		CHECK(comp6771::euclidean_norm(y) == 5.0);
+
+		WHEN("A sparse vector is added to it") {
+			comp6771::axpy(2.0, sparse(3, {2}, {6.0}), y);
+
+			THEN("Only the stored index changes and the norm is recomputed") {
+				CHECK(y == comp6771::euclidean_vector{3.0, 4.0, 12.0});
+				CHECK(comp6771::euclidean_norm(y) == 13.0);
+			}
+		}
+	}
+}
@@ -0,0 +1,157 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/magnitude_storage.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Counts every allocation made through it so the tests below can prove small vectors never
+	// reach the heap.
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		std::size_t allocations = 0;
+
+	private:
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+	};
+} // namespace
+
+SCENARIO("Storage Move Test") {
+	GIVEN("Euclidean vectors") {
+		CHECK(std::is_nothrow_move_constructible_v<comp6771::euclidean_vector>);
+		CHECK(std::is_nothrow_move_assignable_v<comp6771::euclidean_vector>);
+		CHECK(std::is_nothrow_move_constructible_v<comp6771::magnitude_storage>);
+		CHECK(std::is_nothrow_move_assignable_v<comp6771::magnitude_storage>);
+	}
+}
+
+SCENARIO("Storage Placement Test") {
+	GIVEN("Storage on either side of the inline capacity") {
+		auto constexpr capacity = comp6771::magnitude_storage::inline_capacity;
+		auto const small = comp6771::magnitude_storage(capacity);
+		auto const large = comp6771::magnitude_storage(capacity + 1);
+		CHECK(small.is_inline());
+		CHECK(!large.is_inline());
+		CHECK(small[capacity - 1] == 0.0);
+		CHECK(large[capacity] == 0.0);
+	}
+}
+
+SCENARIO("Storage Alignment Test") {
+	GIVEN("Heap storage of every length across a few cache lines") {
+		auto constexpr capacity = comp6771::magnitude_storage::inline_capacity;
+		for (auto n = capacity + 1; n < capacity + 40; ++n) {
+			auto const doubles = comp6771::magnitude_storage(n);
+			auto const floats = comp6771::basic_magnitude_storage<float>(n);
+			auto const alignment = comp6771::magnitude_storage::alignment;
+			CHECK(reinterpret_cast<std::uintptr_t>(doubles.get()) % alignment == 0);
+			CHECK(reinterpret_cast<std::uintptr_t>(floats.get()) % alignment == 0);
+			CHECK(doubles.size() == n);
+			CHECK(doubles[n - 1] == 0.0);
+		}
+	}
+	GIVEN("Vectors built by every kind of constructor") {
+		auto const values = std::vector<double>(40, 3.0);
+		auto const from_values = comp6771::euclidean_vector(values.begin(), values.end());
+		auto const filled = comp6771::euclidean_vector(40, 3.0);
+		auto const zeroed = comp6771::euclidean_vector(40);
+		auto const sum = comp6771::euclidean_vector(filled + zeroed);
+		THEN("Each is aligned and holds exactly what it was given") {
+			for (auto const* v : {&from_values, &filled, &zeroed, &sum}) {
+				CHECK(reinterpret_cast<std::uintptr_t>(v->data()) % 64 == 0);
+			}
+			CHECK(from_values == filled);
+			CHECK(sum == filled);
+			CHECK(zeroed == comp6771::euclidean_vector(std::vector<double>(40)));
+		}
+	}
+}
+
+SCENARIO("Storage Allocation Test") {
+	auto counter = counting_resource();
+	auto* const previous = std::pmr::set_default_resource(&counter);
+
+	GIVEN("Vectors that fit inline") {
+		auto const before = counter.allocations;
+		auto a = comp6771::euclidean_vector();
+		auto b = comp6771::euclidean_vector(3, 1.5);
+		auto c = comp6771::euclidean_vector{1.0, 2.0, 3.0};
+		auto d = c;
+		auto e = std::move(b);
+		d = e;
+		a = std::move(d);
+		c += e;
+		auto const after = counter.allocations;
+		CHECK(after == before);
+		CHECK(a == comp6771::euclidean_vector(3, 1.5));
+		CHECK(c == comp6771::euclidean_vector{2.5, 3.5, 4.5});
+		CHECK(d.dimensions() == 0);
+	}
+	GIVEN("Vectors above the inline capacity") {
+		auto constexpr dim = static_cast<int>(comp6771::magnitude_storage::inline_capacity) + 1;
+		auto const before = counter.allocations;
+		auto a = comp6771::euclidean_vector(dim, 2.0);
+		auto const constructed = counter.allocations;
+		auto b = std::move(a);
+		auto const moved = counter.allocations;
+		auto c = b;
+		auto const copied = counter.allocations;
+		CHECK(constructed == before + 1);
+		CHECK(moved == before + 1);
+		CHECK(copied == before + 2);
+		CHECK(c == b);
+		CHECK(a.dimensions() == 0);
+	}
+	GIVEN("Storage made for overwriting") {
+		auto constexpr n = comp6771::magnitude_storage::inline_capacity + 1;
+		auto const before = counter.allocations;
+		auto storage = comp6771::magnitude_storage::for_overwrite(n);
+		CHECK(storage.size() == n);
+		CHECK(!storage.is_inline());
+		WHEN("It grows within its padding") {
+			storage.resize_for_overwrite(n + 3);
+			THEN("The buffer is reused") {
+				CHECK(counter.allocations == before + 1);
+				CHECK(storage.size() == n + 3);
+			}
+		}
+	}
+
+	std::pmr::set_default_resource(previous);
+}
+
+SCENARIO("Storage Transition Test") {
+	GIVEN("Assignments between inline and heap vectors") {
+		auto const values = std::vector<double>(40, 3.0);
+		auto large = comp6771::euclidean_vector(values.begin(), values.end());
+		auto small = comp6771::euclidean_vector{1.0, 2.0};
+
+		auto tmp = small;
+		small = large;
+		large = tmp;
+		CHECK(small.dimensions() == 40);
+		CHECK(small.at(39) == 3.0);
+		CHECK(large == comp6771::euclidean_vector{1.0, 2.0});
+
+		large = std::move(small);
+		CHECK(large.dimensions() == 40);
+		CHECK(large.at(0) == 3.0);
+	}
+}
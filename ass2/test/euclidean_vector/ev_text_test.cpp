@@ -0,0 +1,226 @@
+#include "comp6771/euclidean_vector_text.hpp"
+
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_batch.hpp"
+#include "scratch_file.hpp"
+#include <array>
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+using comp6771_test::scratch_file;
+
+SCENARIO("Text Formatting Test") {
+	GIVEN("A vector with awkward magnitudes") {
+		auto const v = comp6771::euclidean_vector{0.1 + 0.2, -1e-300, 3.0, 1.0 / 3.0};
+
+		WHEN("It is formatted") {
+			auto formatter = comp6771::euclidean_vector_formatter();
+			auto const text = std::string(formatter.format(v));
+
+			THEN("The shortest round-trip forms are used") {
+				CHECK(text == "0.30000000000000004,-1e-300,3,0.3333333333333333");
+				CHECK(comp6771::parse_euclidean_vector(text) == v);
+			}
+		}
+
+		WHEN("It is formatted into a buffer that is too small") {
+			auto buffer = std::array<char, 8>{};
+			auto const result = comp6771::to_chars(buffer.data(), buffer.data() + buffer.size(), v);
+
+			THEN("value_too_large is reported") {
+				CHECK(result.ec == std::errc::value_too_large);
+			}
+		}
+	}
+
+	GIVEN("A vector written with operator<<") {
+		auto const v = comp6771::euclidean_vector{7, 11, 360};
+		auto oss = std::ostringstream();
+		oss << v << ' ' << comp6771::euclidean_vector(0);
+
+		THEN("operator>> reads it back, and an empty vector prints as []") {
+			CHECK(oss.str() == "[7 11 360] []");
+			auto iss = std::istringstream(oss.str());
+			auto read = comp6771::euclidean_vector();
+			auto empty = comp6771::euclidean_vector();
+			CHECK(iss >> read >> empty);
+			CHECK(read == v);
+			CHECK(empty.dimensions() == 0);
+		}
+	}
+
+	GIVEN("Text operator>> can't read") {
+		auto iss = std::istringstream("[1 x]");
+		auto v = comp6771::euclidean_vector{1.0};
+
+		THEN("The stream fails") {
+			CHECK_FALSE(iss >> v);
+			CHECK(v == comp6771::euclidean_vector{1.0});
+		}
+	}
+}
+
+SCENARIO("Text Parsing Test") {
+	GIVEN("Comma-separated text with blanks, CRLF line ends and an empty line") {
+		auto const text = std::string_view("1, 2.5 ,-3\r\n\n4e2,5,6\n");
+		auto const batch = comp6771::parse_euclidean_vector_batch(text);
+
+		THEN("Every vector is read") {
+			CHECK(batch.size() == 2);
+			CHECK(batch.dimensions() == 3);
+			CHECK(batch.copy_row(0) == comp6771::euclidean_vector{1.0, 2.5, -3.0});
+			CHECK(batch.copy_row(1) == comp6771::euclidean_vector{400.0, 5.0, 6.0});
+		}
+	}
+
+	GIVEN("Space-aligned columns") {
+		auto const v = comp6771::parse_euclidean_vector("   1    -2\t 3  ", ' ');
+
+		THEN("Any run of blanks separates magnitudes") {
+			CHECK(v == comp6771::euclidean_vector{1.0, -2.0, 3.0});
+		}
+	}
+
+	GIVEN("Malformed text") {
+		THEN("The line and the problem are reported") {
+			CHECK_THROWS_MATCHES(comp6771::parse_euclidean_vector_batch("1,2\n3,x\n"),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Line 2 is not a valid euclidean_vector: "
+			                                              "expected a magnitude"));
+			CHECK_THROWS_MATCHES(comp6771::parse_euclidean_vector_batch("1,2\n3\n"),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Line 2 is not a valid euclidean_vector: 1 "
+			                                              "magnitudes where the first vector had 2"));
+			CHECK_THROWS_MATCHES(comp6771::parse_euclidean_vector("1;2"),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Line 1 is not a valid euclidean_vector: "
+			                                              "unexpected ';'"));
+			CHECK_THROWS_MATCHES(comp6771::parse_euclidean_vector("1,"),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Line 1 is not a valid euclidean_vector: "
+			                                              "expected a magnitude"));
+			CHECK_THROWS_MATCHES(comp6771::parse_euclidean_vector("1e999"),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Line 1 is not a valid euclidean_vector: "
+			                                              "magnitude out of range"));
+			CHECK_THROWS_MATCHES(comp6771::parse_euclidean_vector(" \r\n"),
+			                     comp6771::euclidean_vector_error,
+			                     Catch::Matchers::Message("Line 1 is not a valid euclidean_vector: "
+			                                              "no magnitudes"));
+			CHECK_THROWS_WITH(comp6771::parse_euclidean_vector(""),
+			                  "Line 1 is not a valid euclidean_vector: no magnitudes");
+		}
+	}
+}
+
+SCENARIO("Text Streaming Test") {
+	GIVEN("Vectors with no dimensions") {
+		auto const file = scratch_file("text_no_dimensions", "csv");
+		auto writer = comp6771::euclidean_vector_text_writer(file.path());
+
+		THEN("Writing one throws rather than writing a line that would read back as nothing") {
+			CHECK_THROWS_WITH(writer.write(comp6771::euclidean_vector(0)),
+			                  "euclidean_vector with no dimensions can't be written as text");
+			CHECK_THROWS_WITH(writer.write(comp6771::euclidean_vector_batch(3, 0)),
+			                  "euclidean_vector with no dimensions can't be written as text");
+			writer.write(comp6771::euclidean_vector_batch(0, 0));
+			CHECK(writer.size() == 0);
+			writer.close();
+			CHECK(comp6771::load_euclidean_vector_text(file.path()).size() == 0);
+		}
+	}
+
+	GIVEN("Vectors streamed to a tab-separated file") {
+		auto const file = scratch_file("text_stream", "csv");
+		auto batch = comp6771::euclidean_vector_batch(1000, 3);
+		for (auto i = 0; i < batch.size(); ++i) {
+			for (auto d = 0; d < batch.dimensions(); ++d) {
+				batch.at(i, d) = i / 7.0 - d;
+			}
+		}
+		{
+			auto writer = comp6771::euclidean_vector_text_writer(file.path(), '\t');
+			writer.write(batch);
+			writer.write(comp6771::euclidean_vector{1.0, 2.0, 3.0});
+			CHECK(writer.size() == 1001);
+		}
+
+		WHEN("It is loaded whole") {
+			auto const loaded = comp6771::load_euclidean_vector_text(file.path(), '\t');
+
+			THEN("Every magnitude reads back exactly") {
+				REQUIRE(loaded.size() == 1001);
+				for (auto i = 0; i < batch.size(); ++i) {
+					CHECK(loaded.copy_row(i) == batch.copy_row(i));
+				}
+				CHECK(loaded.copy_row(1000) == comp6771::euclidean_vector{1.0, 2.0, 3.0});
+			}
+		}
+
+		WHEN("It is read through a block smaller than a line") {
+			auto reader = comp6771::euclidean_vector_text_reader(file.path(), '\t', 4);
+			auto v = comp6771::euclidean_vector(3);
+			auto const* const buffer = v.data();
+			auto rows = 0;
+			auto matches = true;
+			while (rows < batch.size() and reader.read(v)) {
+				matches = matches and v == batch.copy_row(rows);
+				++rows;
+			}
+
+			THEN("Every vector is read into the same buffer") {
+				CHECK(rows == batch.size());
+				CHECK(matches);
+				CHECK(v.data() == buffer);
+				CHECK(reader.dimensions() == 3);
+			}
+		}
+
+		WHEN("It is read in batches") {
+			auto reader = comp6771::euclidean_vector_text_reader(file.path(), '\t');
+			auto const first = reader.read(600);
+			auto const second = reader.read(600);
+			auto const third = reader.read(600);
+
+			THEN("The batches split the file") {
+				CHECK(first.size() == 600);
+				CHECK(second.size() == 401);
+				CHECK(third.size() == 0);
+				CHECK(second.copy_row(0) == batch.copy_row(600));
+			}
+		}
+	}
+
+	GIVEN("A writer moved over one with lines still buffered") {
+		auto const first = scratch_file("text_move_assigned_first", "csv");
+		auto const second = scratch_file("text_move_assigned_second", "csv");
+		auto writer = comp6771::euclidean_vector_text_writer(first.path());
+		writer.write(comp6771::euclidean_vector{1.0, 2.0});
+		writer.write(comp6771::euclidean_vector{3.0, 4.0});
+		writer = comp6771::euclidean_vector_text_writer(second.path(), '\t');
+
+		THEN("The buffered lines reach the first file before the writer moves on") {
+			auto const loaded = comp6771::load_euclidean_vector_text(first.path());
+			REQUIRE(loaded.size() == 2);
+			CHECK(loaded.copy_row(1) == comp6771::euclidean_vector{3.0, 4.0});
+			CHECK(writer.size() == 0);
+			writer.write(comp6771::euclidean_vector{5.0});
+			writer.close();
+			CHECK(comp6771::load_euclidean_vector_text(second.path(), '\t').size() == 1);
+		}
+	}
+
+	GIVEN("A file that doesn't exist") {
+		auto const file = scratch_file("text_missing", "csv");
+
+		THEN("Reading it throws") {
+			CHECK_THROWS_AS(comp6771::euclidean_vector_text_reader(file.path()),
+			                comp6771::euclidean_vector_error);
+		}
+	}
+}
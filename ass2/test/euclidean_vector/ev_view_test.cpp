@@ -0,0 +1,117 @@
+#include "comp6771/euclidean_vector.hpp"
+#include "comp6771/euclidean_vector_view.hpp"
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+SCENARIO("View Construction Test") {
+	GIVEN("Magnitudes owned by a std::vector") {
+		auto mags = std::vector<double>{3.0, 4.0, 12.0};
+		auto const view = comp6771::euclidean_vector_view(mags);
+		CHECK(view.dimensions() == 3);
+		CHECK(view.data() == mags.data());
+		CHECK(view.at(2) == 12.0);
+		CHECK_THROWS_WITH(view.at(3), "Index 3 is not valid for this euclidean_vector object");
+
+		mags[0] = 5.0;
+		CHECK(view[0] == 5.0);
+		view.at(1) = 6.0;
+		CHECK(mags[1] == 6.0);
+	}
+	GIVEN("A euclidean vector") {
+		auto const ev = comp6771::euclidean_vector{1.0, 2.0};
+		auto const view = comp6771::const_euclidean_vector_view(ev);
+		CHECK(view.data() == ev.data());
+		CHECK(std::is_constructible_v<comp6771::const_euclidean_vector_view,
+		                              comp6771::euclidean_vector const&>);
+		CHECK(not std::is_constructible_v<comp6771::euclidean_vector_view,
+		                                  comp6771::euclidean_vector&>);
+		CHECK(not std::is_convertible_v<comp6771::const_euclidean_vector_view,
+		                                comp6771::euclidean_vector>);
+		CHECK(not std::is_convertible_v<comp6771::const_euclidean_vector_view,
+		                                comp6771::euclidean_vector_view>);
+	}
+}
+
+SCENARIO("View Arithmetic Test") {
+	GIVEN("Two views over external buffers") {
+		auto x_mags = std::vector<double>{1.0, 2.0, 3.0};
+		auto const y_mags = std::vector<double>{4.0, 5.0, 6.0};
+		auto x = comp6771::euclidean_vector_view(x_mags);
+		auto const y = comp6771::const_euclidean_vector_view(y_mags);
+
+		x += y;
+		CHECK(x_mags == std::vector<double>{5.0, 7.0, 9.0});
+		x -= y;
+		CHECK(x_mags == std::vector<double>{1.0, 2.0, 3.0});
+		x *= 2.0;
+		CHECK(x_mags == std::vector<double>{2.0, 4.0, 6.0});
+		x /= 2.0;
+		CHECK(x_mags == std::vector<double>{1.0, 2.0, 3.0});
+		x += comp6771::euclidean_vector{1.0, 1.0, 1.0};
+		CHECK(x_mags == std::vector<double>{2.0, 3.0, 4.0});
+
+		CHECK_THROWS_WITH(x /= 0, "Invalid vector division by 0");
+		CHECK_THROWS_WITH(x += comp6771::euclidean_vector(2),
+		                  "Dimensions of LHS(3) and RHS(2) do not match");
+	}
+}
+
+SCENARIO("View Utility Test") {
+	GIVEN("Views and euclidean vectors mixed together") {
+		auto mags = std::vector<double>{3.0, 4.0};
+		auto const view = comp6771::euclidean_vector_view(mags);
+		auto const ev = comp6771::euclidean_vector{1.0, 2.0};
+
+		CHECK(comp6771::euclidean_norm(view) == 5.0);
+		CHECK(comp6771::dot(view, ev) == 11.0);
+		CHECK(comp6771::dot(ev, view) == 11.0);
+		CHECK(comp6771::dot(view, view) == 25.0);
+		CHECK(comp6771::unit(view) == comp6771::euclidean_vector{0.6, 0.8});
+		CHECK_THROWS_WITH(comp6771::dot(view, comp6771::euclidean_vector(3)),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+		CHECK(view == comp6771::const_euclidean_vector_view(comp6771::euclidean_vector{3.0, 4.0}));
+
+		auto out = std::ostringstream();
+		out << view;
+		CHECK(out.str() == "[3 4]");
+	}
+	GIVEN("The fused operations over views and euclidean vectors mixed together") {
+		auto mags = std::vector<double>{3.0, 4.0};
+		auto const view = comp6771::euclidean_vector_view(mags);
+		auto ev = comp6771::euclidean_vector{1.0, 2.0};
+		CHECK(comp6771::euclidean_norm(ev) == Approx(std::sqrt(5.0)));
+
+		comp6771::axpy(2.0, view, ev);
+		CHECK(ev == comp6771::euclidean_vector{7.0, 10.0});
+		CHECK(comp6771::euclidean_norm(ev) == Approx(std::sqrt(149.0)));
+		comp6771::axpby(1.0, view, 0.5, ev);
+		CHECK(ev == comp6771::euclidean_vector{6.5, 9.0});
+
+		auto const one = comp6771::euclidean_vector{1.0, 1.0};
+		comp6771::axpy(1.0, one, view);
+		CHECK(mags == std::vector<double>{4.0, 5.0});
+		comp6771::axpby(-1.0, one, 1.0, view);
+		CHECK(mags == std::vector<double>{3.0, 4.0});
+
+		auto const sums = comp6771::dot_and_norms(view, one);
+		CHECK(sums.dot == 7.0);
+		CHECK(sums.x_norm == 5.0);
+		CHECK(comp6771::dot_and_norms(one, view).y_norm == 5.0);
+		CHECK(comp6771::cosine_similarity(view, one) == Approx(7.0 / (5.0 * std::sqrt(2.0))));
+		CHECK(comp6771::cosine_similarity(one, view) == comp6771::cosine_similarity(view, one));
+		auto three = comp6771::euclidean_vector(3);
+		CHECK_THROWS_WITH(comp6771::axpy(1.0, view, three),
+		                  "Dimensions of LHS(2) and RHS(3) do not match");
+	}
+	GIVEN("An explicit conversion to an owning vector") {
+		auto mags = std::vector<double>{3.0, 4.0};
+		auto const view = comp6771::euclidean_vector_view(mags);
+		auto const ev = static_cast<comp6771::euclidean_vector>(view);
+		mags[0] = 0.0;
+		CHECK(ev == comp6771::euclidean_vector{3.0, 4.0});
+	}
+}
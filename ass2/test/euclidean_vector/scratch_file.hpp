@@ -0,0 +1,30 @@
+#ifndef COMP6771_TEST_SCRATCH_FILE_HPP
+#define COMP6771_TEST_SCRATCH_FILE_HPP
+
+#include <filesystem>
+#include <string>
+
+namespace comp6771_test {
+	// A file in the temporary directory that is removed when the test is done with it.
+	class scratch_file {
+	public:
+		scratch_file(std::string const& name, std::string const& extension)
+		: path_{std::filesystem::temp_directory_path() / ("comp6771_" + name + "." + extension)} {}
+
+		scratch_file(scratch_file const&) = delete;
+		auto operator=(scratch_file const&) -> scratch_file& = delete;
+
+		~scratch_file() {
+			std::filesystem::remove(path_);
+		}
+
+		[[nodiscard]] auto path() const -> std::filesystem::path const& {
+			return path_;
+		}
+
+	private:
+		std::filesystem::path path_;
+	};
+} // namespace comp6771_test
+
+#endif // COMP6771_TEST_SCRATCH_FILE_HPP